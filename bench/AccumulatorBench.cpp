@@ -0,0 +1,106 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Accumulator.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 20;
+
+//
+// Fill quantities at 0 to 8 decimal places.
+//
+static const std::vector<Number>& fills ()
+{
+    static std::vector<Number> values;
+
+    if (values.empty ())
+    {
+        std::mt19937_64 generator (23);
+        std::uniform_int_distribution<int64_t> distribution (
+            -10000000000LL, 10000000000LL
+        );
+
+        values.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            values.push_back (
+                Number::fromScaledValue (
+                    distribution (generator), generator () % 9
+                )
+            );
+        }
+    }
+
+    return values;
+}
+
+static const size_t BYTES = COUNT * sizeof (Number);
+
+static void scalarMixedSum ()
+{
+    const double nanos = bestNanos ([] () {
+        Number total (0);
+
+        for (const auto& fill: fills ())
+        {
+            total += fill;
+        }
+
+        sink = sink + total.decimalPlaces ();
+    });
+
+    report ("Number operator+= mixed scales", nanos, COUNT, BYTES);
+}
+
+static void accumulatorMixedSum ()
+{
+    const double nanos = bestNanos ([] () {
+        Accumulator total;
+
+        for (const auto& fill: fills ())
+        {
+            total.add (fill);
+        }
+
+        sink = sink + total.toNumber ().decimalPlaces ();
+    });
+
+    report ("Accumulator::add mixed scales", nanos, COUNT, BYTES);
+}
+
+std::vector<Bench> AccumulatorBenchVec = {
+    {scalarMixedSum, "scalar mixed sum"},
+    {accumulatorMixedSum, "accumulator mixed sum"}
+};
+
+} // namespace bench
+} // namespace fixed
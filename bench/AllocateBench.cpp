@@ -0,0 +1,119 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Allocate.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t LEGS = 100000;
+
+//
+// Account weights up to 100 at 4 decimal places.
+//
+static const std::vector<Number>& weights ()
+{
+    static const std::vector<Number> values = [] () {
+        std::mt19937_64 generator (50);
+        std::vector<Number> result;
+
+        result.reserve (LEGS);
+
+        for (size_t idx = 0; idx < LEGS; ++idx)
+        {
+            result.push_back (
+                Number::fromScaledValue (1 + generator () % 1000000, 4)
+            );
+        }
+
+        return result;
+    } ();
+
+    return values;
+}
+
+//
+// A share per leg with a division each, and whatever rounding leaves over
+// put on the last leg.
+//
+static void perLegDivide ()
+{
+    const std::vector<Number>& inputs = weights ();
+    const Number total ("1234567.89");
+
+    std::vector<Number> out (LEGS);
+
+    const double nanos = bestNanos ([&] () {
+        Number weightSum;
+
+        for (const auto& weight: inputs)
+        {
+            weightSum += weight;
+        }
+
+        Number allocated;
+
+        for (size_t idx = 0; idx < LEGS; ++idx)
+        {
+            out [idx] = total * inputs [idx] / weightSum;
+            out [idx].setDecimalPlaces (total.decimalPlaces ());
+            allocated += out [idx];
+        }
+
+        out [LEGS - 1] += total - allocated;
+
+        sink = sink + out [LEGS / 2].decimalPlaces ();
+    });
+
+    report ("Per leg operator/", nanos, LEGS, LEGS * sizeof (Number));
+}
+
+static void allocateLegs ()
+{
+    const std::vector<Number>& inputs = weights ();
+    const Number total ("1234567.89");
+
+    std::vector<Number> out (LEGS);
+
+    const double nanos = bestNanos ([&] () {
+        allocate (total, inputs.data (), LEGS, out.data ());
+
+        sink = sink + out [LEGS / 2].decimalPlaces ();
+    });
+
+    report ("allocate ()", nanos, LEGS, LEGS * sizeof (Number));
+}
+
+std::vector<Bench> AllocateBenchVec = {
+    {perLegDivide, "Per leg division"},
+    {allocateLegs, "Largest remainder allocation"}
+};
+
+} // namespace bench
+} // namespace fixed
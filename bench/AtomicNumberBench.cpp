@@ -0,0 +1,125 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/AtomicNumber.h"
+#include "BenchCommon.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t ADDS_PER_THREAD = 1 << 16;
+
+static const unsigned int MAX_THREADS = 64;
+
+static const unsigned int DECIMAL_PLACES = 4;
+
+static const std::vector<Number>& deltas ()
+{
+    static std::vector<Number> values;
+
+    if (values.empty ())
+    {
+        for (size_t idx = 0; idx < ADDS_PER_THREAD; ++idx)
+        {
+            values.push_back (
+                Number::fromScaledValue (
+                    static_cast<int64_t> (idx % 977) - 488, DECIMAL_PLACES
+                )
+            );
+        }
+    }
+
+    return values;
+}
+
+template <typename Atomic>
+static double atomicNanos (const unsigned int threadCount)
+{
+    Atomic counter (DECIMAL_PLACES);
+
+    const double nanos = threadedNanos (threadCount, [&] () {
+        for (const auto& delta: deltas ())
+        {
+            counter.fetch_add (delta);
+        }
+    });
+
+    sink = sink + counter.load ().decimalPlaces ();
+
+    return nanos;
+}
+
+static void contention ()
+{
+    deltas ();
+
+    for (unsigned int threadCount = 1;
+         threadCount <= MAX_THREADS;
+         threadCount *= 2)
+    {
+        const size_t items = ADDS_PER_THREAD * threadCount;
+        const size_t bytes = items * sizeof (Number);
+        const std::string suffix = " " + std::to_string (threadCount) + "T";
+
+        std::mutex mutex;
+        Number locked (0);
+
+        const double mutexNanos = threadedNanos (threadCount, [&] () {
+            for (const auto& delta: deltas ())
+            {
+                std::lock_guard<std::mutex> guard (mutex);
+
+                locked += delta;
+            }
+        });
+
+        report ("mutex Number operator+=" + suffix, mutexNanos, items, bytes);
+
+        report (
+            "AtomicNumber::fetch_add" + suffix,
+            atomicNanos<AtomicNumber> (threadCount),
+            items,
+            bytes
+        );
+
+        report (
+            "WideAtomicNumber::fetch_add" + suffix,
+            atomicNanos<WideAtomicNumber> (threadCount),
+            items,
+            bytes
+        );
+    }
+}
+
+std::vector<Bench> AtomicNumberBenchVec = {
+    {contention, "contention"}
+};
+
+} // namespace bench
+} // namespace fixed
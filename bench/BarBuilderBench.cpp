@@ -0,0 +1,160 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/BarBuilder.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 20;
+
+static const uint32_t INSTRUMENTS = 1000;
+
+static const int64_t INTERVAL = 1000;
+
+//
+// Ticks for random instruments, prices at 5 decimal places and sizes at 0,
+// a few hundred per instrument per bar.
+//
+static const std::vector<BarBuilder::Tick>& ticks ()
+{
+    static std::vector<BarBuilder::Tick> values;
+
+    if (values.empty ())
+    {
+        std::mt19937_64 generator (59);
+        std::uniform_int_distribution<int64_t> prices (100000, 200000);
+        std::uniform_int_distribution<int64_t> sizes (1, 1000000);
+
+        values.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            values.push_back ({
+                static_cast<uint32_t> (generator () % INSTRUMENTS),
+                static_cast<int64_t> (idx / 256),
+                Number::fromScaledValue (prices (generator), 5),
+                Number::fromScaledValue (sizes (generator), 0)
+            });
+        }
+    }
+
+    return values;
+}
+
+static const size_t BYTES = COUNT * sizeof (BarBuilder::Tick);
+
+struct NumberBar {
+    int64_t start;
+    uint64_t ticks;
+    Number open;
+    Number high;
+    Number low;
+    Number close;
+    Number volume;
+};
+
+//
+// Bars of Numbers updated through the general purpose operators.
+//
+static void numberBars ()
+{
+    std::vector<NumberBar> bars (INSTRUMENTS);
+    std::vector<NumberBar> completed (COUNT);
+
+    const double nanos = bestNanos ([&bars, &completed] () {
+        size_t count = 0;
+
+        for (auto& bar: bars)
+        {
+            bar.ticks = 0;
+        }
+
+        for (const auto& tick: ticks ())
+        {
+            NumberBar& bar = bars [tick.instrument];
+
+            const int64_t start = tick.timestamp / INTERVAL * INTERVAL;
+
+            if (bar.ticks && bar.start == start)
+            {
+                if (tick.price > bar.high)
+                {
+                    bar.high = tick.price;
+                }
+
+                if (tick.price < bar.low)
+                {
+                    bar.low = tick.price;
+                }
+
+                bar.close = tick.price;
+                bar.volume += tick.size;
+                ++bar.ticks;
+
+                continue;
+            }
+
+            if (bar.ticks)
+            {
+                completed [count++] = bar;
+            }
+
+            bar = {
+                start, 1, tick.price, tick.price, tick.price, tick.price,
+                tick.size
+            };
+        }
+
+        sink = sink + count;
+    });
+
+    report ("Number bars", nanos, COUNT, BYTES);
+}
+
+static void barBuilder ()
+{
+    std::vector<BarBuilder::Bar> completed (COUNT);
+
+    const double nanos = bestNanos ([&completed] () {
+        BarBuilder builder (INSTRUMENTS, INTERVAL, 5, 0);
+
+        sink = sink + builder.add (ticks ().data (), COUNT, completed.data ());
+    });
+
+    report ("BarBuilder::add batch", nanos, COUNT, BYTES);
+}
+
+std::vector<Bench> BarBuilderBenchVec = {
+    {numberBars, "number bars"},
+    {barBuilder, "bar builder"}
+};
+
+} // namespace bench
+} // namespace fixed
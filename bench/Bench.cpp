@@ -0,0 +1,102 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "BenchCommon.h"
+
+#include "fixed/CpuDispatch.h"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+volatile uint64_t sink = 0;
+
+struct BenchVec {
+    std::string name;
+    const std::vector<Bench>& benches;
+};
+
+extern std::vector<Bench> AccumulatorBenchVec;
+extern std::vector<Bench> AllocateBenchVec;
+extern std::vector<Bench> AtomicNumberBenchVec;
+extern std::vector<Bench> BarBuilderBenchVec;
+extern std::vector<Bench> ColumnOpsBenchVec;
+extern std::vector<Bench> CrossRatesBenchVec;
+extern std::vector<Bench> FinancingBenchVec;
+extern std::vector<Bench> HashBenchVec;
+extern std::vector<Bench> MathBenchVec;
+extern std::vector<Bench> MoneyBenchVec;
+extern std::vector<Bench> ParallelBenchVec;
+extern std::vector<Bench> ReductionsBenchVec;
+extern std::vector<Bench> RollingWindowBenchVec;
+extern std::vector<Bench> ShardedAccumulatorBenchVec;
+extern std::vector<Bench> SortBenchVec;
+extern std::vector<Bench> StreamingStatsBenchVec;
+
+static std::vector<BenchVec> benchVecs = {
+  {
+    { "Column Ops", ColumnOpsBenchVec },
+    { "Reductions", ReductionsBenchVec },
+    { "Sort", SortBenchVec },
+    { "Hash", HashBenchVec },
+    { "Accumulator", AccumulatorBenchVec },
+    { "Sharded Accumulator", ShardedAccumulatorBenchVec },
+    { "Atomic Number", AtomicNumberBenchVec },
+    { "Streaming Stats", StreamingStatsBenchVec },
+    { "Rolling Window", RollingWindowBenchVec },
+    { "Bar Builder", BarBuilderBenchVec },
+    { "Parallel", ParallelBenchVec },
+    { "Math", MathBenchVec },
+    { "Financing", FinancingBenchVec },
+    { "Cross Rates", CrossRatesBenchVec },
+    { "Money", MoneyBenchVec },
+    { "Allocate", AllocateBenchVec }
+  }
+};
+
+} // namespace bench
+} // namespace fixed
+
+int main ()
+{
+    std::cout << "CPU tier: "
+              << fixed::CpuDispatch::tierToString (fixed::CpuDispatch::tier ())
+              << std::endl;
+
+    for (const auto& bvec: fixed::bench::benchVecs)
+    {
+        std::cout << bvec.name << std::endl;
+
+        for (const auto& b: bvec.benches)
+        {
+            b.func ();
+        }
+    }
+
+    return 0;
+}
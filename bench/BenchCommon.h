@@ -0,0 +1,129 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_BENCH_COMMON_H
+#define FIXED_BENCH_COMMON_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+struct Bench {
+    Bench (
+        const std::function<void ()>& f,
+        const std::string& n
+    ) : func (f), name (n) {}
+
+    const std::function<void ()> func;
+    const std::string name;
+};
+
+//
+// Sink for results so the compiler can't discard the work being timed.
+//
+extern volatile uint64_t sink;
+
+//
+// Runs func repetitions times and returns the fastest run in nanoseconds,
+// the fastest being the least disturbed by anything else on the machine.
+//
+inline double bestNanos (
+    const std::function<void ()>& func,
+    const unsigned int repetitions = 7
+)
+{
+    double best = 0;
+
+    for (unsigned int rep = 0; rep < repetitions; ++rep)
+    {
+        const auto start = std::chrono::steady_clock::now ();
+
+        func ();
+
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now () - start;
+
+        if (rep == 0 || elapsed.count () < best)
+        {
+            best = elapsed.count ();
+        }
+    }
+
+    return best;
+}
+
+//
+// Times threadCount threads each running work, taking the best of 3 runs.
+//
+inline double threadedNanos (
+    const unsigned int threadCount,
+    const std::function<void ()>& work
+)
+{
+    return bestNanos ([&] () {
+        std::vector<std::thread> threads;
+
+        for (unsigned int thread = 0; thread < threadCount; ++thread)
+        {
+            threads.emplace_back (work);
+        }
+
+        for (auto& thread: threads)
+        {
+            thread.join ();
+        }
+    }, 3);
+}
+
+//
+// Prints the time per item, and the throughput over bytes, the bytes of
+// input read by one run.
+//
+inline void report (
+    const std::string& name,
+    const double nanos,
+    const size_t items,
+    const size_t bytes
+)
+{
+    std::cout << "  " << std::left << std::setw (44) << name << std::right
+              << std::fixed << std::setprecision (2)
+              << std::setw (9) << nanos / items << " ns/item"
+              << std::setw (9) << bytes / nanos << " GB/s"
+              << std::endl;
+}
+
+} // namespace bench
+} // namespace fixed
+
+#endif // FIXED_BENCH_COMMON_H
@@ -0,0 +1,307 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ColumnOps.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 20;
+
+static const unsigned int DECIMAL_PLACES = 5;
+
+//
+// Prices and deltas up to +/- 10 million at 5 decimal places.
+//
+static std::vector<Number> makeNumbers (const uint64_t seed)
+{
+    std::mt19937_64 generator (seed);
+    std::uniform_int_distribution<int64_t> distribution (
+        -1000000000000LL, 1000000000000LL
+    );
+
+    std::vector<Number> numbers;
+    numbers.reserve (COUNT);
+
+    for (size_t idx = 0; idx < COUNT; ++idx)
+    {
+        numbers.push_back (
+            Number::fromScaledValue (distribution (generator), DECIMAL_PLACES)
+        );
+    }
+
+    return numbers;
+}
+
+static const std::vector<Number>& lhsNumbers ()
+{
+    static const std::vector<Number> numbers = makeNumbers (1);
+
+    return numbers;
+}
+
+static const std::vector<Number>& rhsNumbers ()
+{
+    static const std::vector<Number> numbers = makeNumbers (2);
+
+    return numbers;
+}
+
+static const NumberColumn& lhsColumn ()
+{
+    static const NumberColumn column (lhsNumbers (), DECIMAL_PLACES);
+
+    return column;
+}
+
+static const NumberColumn& rhsColumn ()
+{
+    static const NumberColumn column (rhsNumbers (), DECIMAL_PLACES);
+
+    return column;
+}
+
+static const size_t BINARY_BYTES = 2 * COUNT * sizeof (int64_t);
+
+static void scalarAdd ()
+{
+    std::vector<Number> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] = lhsNumbers () [idx] + rhsNumbers () [idx];
+        }
+
+        sink = sink + results [COUNT / 2].decimalPlaces ();
+    });
+
+    report ("Number operator+ loop", nanos, COUNT, BINARY_BYTES);
+}
+
+static void columnAdd ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto result = ColumnOps::add (lhsColumn (), rhsColumn ());
+
+        sink = sink + result.mantissas () [COUNT / 2];
+    });
+
+    report ("ColumnOps::add", nanos, COUNT, BINARY_BYTES);
+}
+
+static void columnSubtract ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto result = ColumnOps::subtract (lhsColumn (), rhsColumn ());
+
+        sink = sink + result.mantissas () [COUNT / 2];
+    });
+
+    report ("ColumnOps::subtract", nanos, COUNT, BINARY_BYTES);
+}
+
+static void columnMax ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto result = ColumnOps::max (lhsColumn (), rhsColumn ());
+
+        sink = sink + result.mantissas () [COUNT / 2];
+    });
+
+    report ("ColumnOps::max", nanos, COUNT, BINARY_BYTES);
+}
+
+static void columnNegate ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto result = ColumnOps::negate (lhsColumn ());
+
+        sink = sink + result.mantissas () [COUNT / 2];
+    });
+
+    report ("ColumnOps::negate", nanos, COUNT, BINARY_BYTES / 2);
+}
+
+static void scalarLessThan ()
+{
+    std::vector<bool> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] = lhsNumbers () [idx] < rhsNumbers () [idx];
+        }
+
+        sink = sink + results [COUNT / 2];
+    });
+
+    report ("Number operator< loop", nanos, COUNT, BINARY_BYTES);
+}
+
+static void columnLessThan ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto mask = ColumnOps::lessThan (lhsColumn (), rhsColumn ());
+
+        sink = sink + mask.words () [0];
+    });
+
+    report ("ColumnOps::lessThan", nanos, COUNT, BINARY_BYTES);
+}
+
+//
+// A threshold with more decimal places than the column, so each scalar
+// comparison has to align the scales.
+//
+static const Number& threshold ()
+{
+    static const Number number ("1234.567891");
+
+    return number;
+}
+
+static void scalarThreshold ()
+{
+    std::vector<bool> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] = lhsNumbers () [idx] < threshold ();
+        }
+
+        sink = sink + results [COUNT / 2];
+    });
+
+    report ("Number operator< threshold loop", nanos, COUNT, BINARY_BYTES / 2);
+}
+
+static void columnThreshold ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto mask = ColumnOps::lessThan (lhsColumn (), threshold ());
+
+        sink = sink + mask.words () [0];
+    });
+
+    report ("ColumnOps::lessThan threshold", nanos, COUNT, BINARY_BYTES / 2);
+}
+
+static void columnBetween ()
+{
+    const Number low ("-2500000.5");
+
+    const double nanos = bestNanos ([&] () {
+        const auto mask = ColumnOps::between (lhsColumn (), low, threshold ());
+
+        sink = sink + mask.words () [0];
+    });
+
+    report ("ColumnOps::between", nanos, COUNT, BINARY_BYTES / 2);
+}
+
+static void scalarRescale ()
+{
+    std::vector<Number> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] = lhsNumbers () [idx];
+            results [idx].setDecimalPlaces (2);
+        }
+
+        sink = sink + results [COUNT / 2].decimalPlaces ();
+    });
+
+    report ("Number::setDecimalPlaces loop", nanos, COUNT, BINARY_BYTES / 2);
+}
+
+static void batchRescale ()
+{
+    std::vector<Number> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        results = lhsNumbers ();
+
+        Number::setDecimalPlaces (
+            results.data (),
+            COUNT,
+            2,
+            Number::DEFAULT_ROUNDING_MODE
+        );
+
+        sink = sink + results [COUNT / 2].decimalPlaces ();
+    });
+
+    report ("Number::setDecimalPlaces batch", nanos, COUNT, BINARY_BYTES / 2);
+}
+
+static void columnRescaleDown ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto result = ColumnOps::rescale (lhsColumn (), 2);
+
+        sink = sink + result.mantissas () [COUNT / 2];
+    });
+
+    report ("ColumnOps::rescale 5 to 2 dp", nanos, COUNT, BINARY_BYTES / 2);
+}
+
+static void columnRescaleUp ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto result = ColumnOps::rescale (lhsColumn (), 8);
+
+        sink = sink + result.mantissas () [COUNT / 2];
+    });
+
+    report ("ColumnOps::rescale 5 to 8 dp", nanos, COUNT, BINARY_BYTES / 2);
+}
+
+std::vector<Bench> ColumnOpsBenchVec = {
+    {scalarAdd, "scalar add"},
+    {columnAdd, "column add"},
+    {columnSubtract, "column subtract"},
+    {columnMax, "column max"},
+    {columnNegate, "column negate"},
+    {scalarLessThan, "scalar lessThan"},
+    {columnLessThan, "column lessThan"},
+    {scalarThreshold, "scalar threshold"},
+    {columnThreshold, "column threshold"},
+    {columnBetween, "column between"},
+    {scalarRescale, "scalar rescale"},
+    {batchRescale, "batch rescale"},
+    {columnRescaleDown, "column rescale down"},
+    {columnRescaleUp, "column rescale up"}
+};
+
+} // namespace bench
+} // namespace fixed
@@ -0,0 +1,215 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/CrossRates.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 20;
+
+//
+// USD is the pivot, EUR the home currency.  The quotes are the way the
+// market gives them, the last two being units per USD.
+//
+static const uint32_t EUR = 1;
+
+static const char* const QUOTES [] = {
+    "1", "1.0850", "1.2712", "0.6543", "149.50", "0.8812"
+};
+
+static const size_t CURRENCIES = sizeof (QUOTES) / sizeof (QUOTES [0]);
+
+static bool unitsPerPivot (const size_t currency)
+{
+    return currency >= 4;
+}
+
+static CrossRates& rates ()
+{
+    static CrossRates values (CURRENCIES, 0);
+
+    if (! values.hasRate (1))
+    {
+        for (uint32_t currency = 1; currency < CURRENCIES; ++currency)
+        {
+            values.setRate (
+                currency,
+                Number (QUOTES [currency]),
+                unitsPerPivot (currency) ?
+                    CrossRates::Quote::UNITS_PER_PIVOT :
+                    CrossRates::Quote::PIVOT_PER_UNIT
+            );
+        }
+    }
+
+    return values;
+}
+
+//
+// Account balances at 2 decimal places, each in a random currency.
+//
+struct Balances {
+    Balances () : amounts (2)
+    {
+        std::mt19937_64 generator (48);
+        std::uniform_int_distribution<int64_t> distribution (
+            -10000000000, 10000000000
+        );
+
+        amounts.reserve (COUNT);
+        currencies.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            amounts.pushBackScaledValue (distribution (generator));
+            currencies.push_back (generator () % CURRENCIES);
+        }
+
+        numbers = amounts.toNumbers ();
+    }
+
+    NumberColumn amounts;
+    std::vector<uint32_t> currencies;
+    std::vector<Number> numbers;
+};
+
+static const Balances& balances ()
+{
+    static const Balances values;
+
+    return values;
+}
+
+static const size_t BYTES = COUNT * (sizeof (int64_t) + sizeof (uint32_t));
+
+//
+// Triangulating through USD with Number operators, the inverse of a units
+// per USD quote being worked out each time.
+//
+static void chainedConvert ()
+{
+    const Balances& inputs = balances ();
+
+    std::vector<Number> quotes;
+
+    for (const auto quote: QUOTES)
+    {
+        quotes.push_back (Number (quote));
+    }
+
+    std::vector<Number> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            const uint32_t currency = inputs.currencies [idx];
+
+            const Number usd = unitsPerPivot (currency) ?
+                               inputs.numbers [idx] / quotes [currency] :
+                               inputs.numbers [idx] * quotes [currency];
+
+            results [idx] = usd / quotes [EUR];
+            results [idx].setDecimalPlaces (2);
+        }
+
+        sink = sink + results [COUNT / 2].decimalPlaces ();
+    });
+
+    report ("Number operator triangulation", nanos, COUNT, BYTES);
+}
+
+static void scalarConvert ()
+{
+    const Balances& inputs = balances ();
+    const CrossRates& engine = rates ();
+
+    std::vector<Number> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] = engine.convert (
+                inputs.numbers [idx], inputs.currencies [idx], EUR, 2
+            );
+        }
+
+        sink = sink + results [COUNT / 2].decimalPlaces ();
+    });
+
+    report ("CrossRates::convert scalar", nanos, COUNT, BYTES);
+}
+
+static void batchConvert ()
+{
+    const Balances& inputs = balances ();
+    const CrossRates& engine = rates ();
+
+    const double nanos = bestNanos ([&] () {
+        sink = sink +
+               engine.convert (
+                   inputs.amounts, inputs.currencies, EUR, 2
+               ).mantissas () [COUNT / 2];
+    });
+
+    report ("CrossRates::convert batch", nanos, COUNT, BYTES);
+}
+
+static void refreshRates ()
+{
+    CrossRates& engine = rates ();
+
+    const Number eur (QUOTES [EUR]);
+    const size_t ticks = 100000;
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t tick = 0; tick < ticks; ++tick)
+        {
+            engine.setRate (EUR, eur);
+        }
+    });
+
+    report (
+        "CrossRates::setRate " + std::to_string (CURRENCIES) + " currencies",
+        nanos,
+        ticks,
+        ticks * sizeof (Number)
+    );
+}
+
+std::vector<Bench> CrossRatesBenchVec = {
+    {chainedConvert, "chained conversion"},
+    {scalarConvert, "scalar conversion"},
+    {batchConvert, "batch conversion"},
+    {refreshRates, "rate refresh"}
+};
+
+} // namespace bench
+} // namespace fixed
@@ -0,0 +1,177 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Financing.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 20;
+
+static const unsigned int POOL_SIZES [] = {1, 2, 4, 8};
+
+static const unsigned int BASIS = 365;
+
+static const unsigned int DAYS = 3;
+
+//
+// Positions of up to 10^7 units at 5 decimal place prices and 6 decimal
+// place rates, as a rollover would see them.
+//
+struct Positions {
+    Positions () : units (2), prices (5), rates (6)
+    {
+        std::mt19937_64 generator (47);
+
+        std::uniform_int_distribution<int64_t> unitDistribution (
+            -1000000000, 1000000000
+        );
+        std::uniform_int_distribution<int64_t> priceDistribution (
+            50000, 20000000
+        );
+        std::uniform_int_distribution<int64_t> rateDistribution (
+            -60000, 60000
+        );
+
+        units.reserve (COUNT);
+        prices.reserve (COUNT);
+        rates.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            units.pushBackScaledValue (unitDistribution (generator));
+            prices.pushBackScaledValue (priceDistribution (generator));
+            rates.pushBackScaledValue (rateDistribution (generator));
+        }
+
+        unitNumbers = units.toNumbers ();
+        priceNumbers = prices.toNumbers ();
+        rateNumbers = rates.toNumbers ();
+    }
+
+    NumberColumn units;
+    NumberColumn prices;
+    NumberColumn rates;
+
+    std::vector<Number> unitNumbers;
+    std::vector<Number> priceNumbers;
+    std::vector<Number> rateNumbers;
+};
+
+static const Positions& positions ()
+{
+    static const Positions values;
+
+    return values;
+}
+
+static const size_t BYTES = 3 * COUNT * sizeof (int64_t);
+
+static void chainedAccrue ()
+{
+    const Positions& inputs = positions ();
+
+    std::vector<Number> results (COUNT);
+
+    const Number days (DAYS);
+    const Number basis (BASIS);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] =
+                inputs.unitNumbers [idx] * inputs.priceNumbers [idx] *
+                inputs.rateNumbers [idx] * days / basis;
+            results [idx].setDecimalPlaces (2);
+        }
+
+        sink = sink + results [COUNT / 2].decimalPlaces ();
+    });
+
+    report ("Number operator chain", nanos, COUNT, BYTES);
+}
+
+static void scalarAccrue ()
+{
+    const Positions& inputs = positions ();
+    const Financing financing (BASIS, 2);
+
+    std::vector<Number> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] = financing.accrue (
+                inputs.unitNumbers [idx],
+                inputs.priceNumbers [idx],
+                inputs.rateNumbers [idx],
+                DAYS
+            );
+        }
+
+        sink = sink + results [COUNT / 2].decimalPlaces ();
+    });
+
+    report ("Financing::accrue scalar", nanos, COUNT, BYTES);
+}
+
+static void batchAccrue ()
+{
+    const Positions& inputs = positions ();
+    const Financing financing (BASIS, 2);
+
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        const double nanos = bestNanos ([&] () {
+            sink = sink +
+                   financing.accrue (
+                       inputs.units, inputs.prices, inputs.rates, DAYS, pool
+                   ).mantissas () [COUNT / 2];
+        });
+
+        report (
+            "Financing::accrue batch " + std::to_string (threads) + "T",
+            nanos,
+            COUNT,
+            BYTES
+        );
+    }
+}
+
+std::vector<Bench> FinancingBenchVec = {
+    {chainedAccrue, "chained accrual"},
+    {scalarAccrue, "scalar accrual"},
+    {batchAccrue, "batch accrual"}
+};
+
+} // namespace bench
+} // namespace fixed
@@ -0,0 +1,169 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Number.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t PRICE_COUNT = 1 << 16;
+
+static const size_t LOOKUP_COUNT = 1 << 20;
+
+//
+// Distinct prices around 1.1 at 5 decimal places, and lookups of them at 4
+// to 6 decimal places, the way prices arrive from different feeds.
+//
+static const std::vector<Number>& prices ()
+{
+    static std::vector<Number> values;
+
+    if (values.empty ())
+    {
+        values.reserve (PRICE_COUNT);
+
+        for (size_t idx = 0; idx < PRICE_COUNT; ++idx)
+        {
+            values.push_back (
+                Number::fromScaledValue (100000 + idx * 10, 5)
+            );
+        }
+    }
+
+    return values;
+}
+
+static const std::vector<Number>& lookups ()
+{
+    static std::vector<Number> values;
+
+    if (values.empty ())
+    {
+        std::mt19937_64 generator (13);
+
+        values.reserve (LOOKUP_COUNT);
+
+        for (size_t idx = 0; idx < LOOKUP_COUNT; ++idx)
+        {
+            Number price (prices () [generator () % PRICE_COUNT]);
+
+            price.setDecimalPlaces (4 + generator () % 3);
+
+            values.push_back (price);
+        }
+    }
+
+    return values;
+}
+
+static void hashNumbers ()
+{
+    const double nanos = bestNanos ([] () {
+        const std::hash<Number> hasher;
+
+        for (const auto& number: lookups ())
+        {
+            sink = sink + hasher (number);
+        }
+    });
+
+    report (
+        "std::hash<Number>",
+        nanos,
+        LOOKUP_COUNT,
+        LOOKUP_COUNT * sizeof (Number)
+    );
+}
+
+//
+// Without a hash the price had to go through a string, which also needs
+// the scale normalising first to find 1.1025 as 1.10250.
+//
+static void stringMapLookups ()
+{
+    std::unordered_map<std::string, size_t> map;
+
+    for (size_t idx = 0; idx < PRICE_COUNT; ++idx)
+    {
+        map.emplace (prices () [idx].toString (), idx);
+    }
+
+    const double nanos = bestNanos ([&] () {
+        for (const auto& number: lookups ())
+        {
+            Number key (number);
+
+            key.setDecimalPlaces (5);
+
+            sink = sink + map.find (key.toString ())->second;
+        }
+    });
+
+    report (
+        "unordered_map<string> lookup",
+        nanos,
+        LOOKUP_COUNT,
+        LOOKUP_COUNT * sizeof (Number)
+    );
+}
+
+static void numberMapLookups ()
+{
+    std::unordered_map<Number, size_t> map;
+
+    for (size_t idx = 0; idx < PRICE_COUNT; ++idx)
+    {
+        map.emplace (prices () [idx], idx);
+    }
+
+    const double nanos = bestNanos ([&] () {
+        for (const auto& number: lookups ())
+        {
+            sink = sink + map.find (number)->second;
+        }
+    });
+
+    report (
+        "unordered_map<Number> lookup",
+        nanos,
+        LOOKUP_COUNT,
+        LOOKUP_COUNT * sizeof (Number)
+    );
+}
+
+std::vector<Bench> HashBenchVec = {
+    {hashNumbers, "hash"},
+    {stringMapLookups, "string map lookups"},
+    {numberMapLookups, "Number map lookups"}
+};
+
+} // namespace bench
+} // namespace fixed
@@ -0,0 +1,248 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Math.h"
+#include "BenchCommon.h"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 16;
+
+static const size_t BYTES = COUNT * sizeof (Number);
+
+static const unsigned int DECIMAL_PLACES = 10;
+
+static const Rounding::Mode MODE = Rounding::Mode::TO_NEAREST_HALF_TO_EVEN;
+
+//
+// Positive values from 0.0001 to 100 at 4 decimal places, the exponents
+// from -4 to 4 at 2.
+//
+static const std::vector<Number>& values ()
+{
+    static std::vector<Number> numbers;
+
+    if (numbers.empty ())
+    {
+        std::mt19937_64 generator (45);
+        std::uniform_int_distribution<int64_t> distribution (1, 1000000);
+
+        numbers.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            numbers.push_back (
+                Number::fromScaledValue (distribution (generator), 4)
+            );
+        }
+    }
+
+    return numbers;
+}
+
+static const std::vector<Number>& exponents ()
+{
+    static std::vector<Number> numbers;
+
+    if (numbers.empty ())
+    {
+        std::mt19937_64 generator (450);
+        std::uniform_int_distribution<int64_t> distribution (-400, 400);
+
+        numbers.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            numbers.push_back (
+                Number::fromScaledValue (distribution (generator), 2)
+            );
+        }
+    }
+
+    return numbers;
+}
+
+template <typename Function>
+static void unary (const std::string& name, Function function)
+{
+    const double nanos = bestNanos ([&function] () {
+        for (const auto& value: values ())
+        {
+            sink = sink + function (value).decimalPlaces ();
+        }
+    });
+
+    report (name, nanos, COUNT, BYTES);
+}
+
+//
+// The double round trip each function replaces, converting back with the
+// same rounding.
+//
+static Number viaDouble (double (* function) (double), const Number& value)
+{
+    return Number::floatingPoint (
+        function (value.toDouble ()), DECIMAL_PLACES, MODE
+    );
+}
+
+static void sqrtBench ()
+{
+    unary ("fixed::sqrt", [] (const Number& value) {
+        return sqrt (value, DECIMAL_PLACES, MODE);
+    });
+
+    unary ("std::sqrt round trip", [] (const Number& value) {
+        return viaDouble (std::sqrt, value);
+    });
+}
+
+//
+// Arguments divided by 4, to keep exp () of them within a Number.
+//
+static void expBench ()
+{
+    unary ("fixed::exp", [] (const Number& value) {
+        return exp (
+            Number::fromScaledValue (value.scaledValue () / 4, 4),
+            DECIMAL_PLACES,
+            MODE
+        );
+    });
+
+    unary ("std::exp round trip", [] (const Number& value) {
+        return viaDouble (
+            std::exp, Number::fromScaledValue (value.scaledValue () / 4, 4)
+        );
+    });
+}
+
+static void logBench ()
+{
+    unary ("fixed::log", [] (const Number& value) {
+        return log (value, DECIMAL_PLACES, MODE);
+    });
+
+    unary ("std::log round trip", [] (const Number& value) {
+        return viaDouble (std::log, value);
+    });
+}
+
+static void powBench ()
+{
+    const auto run = [] (const std::string& name, bool viaFloat) {
+        const double nanos = bestNanos ([viaFloat] () {
+            const std::vector<Number>& bases = values ();
+            const std::vector<Number>& powers = exponents ();
+
+            for (size_t idx = 0; idx < COUNT; ++idx)
+            {
+                const Number result = viaFloat ?
+                    Number::floatingPoint (
+                        std::pow (
+                            bases [idx].toDouble (), powers [idx].toDouble ()
+                        ),
+                        DECIMAL_PLACES,
+                        MODE
+                    ) :
+                    pow (bases [idx], powers [idx], DECIMAL_PLACES, MODE);
+
+                sink = sink + result.decimalPlaces ();
+            }
+        });
+
+        report (name, nanos, COUNT, 2 * BYTES);
+    };
+
+    run ("fixed::pow", false);
+    run ("std::pow round trip", true);
+}
+
+//
+// A daily compounding factor over N days, by a loop of operator*= against
+// repeated squaring.
+//
+static void compoundingBench ()
+{
+    const Number daily ("1.000137");
+
+    for (const unsigned int days: {30u, 365u, 3650u})
+    {
+        const size_t count = 4096;
+
+        const double loopNanos = bestNanos ([&daily, days, count] () {
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                Number factor (1);
+
+                for (unsigned int day = 0; day < days; ++day)
+                {
+                    factor *= daily;
+                }
+
+                sink = sink + factor.decimalPlaces ();
+            }
+        });
+
+        const double powNanos = bestNanos ([&daily, days, count] () {
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                sink = sink + pow (daily, days, 14, MODE).decimalPlaces ();
+            }
+        });
+
+        const std::string suffix = " " + std::to_string (days) + " days";
+
+        report (
+            "operator*= loop" + suffix,
+            loopNanos,
+            count,
+            count * sizeof (Number)
+        );
+        report (
+            "fixed::pow" + suffix,
+            powNanos,
+            count,
+            count * sizeof (Number)
+        );
+    }
+}
+
+std::vector<Bench> MathBenchVec = {
+    {sqrtBench, "sqrt"},
+    {expBench, "exp"},
+    {logBench, "log"},
+    {powBench, "pow"},
+    {compoundingBench, "compounding"}
+};
+
+} // namespace bench
+} // namespace fixed
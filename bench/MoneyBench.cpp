@@ -0,0 +1,154 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Money.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 20;
+
+//
+// USD amounts up to a million, as Money and as Numbers at 2 decimal places.
+//
+struct Amounts {
+    Amounts ()
+    {
+        std::mt19937_64 generator (49);
+        std::uniform_int_distribution<int64_t> distribution (
+            -100000000, 100000000
+        );
+
+        money.reserve (COUNT);
+        numbers.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            const int64_t cents = distribution (generator);
+
+            money.push_back (Money::fromMinorUnits (cents, Currency::USD));
+            numbers.push_back (Number::fromScaledValue (cents, 2));
+        }
+    }
+
+    std::vector<Money> money;
+    std::vector<Number> numbers;
+};
+
+static const Amounts& amounts ()
+{
+    static const Amounts values;
+
+    return values;
+}
+
+static void numberSum ()
+{
+    const Amounts& inputs = amounts ();
+
+    const double nanos = bestNanos ([&inputs] () {
+        Number total;
+
+        for (const auto& number: inputs.numbers)
+        {
+            total += number;
+        }
+
+        sink = sink + total.decimalPlaces ();
+    });
+
+    report ("Number operator+=", nanos, COUNT, COUNT * sizeof (Number));
+}
+
+static void moneySum ()
+{
+    const Amounts& inputs = amounts ();
+
+    const double nanos = bestNanos ([&inputs] () {
+        Money total = Money::fromMinorUnits (0, Currency::USD);
+
+        for (const auto& money: inputs.money)
+        {
+            total += money;
+        }
+
+        sink = sink + total.minorUnits ();
+    });
+
+    report ("Money operator+=", nanos, COUNT, COUNT * sizeof (Money));
+}
+
+static void numberConvert ()
+{
+    const Amounts& inputs = amounts ();
+    const Number rate ("149.505");
+
+    std::vector<Number> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] = inputs.numbers [idx] * rate;
+            results [idx].setDecimalPlaces (0);
+        }
+
+        sink = sink + results [COUNT / 2].decimalPlaces ();
+    });
+
+    report ("Number operator* to JPY", nanos, COUNT, COUNT * sizeof (Number));
+}
+
+static void moneyConvert ()
+{
+    const Amounts& inputs = amounts ();
+    const Number rate ("149.505");
+
+    std::vector<Money> results (COUNT);
+
+    const double nanos = bestNanos ([&] () {
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            results [idx] = inputs.money [idx].convert (Currency::JPY, rate);
+        }
+
+        sink = sink + results [COUNT / 2].minorUnits ();
+    });
+
+    report ("Money::convert to JPY", nanos, COUNT, COUNT * sizeof (Money));
+}
+
+std::vector<Bench> MoneyBenchVec = {
+    {numberSum, "Number sum"},
+    {moneySum, "Money sum"},
+    {numberConvert, "Number conversion"},
+    {moneyConvert, "Money conversion"}
+};
+
+} // namespace bench
+} // namespace fixed
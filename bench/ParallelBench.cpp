@@ -0,0 +1,166 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Parallel.h"
+#include "fixed/Reductions.h"
+#include "BenchCommon.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 22;
+
+static const unsigned int POOL_SIZES [] = {1, 2, 4, 8, 16, 32, 64};
+
+//
+// Values at 0 to 8 decimal places.
+//
+static const std::vector<Number>& numbers (const int seed)
+{
+    static std::vector<Number> values [2];
+
+    std::vector<Number>& result = values [seed & 1];
+
+    if (result.empty ())
+    {
+        std::mt19937_64 generator (seed);
+        std::uniform_int_distribution<int64_t> distribution (
+            -10000000, 10000000
+        );
+
+        result.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            result.push_back (
+                Number::fromScaledValue (
+                    distribution (generator), generator () % 9
+                )
+            );
+        }
+    }
+
+    return result;
+}
+
+static const size_t BYTES = COUNT * sizeof (Number);
+
+static void serialSum ()
+{
+    const double nanos = bestNanos ([] () {
+        sink = sink +
+               Reductions::sum (numbers (0).data (), COUNT).decimalPlaces ();
+    });
+
+    report ("Reductions::sum", nanos, COUNT, BYTES);
+}
+
+static void parallelReduce ()
+{
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        const double nanos = bestNanos ([&pool] () {
+            sink = sink +
+                   parallel::reduce (
+                       numbers (0).data (), COUNT, pool
+                   ).decimalPlaces ();
+        });
+
+        report (
+            "parallel::reduce " + std::to_string (threads) + "T",
+            nanos,
+            COUNT,
+            BYTES
+        );
+    }
+}
+
+static void parallelInnerProduct ()
+{
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        const double nanos = bestNanos ([&pool] () {
+            sink = sink +
+                   parallel::transform_reduce (
+                       numbers (0).data (), numbers (1).data (), COUNT, pool
+                   ).decimalPlaces ();
+        });
+
+        report (
+            "parallel::transform_reduce " + std::to_string (threads) + "T",
+            nanos,
+            COUNT,
+            2 * BYTES
+        );
+    }
+}
+
+static void parallelTransform ()
+{
+    std::unique_ptr<Number []> result (new Number [COUNT]);
+
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        const double nanos = bestNanos ([&pool, &result] () {
+            parallel::transform (
+                numbers (0).data (),
+                COUNT,
+                result.get (),
+                [] (const Number& number) { return -number; },
+                pool
+            );
+
+            sink = sink + result [COUNT - 1].decimalPlaces ();
+        });
+
+        report (
+            "parallel::transform " + std::to_string (threads) + "T",
+            nanos,
+            COUNT,
+            2 * BYTES
+        );
+    }
+}
+
+std::vector<Bench> ParallelBenchVec = {
+    {serialSum, "serial sum"},
+    {parallelReduce, "parallel reduce"},
+    {parallelInnerProduct, "parallel inner product"},
+    {parallelTransform, "parallel transform"}
+};
+
+} // namespace bench
+} // namespace fixed
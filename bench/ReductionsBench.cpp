@@ -0,0 +1,155 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Reductions.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 22;
+
+static const unsigned int DECIMAL_PLACES = 2;
+
+static const std::vector<Number>& numbers ()
+{
+    static std::vector<Number> values;
+
+    if (values.empty ())
+    {
+        std::mt19937_64 generator (3);
+        std::uniform_int_distribution<int64_t> distribution (
+            -100000000000LL, 100000000000LL
+        );
+
+        values.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            values.push_back (
+                Number::fromScaledValue (
+                    distribution (generator), DECIMAL_PLACES
+                )
+            );
+        }
+    }
+
+    return values;
+}
+
+static const NumberColumn& column ()
+{
+    static const NumberColumn values (numbers (), DECIMAL_PLACES);
+
+    return values;
+}
+
+static const size_t COLUMN_BYTES = COUNT * sizeof (int64_t);
+
+static const size_t ARRAY_BYTES = COUNT * sizeof (Number);
+
+static void scalarSum ()
+{
+    const double nanos = bestNanos ([] () {
+        Number total (0);
+
+        for (const auto& number: numbers ())
+        {
+            total += number;
+        }
+
+        sink = sink + total.decimalPlaces ();
+    });
+
+    report ("Number operator+= loop", nanos, COUNT, ARRAY_BYTES);
+}
+
+static void arraySum ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto total = Reductions::sum (numbers ().data (), COUNT);
+
+        sink = sink + total.decimalPlaces ();
+    });
+
+    report ("Reductions::sum Number array", nanos, COUNT, ARRAY_BYTES);
+}
+
+static void columnSum ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto total = Reductions::sum (column ());
+
+        sink = sink + total.decimalPlaces ();
+    });
+
+    report ("Reductions::sum column", nanos, COUNT, COLUMN_BYTES);
+}
+
+static void columnMean ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto mean = Reductions::mean (column ());
+
+        sink = sink + mean.decimalPlaces ();
+    });
+
+    report ("Reductions::mean column", nanos, COUNT, COLUMN_BYTES);
+}
+
+static void columnMin ()
+{
+    const double nanos = bestNanos ([] () {
+        const auto min = Reductions::min (column ());
+
+        sink = sink + min.decimalPlaces ();
+    });
+
+    report ("Reductions::min column", nanos, COUNT, COLUMN_BYTES);
+}
+
+static void columnCountNonZero ()
+{
+    const double nanos = bestNanos ([] () {
+        sink = sink + Reductions::countNonZero (column ());
+    });
+
+    report ("Reductions::countNonZero column", nanos, COUNT, COLUMN_BYTES);
+}
+
+std::vector<Bench> ReductionsBenchVec = {
+    {scalarSum, "scalar sum"},
+    {arraySum, "array sum"},
+    {columnSum, "column sum"},
+    {columnMean, "column mean"},
+    {columnMin, "column min"},
+    {columnCountNonZero, "column countNonZero"}
+};
+
+} // namespace bench
+} // namespace fixed
@@ -0,0 +1,165 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/RollingWindow.h"
+#include "BenchCommon.h"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 20;
+
+static const size_t WINDOW = 1000;
+
+//
+// Prices at 5 decimal places.
+//
+static const std::vector<Number>& prices ()
+{
+    static std::vector<Number> values;
+
+    if (values.empty ())
+    {
+        std::mt19937_64 generator (47);
+        std::uniform_int_distribution<int64_t> distribution (100000, 200000);
+
+        values.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            values.push_back (
+                Number::fromScaledValue (distribution (generator), 5)
+            );
+        }
+    }
+
+    return values;
+}
+
+static const size_t BYTES = COUNT * sizeof (Number);
+
+//
+// A deque of Numbers with a running operator+= sum and a scan for the min
+// and max whenever the one leaving the window was one of them.
+//
+static void numberWindow ()
+{
+    const double nanos = bestNanos ([] () {
+        std::deque<Number> window;
+        Number sum (0);
+        Number min (0);
+        Number max (0);
+
+        for (const auto& price: prices ())
+        {
+            if (window.size () == WINDOW)
+            {
+                const Number oldest (window.front ());
+
+                window.pop_front ();
+                sum -= oldest;
+
+                if (oldest == min)
+                {
+                    min = *std::min_element (window.begin (), window.end ());
+                }
+
+                if (oldest == max)
+                {
+                    max = *std::max_element (window.begin (), window.end ());
+                }
+            }
+
+            if (window.empty () || price < min)
+            {
+                min = price;
+            }
+
+            if (window.empty () || max < price)
+            {
+                max = price;
+            }
+
+            window.push_back (price);
+            sum += price;
+        }
+
+        sink = sink + sum.decimalPlaces () + min.decimalPlaces () +
+               max.decimalPlaces ();
+    });
+
+    report ("deque of Number sum min max", nanos, COUNT, BYTES);
+}
+
+static void rollingWindow ()
+{
+    const double nanos = bestNanos ([] () {
+        RollingWindow window (WINDOW, 5);
+        uint64_t decimalPlaces = 0;
+
+        for (const auto& price: prices ())
+        {
+            window.add (price);
+            decimalPlaces +=
+                window.sum ().decimalPlaces () +
+                window.min ().decimalPlaces () +
+                window.max ().decimalPlaces ();
+        }
+
+        sink = sink + decimalPlaces;
+    });
+
+    report ("RollingWindow sum min max", nanos, COUNT, BYTES);
+}
+
+static void rollingWindowAdd ()
+{
+    const double nanos = bestNanos ([] () {
+        RollingWindow window (WINDOW, 5);
+
+        for (const auto& price: prices ())
+        {
+            window.add (price);
+        }
+
+        sink = sink + window.size ();
+    });
+
+    report ("RollingWindow::add", nanos, COUNT, BYTES);
+}
+
+std::vector<Bench> RollingWindowBenchVec = {
+    {numberWindow, "number window"},
+    {rollingWindow, "rolling window"},
+    {rollingWindowAdd, "rolling window add"}
+};
+
+} // namespace bench
+} // namespace fixed
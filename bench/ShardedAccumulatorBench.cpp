@@ -0,0 +1,112 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ShardedAccumulator.h"
+#include "BenchCommon.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t ADDS_PER_THREAD = 1 << 16;
+
+static const unsigned int MAX_THREADS = 64;
+
+static const std::vector<Number>& fills ()
+{
+    static std::vector<Number> values;
+
+    if (values.empty ())
+    {
+        for (size_t idx = 0; idx < ADDS_PER_THREAD; ++idx)
+        {
+            values.push_back (
+                Number::fromScaledValue (1000 + idx % 977, 2 + idx % 5)
+            );
+        }
+    }
+
+    return values;
+}
+
+static void contention ()
+{
+    fills ();
+
+    for (unsigned int threadCount = 1;
+         threadCount <= MAX_THREADS;
+         threadCount *= 2)
+    {
+        const size_t items = ADDS_PER_THREAD * threadCount;
+        const std::string suffix = " " + std::to_string (threadCount) + "T";
+
+        std::mutex mutex;
+        Number locked (0);
+
+        const double mutexNanos = threadedNanos (threadCount, [&] () {
+            for (const auto& fill: fills ())
+            {
+                std::lock_guard<std::mutex> guard (mutex);
+
+                locked += fill;
+            }
+        });
+
+        report (
+            "mutex Number operator+=" + suffix,
+            mutexNanos,
+            items,
+            items * sizeof (Number)
+        );
+
+        ShardedAccumulator sharded;
+
+        const double shardedNanos = threadedNanos (threadCount, [&] () {
+            for (const auto& fill: fills ())
+            {
+                sharded.add (fill);
+            }
+        });
+
+        sink = sink + sharded.snapshot ().decimalPlaces ();
+
+        report (
+            "ShardedAccumulator::add" + suffix,
+            shardedNanos,
+            items,
+            items * sizeof (Number)
+        );
+    }
+}
+
+std::vector<Bench> ShardedAccumulatorBenchVec = {
+    {contention, "contention"}
+};
+
+} // namespace bench
+} // namespace fixed
@@ -0,0 +1,163 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Sort.h"
+#include "BenchCommon.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+//
+// The counts run from 1e3 up to this, or to FIXED_SORT_BENCH_MAX if set.
+// 1e8 Numbers and their sorted copies need well over 10GB of memory.
+//
+static const size_t DEFAULT_MAX_COUNT = 10000000;
+
+static size_t maxCount ()
+{
+    const char* requested = std::getenv ("FIXED_SORT_BENCH_MAX");
+
+    return requested ? std::strtoull (requested, nullptr, 10) :
+                       DEFAULT_MAX_COUNT;
+}
+
+//
+// Order book prices around 1.1 at 5 decimal places, with one in eight at 2
+// decimal places so the scales differ.
+//
+static std::vector<Number> makePrices (const size_t count)
+{
+    std::mt19937_64 generator (count);
+    std::uniform_int_distribution<int64_t> distribution (100000, 120000);
+
+    std::vector<Number> prices;
+    prices.reserve (count);
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        if (idx % 8)
+        {
+            prices.push_back (
+                Number::fromScaledValue (distribution (generator), 5)
+            );
+        }
+        else
+        {
+            prices.push_back (
+                Number::fromScaledValue (distribution (generator) / 1000, 2)
+            );
+        }
+    }
+
+    return prices;
+}
+
+//
+// Both sorts time the copy of the unsorted prices as well.
+//
+static void sortCount (const size_t count)
+{
+    const std::vector<Number> prices (makePrices (count));
+    const size_t bytes = count * sizeof (Number);
+    const unsigned int repetitions = count > 1000000 ? 2 : 7;
+
+    const double stdNanos = bestNanos ([&] () {
+        std::vector<Number> sorted (prices);
+
+        std::sort (sorted.begin (), sorted.end ());
+
+        sink = sink + sorted [0].decimalPlaces ();
+    }, repetitions);
+
+    report ("std::sort " + std::to_string (count), stdNanos, count, bytes);
+
+    const double fixedNanos = bestNanos ([&] () {
+        std::vector<Number> sorted (prices);
+
+        sort (sorted);
+
+        sink = sink + sorted [0].decimalPlaces ();
+    }, repetitions);
+
+    report ("fixed::sort " + std::to_string (count), fixedNanos, count, bytes);
+
+    const double stdArgNanos = bestNanos ([&] () {
+        std::vector<size_t> order (count);
+
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            order [idx] = idx;
+        }
+
+        std::sort (
+            order.begin (),
+            order.end (),
+            [&] (const size_t lhs, const size_t rhs) {
+                return prices [lhs] < prices [rhs];
+            }
+        );
+
+        sink = sink + order [0];
+    }, repetitions);
+
+    report (
+        "std::sort of indices " + std::to_string (count),
+        stdArgNanos,
+        count,
+        bytes
+    );
+
+    const double fixedArgNanos = bestNanos ([&] () {
+        sink = sink + argsort (prices) [0];
+    }, repetitions);
+
+    report (
+        "fixed::argsort " + std::to_string (count),
+        fixedArgNanos,
+        count,
+        bytes
+    );
+}
+
+static void sortCounts ()
+{
+    for (size_t count = 1000; count <= maxCount (); count *= 10)
+    {
+        sortCount (count);
+    }
+}
+
+std::vector<Bench> SortBenchVec = {
+    {sortCounts, "sort counts"}
+};
+
+} // namespace bench
+} // namespace fixed
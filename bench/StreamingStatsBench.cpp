@@ -0,0 +1,153 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/StreamingStats.h"
+#include "BenchCommon.h"
+
+#include <random>
+#include <vector>
+
+namespace fixed {
+namespace bench {
+
+static const size_t COUNT = 1 << 20;
+
+struct Tick {
+    Number price;
+    Number quantity;
+};
+
+//
+// Prices at 5 decimal places and quantities at 0 to 2.
+//
+static const std::vector<Tick>& ticks ()
+{
+    static std::vector<Tick> values;
+
+    if (values.empty ())
+    {
+        std::mt19937_64 generator (41);
+        std::uniform_int_distribution<int64_t> prices (100000, 200000);
+        std::uniform_int_distribution<int64_t> quantities (1, 100000000);
+
+        values.reserve (COUNT);
+
+        for (size_t idx = 0; idx < COUNT; ++idx)
+        {
+            values.push_back ({
+                Number::fromScaledValue (prices (generator), 5),
+                Number::fromScaledValue (quantities (generator), idx % 3)
+            });
+        }
+    }
+
+    return values;
+}
+
+static const size_t BYTES = COUNT * sizeof (Tick);
+
+//
+// The VWAP read after every tick, the way a per tick analytic would, with
+// Number arithmetic redoing the division each time.
+//
+static void numberVwap ()
+{
+    const double nanos = bestNanos ([] () {
+        Number notional (0);
+        Number quantity (0);
+        Number vwap (0);
+
+        for (const auto& tick: ticks ())
+        {
+            notional += tick.price * tick.quantity;
+            quantity += tick.quantity;
+            vwap = notional / quantity;
+        }
+
+        sink = sink + vwap.decimalPlaces ();
+    });
+
+    report ("Number VWAP per tick", nanos, COUNT, BYTES);
+}
+
+static void streamingVwapAdd ()
+{
+    const double nanos = bestNanos ([] () {
+        Vwap vwap;
+
+        for (const auto& tick: ticks ())
+        {
+            vwap.add (tick.price, tick.quantity);
+        }
+
+        sink = sink + vwap.vwap (Rounding::Mode::DOWN).decimalPlaces ();
+    });
+
+    report ("Vwap::add", nanos, COUNT, BYTES);
+}
+
+static void streamingVwapRead ()
+{
+    const double nanos = bestNanos ([] () {
+        Vwap vwap;
+        uint64_t decimalPlaces = 0;
+
+        for (const auto& tick: ticks ())
+        {
+            vwap.add (tick.price, tick.quantity);
+            decimalPlaces += vwap.vwap (Rounding::Mode::DOWN).decimalPlaces ();
+        }
+
+        sink = sink + decimalPlaces;
+    });
+
+    report ("Vwap::add and vwap () per tick", nanos, COUNT, BYTES);
+}
+
+static void runningVarianceAdd ()
+{
+    const double nanos = bestNanos ([] () {
+        RunningVariance stats;
+
+        for (const auto& tick: ticks ())
+        {
+            stats.add (tick.price);
+        }
+
+        sink = sink + stats.variance (Rounding::Mode::DOWN).decimalPlaces ();
+    });
+
+    report ("RunningVariance::add", nanos, COUNT, BYTES);
+}
+
+std::vector<Bench> StreamingStatsBenchVec = {
+    {numberVwap, "number vwap"},
+    {streamingVwapAdd, "streaming vwap add"},
+    {streamingVwapRead, "streaming vwap read"},
+    {runningVarianceAdd, "running variance add"}
+};
+
+} // namespace bench
+} // namespace fixed
@@ -0,0 +1,108 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_ACCUMULATOR_H
+#define FIXED_ACCUMULATOR_H
+
+#include "fixed/Number.h"
+
+#include <cstdint>
+
+namespace fixed {
+
+//
+// An exact running total of Numbers with differing decimal places.
+//
+// Values are added as integers at MAX_DECIMAL_PLACES to a 192 bit total,
+// so nothing is rescaled or overflow checked along the way, and the total
+// may pass MAX_INTEGER_VALUE as long as it's back in range by the time it
+// is converted to a Number.  The total can't overflow 192 bits in practice,
+// that would take around 2^80 additions of the largest Number.
+//
+// Only toNumber () can throw, a fixed::OverflowException when the total is
+// outside the range of a Number.
+//
+class Accumulator {
+  public:
+    Accumulator () noexcept;
+
+    void add (const Number& number) noexcept;
+
+    void sub (const Number& number) noexcept;
+
+    //
+    // Adds the total of other, as if each of its Numbers had been added.
+    //
+    void merge (const Accumulator& other) noexcept;
+
+    void clear () noexcept;
+
+    bool isZero () const noexcept;
+
+    //
+    // The largest decimal places of the Numbers added, sub () and merge ()
+    // included, or 0 if none have been.
+    //
+    unsigned int decimalPlaces () const noexcept;
+
+    //
+    // The exact total at decimalPlaces (), the same as a loop over
+    // operator+= would give when that doesn't overflow.
+    //
+    Number toNumber () const;
+
+    //
+    // The total rounded to decimalPlaces using roundingMode.
+    //
+    // A fixed::BadValueException will be thrown if the decimalPlaces exceeds
+    // MAX_DECIMAL_PLACES.
+    //
+    Number toNumber (
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    ) const;
+
+  private:
+    friend class ShardedAccumulator;
+
+    void addScaled (const __int128_t value) noexcept;
+
+    //
+    // Sets value and returns true if the total fits in 128 bits.
+    //
+    bool total128 (__int128_t& value) const noexcept;
+
+    //
+    // The total in two's complement, low_ holding the low 128 bits.
+    //
+    __uint128_t low_;
+    int64_t high_;
+
+    uint8_t decimalPlaces_;
+};
+
+} // namespace fixed
+
+#endif // FIXED_ACCUMULATOR_H
@@ -0,0 +1,68 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_ALLOCATE_H
+#define FIXED_ALLOCATE_H
+
+#include "fixed/Number.h"
+#include "fixed/Rounding.h"
+
+#include <cstddef>
+
+namespace fixed {
+
+//
+// Splits total across count legs in proportion to weights, writing each
+// leg's share to out, with total's decimal places.  The shares always add
+// up to exactly total.  out may be weights.
+//
+// Each share is the exact total * weight / sum of weights rounded using
+// roundingMode.  Whatever that leaves over, or takes too much, is then
+// made up a unit in the last place at a time by the largest remainder
+// method: the legs rounded furthest from their exact share in the
+// direction that needs correcting move first, ties going to the earlier
+// leg.  Every share ends up within a unit of its exact value.  To allocate
+// in finer units give total more decimal places.
+//
+// The sum of the weights is prepared once as a Divisor, so each leg costs
+// a few multiplies rather than a division as long as the sum fits in 64
+// bits at the weights' largest decimal places; beyond that legs are worked
+// out in 256 bits to the same result.
+//
+// A fixed::BadValueException is thrown if count is zero, a weight is
+// negative or the weights are all zero, and a fixed::OverflowException if
+// the sum of the weights is beyond 2^127 at their largest decimal places.
+//
+void allocate (
+    const Number& total,
+    const Number* weights,
+    const size_t count,
+    Number* out,
+    const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+);
+
+} // namespace fixed
+
+#endif // FIXED_ALLOCATE_H
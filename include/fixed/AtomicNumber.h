@@ -0,0 +1,119 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_ATOMIC_NUMBER_H
+#define FIXED_ATOMIC_NUMBER_H
+
+#include "fixed/Number.h"
+
+#include <cstdint>
+
+namespace fixed {
+
+//
+// A Number that threads can update concurrently without a lock, for hot
+// shared counters.
+//
+// The value is kept at a fixed number of decimal places, as a single
+// integer of type T updated with compare and swap loops.  AtomicNumber
+// keeps it in a 64 bit word, which covers the counter values of most uses,
+// values up to 92233720368547758.07 at 2 decimal places for example.
+// WideAtomicNumber keeps it in 128 bits, updated with cmpxchg16b, and
+// covers the full range of a Number at any decimal places.
+//
+// Operands are brought to the decimal places of the AtomicNumber first,
+// rounding with its rounding mode, the same way NumberColumn stores them.
+// As with Number::operator+, a result out of range throws a
+// fixed::OverflowException, and the value is left unchanged.
+//
+template <typename T>
+class BasicAtomicNumber {
+  public:
+    explicit BasicAtomicNumber (
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    BasicAtomicNumber (
+        const Number& initial,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    BasicAtomicNumber (const BasicAtomicNumber&) = delete;
+    BasicAtomicNumber& operator= (const BasicAtomicNumber&) = delete;
+
+    unsigned int decimalPlaces () const noexcept;
+
+    Rounding::Mode roundingMode () const noexcept;
+
+    Number load () const;
+
+    void store (const Number& number);
+
+    //
+    // These return the value before the update.
+    //
+    Number exchange (const Number& number);
+
+    Number fetch_add (const Number& number);
+
+    Number fetch_sub (const Number& number);
+
+    //
+    // Sets the value to desired if it equals expected, and returns true.
+    // Otherwise sets expected to the current value and returns false.
+    //
+    bool compare_exchange (Number& expected, const Number& desired);
+
+  private:
+    T toScaled (const Number& number, const char* opName) const;
+
+    Number toNumber (const T value) const;
+
+    Number update (const T delta, const char* opName);
+
+    //
+    // The 16 byte alignment is needed by cmpxchg16b.
+    //
+    alignas (sizeof (T)) mutable T value_;
+
+    //
+    // The largest magnitude allowed, the smaller of what T holds and what a
+    // Number at decimalPlaces_ holds.
+    //
+    const T limit_;
+
+    const uint8_t decimalPlaces_;
+    const Rounding::Mode roundingMode_;
+};
+
+typedef BasicAtomicNumber<int64_t> AtomicNumber;
+
+typedef BasicAtomicNumber<__int128_t> WideAtomicNumber;
+
+} // namespace fixed
+
+#endif // FIXED_ATOMIC_NUMBER_H
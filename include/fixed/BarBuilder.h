@@ -0,0 +1,178 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_BAR_BUILDER_H
+#define FIXED_BAR_BUILDER_H
+
+#include "fixed/Number.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fixed {
+
+//
+// Builds open, high, low, close and volume bars of a fixed interval from
+// ticks for many instruments at once.
+//
+// Each instrument's bar in progress is kept as integers at the builder's
+// fixed price and size decimal places, in a struct of its own cache line,
+// so an update is a few integer comparisons and an addition.  Prices and
+// sizes with more decimal places are rounded on the way in with the
+// builder's Rounding::Mode.
+//
+// A bar covers [start, start + interval), start being a multiple of the
+// interval.  A tick for a later interval completes the instrument's bar in
+// progress, intervals without ticks get no bar.  Completed bars are written
+// to a buffer the caller passes in, nothing is allocated after the
+// constructor.
+//
+// A fixed::BadValueException is thrown for an instrument out of range, a
+// tick for an interval before the bar in progress or one whose interval
+// would start before the smallest int64_t timestamp, and a
+// fixed::OverflowException for a price, size or volume that doesn't fit in
+// 64 bits at the builder's decimal places.  A tick that throws changes
+// nothing.
+//
+class BarBuilder {
+  public:
+    struct Tick {
+        uint32_t instrument;
+        int64_t timestamp;
+        Number price;
+        Number size;
+    };
+
+    struct Bar {
+        uint32_t instrument;
+        int64_t start;
+        uint64_t ticks;
+        Number open;
+        Number high;
+        Number low;
+        Number close;
+        Number volume;
+    };
+
+    //
+    // A fixed::BadValueException will be thrown if instruments or interval
+    // isn't positive, instruments exceeds 2^32 or either decimal places
+    // exceeds MAX_DECIMAL_PLACES.
+    //
+    BarBuilder (
+        const size_t instruments,
+        const int64_t interval,
+        const unsigned int priceDecimalPlaces,
+        const unsigned int sizeDecimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    ~BarBuilder ();
+
+    BarBuilder (const BarBuilder&) = delete;
+    BarBuilder& operator= (const BarBuilder&) = delete;
+
+    //
+    // Adds a tick, writing the bar it completes, if any, to completed.
+    // Returns the number of bars written, 0 or 1.
+    //
+    size_t add (
+        const uint32_t instrument,
+        const int64_t timestamp,
+        const Number& price,
+        const Number& size,
+        Bar* completed
+    );
+
+    //
+    // Adds count ticks in order, writing the bars they complete to
+    // completed, which must have room for count bars.  Returns the number
+    // of bars written.
+    //
+    // Should a tick throw, the ticks before it have been added and the bars
+    // they completed written.
+    //
+    size_t add (const Tick* ticks, const size_t count, Bar* completed);
+
+    //
+    // Completes the bars in progress whose interval has ended by now,
+    // writing them to completed, which must have room for instruments ()
+    // bars.  Returns the number of bars written.
+    //
+    size_t close (const int64_t now, Bar* completed);
+
+    //
+    // Sets bar to the instrument's bar in progress and returns true, or
+    // returns false if it has none.
+    //
+    bool current (const uint32_t instrument, Bar& bar) const;
+
+    size_t instruments () const noexcept;
+
+    int64_t interval () const noexcept;
+
+  private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    //
+    // No ticks means no bar in progress.
+    //
+    struct alignas (CACHE_LINE_SIZE) BarState {
+        int64_t start;
+        int64_t open;
+        int64_t high;
+        int64_t low;
+        int64_t close;
+        int64_t volume;
+        uint64_t ticks;
+    };
+
+    int64_t mantissa (
+        const Number& value,
+        const unsigned int decimalPlaces,
+        const char* what
+    ) const;
+
+    int64_t intervalStart (const int64_t timestamp) const;
+
+    void emit (
+        const uint32_t instrument,
+        const BarState& state,
+        Bar& bar
+    ) const;
+
+    BarState* states_;
+
+    const size_t instruments_;
+    const int64_t interval_;
+
+    const uint8_t priceDecimalPlaces_;
+    const uint8_t sizeDecimalPlaces_;
+    const Rounding::Mode roundingMode_;
+};
+
+} // namespace fixed
+
+#endif // FIXED_BAR_BUILDER_H
@@ -0,0 +1,128 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_COLUMN_MASK_H
+#define FIXED_COLUMN_MASK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fixed {
+
+//
+// One bit per element of a NumberColumn, as produced by the ColumnOps
+// comparison and filter kernels.  Bit idx % 64 of words () [idx / 64] is
+// the bit for element idx, bits past size () are always clear.
+//
+class ColumnMask {
+  public:
+    static constexpr size_t WORD_BITS = 64;
+
+    explicit ColumnMask (const size_t size = 0);
+
+    size_t size () const noexcept;
+
+    bool operator[] (const size_t idx) const noexcept;
+
+    void set (const size_t idx, const bool value) noexcept;
+
+    //
+    // Number of bits set.
+    //
+    size_t count () const noexcept;
+
+    const uint64_t* words () const noexcept;
+
+    uint64_t* words () noexcept;
+
+    size_t wordCount () const noexcept;
+
+  private:
+    size_t size_;
+
+    std::vector<uint64_t> words_;
+};
+
+inline ColumnMask::ColumnMask (const size_t size)
+  : size_ (size),
+    words_ ((size + WORD_BITS - 1) / WORD_BITS, 0)
+{
+}
+
+inline size_t ColumnMask::size () const noexcept
+{
+    return size_;
+}
+
+inline bool ColumnMask::operator[] (const size_t idx) const noexcept
+{
+    return (words_ [idx / WORD_BITS] >> (idx % WORD_BITS)) & 1;
+}
+
+inline void ColumnMask::set (const size_t idx, const bool value) noexcept
+{
+    const uint64_t bit = static_cast<uint64_t> (1) << (idx % WORD_BITS);
+
+    if (value)
+    {
+        words_ [idx / WORD_BITS] |= bit;
+    }
+    else
+    {
+        words_ [idx / WORD_BITS] &= ~bit;
+    }
+}
+
+inline size_t ColumnMask::count () const noexcept
+{
+    size_t bits = 0;
+
+    for (const auto word: words_)
+    {
+        bits += __builtin_popcountll (word);
+    }
+
+    return bits;
+}
+
+inline const uint64_t* ColumnMask::words () const noexcept
+{
+    return words_.data ();
+}
+
+inline uint64_t* ColumnMask::words () noexcept
+{
+    return words_.data ();
+}
+
+inline size_t ColumnMask::wordCount () const noexcept
+{
+    return words_.size ();
+}
+
+} // namespace fixed
+
+#endif // FIXED_COLUMN_MASK_H
@@ -0,0 +1,221 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_COLUMN_OPS_H
+#define FIXED_COLUMN_OPS_H
+
+#include "fixed/ColumnMask.h"
+#include "fixed/NumberColumn.h"
+
+#include <string>
+
+namespace fixed {
+
+//
+// Element-wise operations over NumberColumns.
+//
+// The binary operations require both columns to have the same size and the
+// same decimalPlaces (), a fixed::BadValueException is thrown otherwise.
+//
+// Each operation runs a branch free loop over the 64 bit mantissas that the
+// compiler can vectorise.  Lanes it can't do exactly, because an input is
+// held in the wide value table or the 64 bit result overflowed, are flagged
+// and redone with the scalar Number operators, so results, including any
+// fixed::OverflowException, are the same as applying the Number operators
+// element by element.
+//
+// Result columns take the decimal places and rounding mode of lhs.
+//
+class ColumnOps {
+  public:
+    static NumberColumn add (const NumberColumn& lhs, const NumberColumn& rhs);
+
+    static NumberColumn subtract (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs
+    );
+
+    static NumberColumn min (const NumberColumn& lhs, const NumberColumn& rhs);
+
+    static NumberColumn max (const NumberColumn& lhs, const NumberColumn& rhs);
+
+    static NumberColumn abs (const NumberColumn& column);
+
+    static NumberColumn negate (const NumberColumn& column);
+
+    //
+    // Bit idx of the result is set when the comparison holds between
+    // lhs [idx] and rhs [idx].
+    //
+    static ColumnMask equal (const NumberColumn& lhs, const NumberColumn& rhs);
+
+    static ColumnMask notEqual (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs
+    );
+
+    static ColumnMask lessThan (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs
+    );
+
+    static ColumnMask lessThanOrEqual (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs
+    );
+
+    static ColumnMask greaterThan (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs
+    );
+
+    static ColumnMask greaterThanOrEqual (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs
+    );
+
+    //
+    // Filters against a single threshold, bit idx of the result is set when
+    // the comparison holds between column [idx] and threshold.
+    //
+    // The threshold is converted to the column scale once, and need not be
+    // representable there, e.g. 1.2345 against a 2 decimal place column
+    // still compares exactly, 1.23 being less than it and 1.24 not.
+    //
+    static ColumnMask equal (
+        const NumberColumn& column,
+        const Number& threshold
+    );
+
+    static ColumnMask notEqual (
+        const NumberColumn& column,
+        const Number& threshold
+    );
+
+    static ColumnMask lessThan (
+        const NumberColumn& column,
+        const Number& threshold
+    );
+
+    static ColumnMask lessThanOrEqual (
+        const NumberColumn& column,
+        const Number& threshold
+    );
+
+    static ColumnMask greaterThan (
+        const NumberColumn& column,
+        const Number& threshold
+    );
+
+    static ColumnMask greaterThanOrEqual (
+        const NumberColumn& column,
+        const Number& threshold
+    );
+
+    //
+    // Bit idx of the result is set when low <= column [idx] <= high, none
+    // are set if low > high.
+    //
+    static ColumnMask between (
+        const NumberColumn& column,
+        const Number& low,
+        const Number& high
+    );
+
+    //
+    // Returns the column converted to decimalPlaces, each value identical to
+    // what Number::setDecimalPlaces () gives with the rounding mode used.
+    // The result keeps the rounding mode of the column.
+    //
+    // A fixed::BadValueException will be thrown if decimalPlaces exceeds
+    // Number::MAX_DECIMAL_PLACES.
+    //
+    static NumberColumn rescale (
+        const NumberColumn& column,
+        const unsigned int decimalPlaces
+    );
+
+    static NumberColumn rescale (
+        const NumberColumn& column,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    );
+
+  private:
+    //
+    // Returns the threshold multiplied by 10^decimalPlaces and rounded down,
+    // exact is set to whether that involved no rounding.
+    //
+    static __int128_t floorToScale (
+        const Number& threshold,
+        const unsigned int decimalPlaces,
+        bool& exact
+    );
+
+    //
+    // Sets the bits for elements whose scaled values lie in [low, high], or
+    // outside it when invert is set.
+    //
+    static ColumnMask inRange (
+        const NumberColumn& column,
+        const __int128_t low,
+        const __int128_t high,
+        const bool invert
+    );
+
+    static void checkCompatible (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs,
+        const std::string& opName
+    );
+
+    template <typename Op>
+    static NumberColumn addSub (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs,
+        const std::string& opName
+    );
+
+    template <typename Op>
+    static NumberColumn select (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs,
+        const std::string& opName
+    );
+
+    template <typename Op>
+    static NumberColumn unary (const NumberColumn& column);
+
+    template <typename Compare>
+    static ColumnMask compare (
+        const NumberColumn& lhs,
+        const NumberColumn& rhs,
+        const std::string& opName
+    );
+};
+
+} // namespace fixed
+
+#endif // FIXED_COLUMN_OPS_H
@@ -0,0 +1,96 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_CPU_DISPATCH_H
+#define FIXED_CPU_DISPATCH_H
+
+#include <cstdint>
+#include <string>
+
+namespace fixed {
+
+//
+// Chooses which build of the batch kernels behind ColumnOps and Reductions
+// is used.  The library itself is built for the x86-64 baseline, the
+// kernels are additionally compiled for each of the tiers below and the
+// best one the CPU supports is picked at run time.
+//
+class CpuDispatch {
+  public:
+    enum class Tier : uint8_t {
+        //
+        // The flags the library was built with.
+        //
+        BASELINE = 0,
+
+        //
+        // Requires SSE4.2 and POPCNT.
+        //
+        SSE4_2,
+
+        //
+        // Requires AVX2, BMI1 and BMI2, as well as SSE4_2's.
+        //
+        AVX2,
+
+        //
+        // Requires AVX-512 F, DQ, BW and VL, as well as AVX2's.
+        //
+        AVX512,
+
+        TIER_MAX_VAL // DO NOT PUT ANY MORE ENUMS AFTER THIS
+    };
+
+    //
+    // The tier in use.  On first use this is set to supportedTier (), or to
+    // the tier named by the FIXED_CPU_TIER environment variable if that is
+    // lower, which is handy for benchmarking the tiers against each other.
+    // The names are those returned by tierToString (), unrecognised ones are
+    // ignored.
+    //
+    static Tier tier () noexcept;
+
+    //
+    // The best tier the CPU and operating system support.
+    //
+    static Tier supportedTier () noexcept;
+
+    //
+    // Changes the tier in use, mainly for testing.  A fixed::BadValueException
+    // is thrown if it is higher than supportedTier ().
+    //
+    static void setTier (const Tier tier);
+
+    static const std::string& tierToString (const Tier tier);
+
+    //
+    // Sets tier and returns true if str is one of the tierToString () names.
+    //
+    static bool stringToTier (const std::string& str, Tier& tier) noexcept;
+};
+
+} // namespace fixed
+
+#endif // FIXED_CPU_DISPATCH_H
@@ -0,0 +1,204 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_CROSS_RATES_H
+#define FIXED_CROSS_RATES_H
+
+#include "fixed/Divisor.h"
+#include "fixed/Int256.h"
+#include "fixed/Number.h"
+#include "fixed/NumberColumn.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fixed {
+
+//
+// Converts amounts between currencies quoted against a common pivot
+// currency, USD say, with the cross rate of every pair kept ready.
+//
+// Each currency's rate is held exactly as the fraction its quote gives,
+// whichever way round it is quoted, and the matrix holds for every pair
+// the numerator of the cross rate through the pivot and a Divisor for its
+// denominator.  A conversion is then one multiply and one division by a
+// prepared divisor, rounded once, giving the exact triangulated value
+// rounded where chaining Number operators would round at each step and
+// work out inverse rates with operator/.  Setting a rate refreshes only its
+// row and column of the matrix.
+//
+// Currencies are numbered from 0 to currencies () - 1, the pivot having a
+// rate of 1.  A fixed::BadValueException is thrown for a currency out of
+// range or one with no rate set, and a fixed::OverflowException if a
+// result is outside the range of a Number.
+//
+class CrossRates {
+  public:
+    enum class Quote {
+        //
+        // Pivot per unit of the currency, as EUR/USD at 1.0850.
+        //
+        PIVOT_PER_UNIT,
+
+        //
+        // Units of the currency per unit of the pivot, as USD/JPY at 149.50.
+        //
+        UNITS_PER_PIVOT
+    };
+
+    //
+    // The matrix grows with the square of the number of currencies.
+    //
+    static constexpr size_t MAX_CURRENCIES = 1024;
+
+    //
+    // A fixed::BadValueException will be thrown if currencies isn't
+    // positive or exceeds MAX_CURRENCIES, or the pivot is out of range.
+    //
+    CrossRates (const size_t currencies, const uint32_t pivot);
+
+    size_t currencies () const noexcept;
+
+    uint32_t pivot () const noexcept;
+
+    bool hasRate (const uint32_t currency) const;
+
+    //
+    // Sets the currency's rate against the pivot, which must be positive.
+    // The pivot's own rate can't be set.
+    //
+    void setRate (
+        const uint32_t currency,
+        const Number& rate,
+        const Quote quote = Quote::PIVOT_PER_UNIT
+    );
+
+    //
+    // Units of to per unit of from.
+    //
+    Number rate (
+        const uint32_t from,
+        const uint32_t to,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    ) const;
+
+    Number convert (
+        const Number& amount,
+        const uint32_t from,
+        const uint32_t to,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    ) const;
+
+    //
+    // Converts each of the amounts, in a column with decimalPlaces and
+    // roundingMode, the same as convert () on each would.
+    //
+    NumberColumn convert (
+        const NumberColumn& amounts,
+        const uint32_t from,
+        const uint32_t to,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    ) const;
+
+    //
+    // As above with each amount in its own currency, from [idx].
+    //
+    // A fixed::BadValueException will be thrown if from isn't the same size
+    // as amounts.
+    //
+    NumberColumn convert (
+        const NumberColumn& amounts,
+        const std::vector<uint32_t>& from,
+        const uint32_t to,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    ) const;
+
+  private:
+    //
+    // One unit of a currency in the pivot, numerator / denominator.
+    //
+    struct Rate {
+        __int128_t numerator;
+        __int128_t denominator;
+        bool isSet;
+    };
+
+    //
+    // The cross rate of a pair, numerator / denominator.
+    //
+    struct Entry {
+        Int256 numerator;
+        Divisor denominator;
+    };
+
+    //
+    // An entry's cross rate rescaled from one number of decimal places to
+    // another, with the numerator kept narrow too when it fits in 64 bits,
+    // zero otherwise.
+    //
+    struct Conversion {
+        Int256 numerator;
+        uint64_t narrowNumerator;
+        Divisor denominator;
+    };
+
+    void checkCurrency (const uint32_t currency, const char* function) const;
+
+    const Entry& entry (const uint32_t from, const uint32_t to) const noexcept;
+
+    void refresh (const uint32_t from, const uint32_t to);
+
+    Conversion conversion (
+        const Entry& entry,
+        const unsigned int fromDecimalPlaces,
+        const unsigned int toDecimalPlaces
+    ) const;
+
+    static __int128_t convertScaled (
+        const __int128_t amount,
+        const Conversion& conversion,
+        const Rounding::Mode roundingMode
+    );
+
+    static void pushBack (NumberColumn& result, const __int128_t value);
+
+    std::vector<Rate> rates_;
+
+    //
+    // currencies () by currencies (), from by row and to by column.
+    //
+    std::vector<Entry> entries_;
+
+    uint32_t pivot_;
+};
+
+} // namespace fixed
+
+#endif // FIXED_CROSS_RATES_H
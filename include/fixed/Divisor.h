@@ -0,0 +1,240 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_DIVISOR_H
+#define FIXED_DIVISOR_H
+
+#include "fixed/Int256.h"
+#include "fixed/Rounding.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace fixed {
+
+//
+// A positive integer prepared once for dividing many numerators by it.
+//
+// When the divisor fits in 64 bits the constructor works out its
+// reciprocal, and divideRounded () then takes a few multiplies in place of
+// a divide instruction, using the 2 by 1 division of Moller and Granlund,
+// "Improved division by invariant integers".  Wider divisors are left to
+// Int256::divideRounded () with value ().
+//
+class Divisor {
+  public:
+    //
+    // A divisor of 1.
+    //
+    Divisor () noexcept;
+
+    //
+    // A fixed::BadValueException will be thrown if value isn't positive.
+    //
+    explicit Divisor (const Int256& value);
+
+    const Int256& value () const noexcept;
+
+    //
+    // Whether the divisor fits in 64 bits, so divideRounded () can be used.
+    //
+    bool isNarrow () const noexcept;
+
+    //
+    // Sets result to magnitude / value (), negative when negative is set,
+    // rounded using roundingMode, the same as Int256::divideRounded ()
+    // gives.  Returns false, leaving result alone, if the quotient is 2^126
+    // or more, far outside the range of a Number.
+    //
+    // Only for narrow divisors.
+    //
+    bool divideRounded (
+        const __uint128_t magnitude,
+        const bool negative,
+        const Rounding::Mode roundingMode,
+        __int128_t& result
+    ) const;
+
+    //
+    // The same for a signed numerator.
+    //
+    bool divideRounded (
+        const __int128_t numerator,
+        const Rounding::Mode roundingMode,
+        __int128_t& result
+    ) const;
+
+    //
+    // Whether value fits in 64 bits, two such values multiplying within 128
+    // bits for divideRounded ().
+    //
+    static bool fitsInt64 (const __int128_t value) noexcept;
+
+  private:
+    //
+    // high:low / normalized_ when high is below it, so the quotient fits
+    // in 64 bits.
+    //
+    uint64_t divideStep (
+        const uint64_t high,
+        const uint64_t low,
+        uint64_t& remainder
+    ) const noexcept;
+
+    Int256 value_;
+
+    //
+    // The divisor shifted left until its top bit is set, and its
+    // reciprocal (2^128 - 1) / normalized_ - 2^64, rounded down.  Both are
+    // zero when the divisor doesn't fit in 64 bits.
+    //
+    uint64_t normalized_;
+    uint64_t reciprocal_;
+    unsigned int shift_;
+};
+
+inline bool Divisor::isNarrow () const noexcept
+{
+    return normalized_;
+}
+
+inline uint64_t Divisor::divideStep (
+    const uint64_t high,
+    const uint64_t low,
+    uint64_t& remainder
+) const noexcept
+{
+    const __uint128_t estimate =
+        static_cast<__uint128_t> (reciprocal_) * high +
+        (static_cast<__uint128_t> (high) << 64 | low);
+
+    uint64_t quotient = static_cast<uint64_t> (estimate >> 64) + 1;
+
+    remainder = low - quotient * normalized_;
+
+    if (remainder > static_cast<uint64_t> (estimate))
+    {
+        --quotient;
+        remainder += normalized_;
+    }
+
+    if (remainder >= normalized_)
+    {
+        ++quotient;
+        remainder -= normalized_;
+    }
+
+    return quotient;
+}
+
+inline bool Divisor::divideRounded (
+    const __uint128_t magnitude,
+    const bool negative,
+    const Rounding::Mode roundingMode,
+    __int128_t& result
+) const
+{
+    const uint64_t high = static_cast<uint64_t> (magnitude >> 64);
+    const uint64_t low = static_cast<uint64_t> (magnitude);
+
+    //
+    // The numerator shifted along with the divisor, in three words, the
+    // top one being below the normalized divisor.
+    //
+    const uint64_t top = shift_ ? high >> (64 - shift_) : 0;
+    const uint64_t middle =
+        shift_ ? high << shift_ | low >> (64 - shift_) : high;
+
+    uint64_t remainder = 0;
+
+    const uint64_t quotientHigh = divideStep (top, middle, remainder);
+
+    if (quotientHigh >> 62)
+    {
+        return false;
+    }
+
+    const uint64_t quotientLow =
+        divideStep (remainder, low << shift_, remainder);
+
+    remainder >>= shift_;
+
+    //
+    // Twice the remainder against the divisor, without overflowing, mapped
+    // on to 1, 2 or 3 against a half range of 2 as Int256 does.
+    //
+    const uint64_t divisor = normalized_ >> shift_;
+
+    __int128_t fraction = 0;
+
+    if (remainder)
+    {
+        fraction = remainder < divisor - remainder ?
+                   1 :
+                   remainder == divisor - remainder ? 2 : 3;
+    }
+
+    const __int128_t truncated = static_cast<__int128_t> (
+        static_cast<__uint128_t> (quotientHigh) << 64 | quotientLow
+    );
+
+    const bool isNegative = negative && magnitude;
+
+    result = Rounding::round<__int128_t> (
+        roundingMode,
+        isNegative ? -truncated : truncated,
+        fraction,
+        2,
+        isNegative
+    );
+
+    return true;
+}
+
+inline bool Divisor::divideRounded (
+    const __int128_t numerator,
+    const Rounding::Mode roundingMode,
+    __int128_t& result
+) const
+{
+    return divideRounded (
+        numerator < 0 ?
+            -static_cast<__uint128_t> (numerator) :
+            static_cast<__uint128_t> (numerator),
+        numerator < 0,
+        roundingMode,
+        result
+    );
+}
+
+inline bool Divisor::fitsInt64 (const __int128_t value) noexcept
+{
+    return value >= std::numeric_limits<int64_t>::min () &&
+           value <= std::numeric_limits<int64_t>::max ();
+}
+
+} // namespace fixed
+
+#endif // FIXED_DIVISOR_H
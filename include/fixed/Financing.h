@@ -0,0 +1,133 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_FINANCING_H
+#define FIXED_FINANCING_H
+
+#include "fixed/Divisor.h"
+#include "fixed/Number.h"
+#include "fixed/NumberColumn.h"
+#include "fixed/ThreadPool.h"
+
+#include <cstdint>
+
+namespace fixed {
+
+//
+// Financing accrued on positions over a number of days,
+//
+//     units * price * rate * days / basis
+//
+// basis being the day count convention's days in a year, 360 or 365 say.
+//
+// The product is formed exactly from the scaled integers of the inputs and
+// divided by basis, rescaled to decimalPlaces, once, so the result is
+// rounded once using the Rounding::Mode given.  Chaining the same
+// arithmetic through Number operators rounds each step instead.  A Divisor
+// for each scale the inputs can add up to is prepared by the constructor,
+// so the common case of a product within 128 bits costs a few multiplies
+// rather than a division.  Anything larger is worked out in 256 bits to the
+// same result.
+//
+// The batch accrue () runs over columns of positions in chunks of
+// parallel::CHUNK_SIZE on a ThreadPool.  Each result depends only on its
+// own inputs, so it is the same as the scalar accrue () on each row
+// whatever the number of threads.
+//
+// A fixed::OverflowException is thrown if a result, or the product on the
+// way to it, is outside the range of a Number.
+//
+class Financing {
+  public:
+    //
+    // A fixed::BadValueException will be thrown if basis is zero or
+    // decimalPlaces exceeds MAX_DECIMAL_PLACES.
+    //
+    Financing (
+        const unsigned int basis,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    unsigned int basis () const noexcept;
+
+    unsigned int decimalPlaces () const noexcept;
+
+    Rounding::Mode roundingMode () const noexcept;
+
+    Number accrue (
+        const Number& units,
+        const Number& price,
+        const Number& rate,
+        const unsigned int days
+    ) const;
+
+    //
+    // The financing of each row of the columns, in a column with
+    // decimalPlaces () and roundingMode ().  The columns can each have
+    // their own decimal places.
+    //
+    // A fixed::BadValueException will be thrown if the columns differ in
+    // size.
+    //
+    NumberColumn accrue (
+        const NumberColumn& units,
+        const NumberColumn& prices,
+        const NumberColumn& rates,
+        const unsigned int days,
+        ThreadPool& pool = ThreadPool::shared ()
+    ) const;
+
+  private:
+    //
+    // For inputs whose decimal places add up to scale, the divisor basis *
+    // 10^(scale - decimalPlaces), or basis with the product multiplied by
+    // 10^(decimalPlaces - scale) when that is negative.
+    //
+    struct Scale {
+        Divisor divisor;
+        uint64_t multiplier;
+    };
+
+    static constexpr unsigned int SCALES = 3 * Number::MAX_DECIMAL_PLACES + 1;
+
+    __int128_t accrueScaled (
+        const __int128_t units,
+        const __int128_t price,
+        const __int128_t rate,
+        const unsigned int days,
+        const Scale& scale
+    ) const;
+
+    Scale scales_ [SCALES];
+
+    unsigned int basis_;
+    unsigned int decimalPlaces_;
+    Rounding::Mode roundingMode_;
+};
+
+} // namespace fixed
+
+#endif // FIXED_FINANCING_H
@@ -0,0 +1,102 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_INT256_H
+#define FIXED_INT256_H
+
+#include "fixed/Rounding.h"
+
+#include <cstdint>
+
+namespace fixed {
+
+//
+// A 256 bit two's complement integer, for exact intermediate results too
+// wide for __int128_t, such as sums of products of 128 bit scaled values.
+//
+// Arithmetic that overflows 256 bits throws a fixed::OverflowException.
+//
+class Int256 {
+  public:
+    Int256 () noexcept;
+
+    Int256 (const __int128_t value) noexcept;
+
+    //
+    // The 192 bit two's complement value high * 2^128 + low.
+    //
+    Int256 (const int64_t high, const __uint128_t low) noexcept;
+
+    //
+    // The exact product, which can't overflow.
+    //
+    static Int256 multiply (
+        const __int128_t lhs,
+        const __int128_t rhs
+    ) noexcept;
+
+    Int256& operator+= (const Int256& rhs);
+    Int256& operator-= (const Int256& rhs);
+    Int256& operator*= (const Int256& rhs);
+
+    bool isNegative () const noexcept;
+    bool isZero () const noexcept;
+
+    //
+    // Sets value and returns true if the value fits in 128 bits.
+    //
+    bool toInt128 (__int128_t& value) const noexcept;
+
+    //
+    // numerator / denominator rounded to an integer using roundingMode.
+    //
+    // A fixed::DivideByZeroException will be thrown if the denominator is
+    // zero, and a fixed::OverflowException if the result doesn't fit in 128
+    // bits.
+    //
+    static __int128_t divideRounded (
+        const Int256& numerator,
+        const Int256& denominator,
+        const Rounding::Mode roundingMode
+    );
+
+    friend bool operator== (const Int256& lhs, const Int256& rhs) noexcept;
+    friend bool operator< (const Int256& lhs, const Int256& rhs) noexcept;
+
+  private:
+    static constexpr unsigned int WORDS = 4;
+
+    //
+    // Least significant word first.
+    //
+    uint64_t words_ [WORDS];
+};
+
+bool operator== (const Int256& lhs, const Int256& rhs) noexcept;
+bool operator< (const Int256& lhs, const Int256& rhs) noexcept;
+
+} // namespace fixed
+
+#endif // FIXED_INT256_H
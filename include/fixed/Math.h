@@ -0,0 +1,138 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include "fixed/Number.h"
+#include "fixed/Rounding.h"
+
+#include <type_traits>
+
+namespace fixed {
+
+//
+// Elementary functions computed on the scaled integer of a Number, without
+// a round trip through double.  Each returns a Number with decimalPlaces,
+// rounded once using the Rounding::Mode passed in.
+//
+// sqrt () is exact, the integer square root of the value rescaled to twice
+// decimalPlaces, so it rounds correctly in every mode.
+//
+// exp (), log () and pow () are evaluated in 128 bit binary fixed point,
+// after reducing the argument to a small range with tables built on first
+// use, to a relative error of around 2^-110, growing with the magnitude of
+// the exponent for pow ().  A result within 2^-104 of a rounding boundary,
+// relative to its size, and within 2^-16 of the last place, is taken to be
+// on it.  That makes exact powers such as pow (4, 0.5) or pow (1.1, 2)
+// round as the exact value would in every mode, as long as the result has
+// no more than around 30 significant digits; past that the last place can
+// be out by one either way.
+//
+// A fixed::BadValueException is thrown if decimalPlaces exceeds
+// MAX_DECIMAL_PLACES or the value is outside the domain of the function,
+// and a fixed::OverflowException if the result is outside the range of a
+// Number.  Results too small to represent round to zero, or to the
+// smallest Number at decimalPlaces when the mode rounds away from zero.
+//
+
+//
+// Throws a fixed::BadValueException if value is negative.
+//
+Number sqrt (
+    const Number& value,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+);
+
+Number exp (
+    const Number& value,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+);
+
+//
+// The natural logarithm, throws a fixed::BadValueException unless value is
+// positive.
+//
+Number log (
+    const Number& value,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+);
+
+//
+// base raised to exponent, exp (exponent * log (base)), or as the overload
+// below for whole exponents from 0 up.
+//
+// pow (x, 0) is 1 for any x, including 0.  A negative base is only allowed
+// with an integer exponent, a fixed::BadValueException is thrown
+// otherwise, and 0 raised to a negative exponent throws a
+// fixed::DivideByZeroException.
+//
+Number pow (
+    const Number& base,
+    const Number& exponent,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+);
+
+//
+// base raised to a whole exponent by repeated squaring, around
+// 2 * log2 (exponent) multiplications, such as a compounding factor
+// (1 + rate)^days.  It rounds once, so unlike a loop of operator*= the
+// result doesn't depend on how the multiplications are arranged.
+//
+// Powers whose scaled integer fits in 128 bits are rounded exactly.  Larger
+// ones are carried in 128 bit binary fixed point, to a relative error
+// of around 2^-120 times the exponent, and rounded as exp () is.
+//
+Number pow (
+    const Number& base,
+    const unsigned int exponent,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+);
+
+//
+// As Number's constructors are explicit, a signed or floating point exponent
+// would otherwise convert to unsigned int and pick the overload above, so
+// pow (x, 0.5, ...) gave x^0 and pow (x, -1, ...) gave x^4294967295.  Pass
+// a Number for those.
+//
+template <
+    typename T,
+    typename = typename std::enable_if<std::is_signed<T>::value>::type
+>
+Number pow (
+    const Number& base,
+    const T exponent,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) = delete;
+
+} // namespace fixed
+
+#endif // FIXED_MATH_H
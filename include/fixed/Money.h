@@ -0,0 +1,296 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_MONEY_H
+#define FIXED_MONEY_H
+
+#include "fixed/Exceptions.h"
+#include "fixed/Number.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace fixed {
+
+//
+// Currencies by their ISO 4217 numeric code, with the decimal places of
+// each one's minor unit looked up from a static table.
+//
+struct Currency {
+    enum : uint16_t {
+        AUD = 36,
+        BHD = 48,
+        CAD = 124,
+        CHF = 756,
+        CNY = 156,
+        EUR = 978,
+        GBP = 826,
+        HKD = 344,
+        JPY = 392,
+        KWD = 414,
+        NZD = 554,
+        USD = 840,
+        XXX = 999
+    };
+
+    //
+    // Whether the code is in the table.
+    //
+    static bool isKnown (const uint16_t currency) noexcept;
+
+    //
+    // The decimal places of the currency's minor unit, 2 for USD, 0 for JPY
+    // and 3 for BHD.  XXX, no currency, has 0.
+    //
+    // A fixed::BadValueException will be thrown for a currency not in the
+    // table, here and wherever Money is given one.
+    //
+    static unsigned int decimalPlaces (const uint16_t currency);
+
+    //
+    // The three letter code and back again.
+    //
+    static std::string code (const uint16_t currency);
+
+    static uint16_t fromCode (const std::string& code);
+};
+
+//
+// An amount of money in a currency, held as an integer count of the
+// currency's minor unit, cents for USD, next to its currency code.
+//
+// The scale always comes from the currency, so adding and subtracting
+// amounts of the same currency is integer arithmetic, no rescaling or
+// rounding involved.  Mixing currencies throws a fixed::BadValueException,
+// amounts only cross currencies through convert () at an exchange rate,
+// rounded once to the new currency's minor unit.  A result beyond the
+// range of the int64_t count throws a fixed::OverflowException.
+//
+class Money {
+  public:
+    //
+    // Zero of XXX, no currency.
+    //
+    Money () noexcept;
+
+    //
+    // amount rounded to the currency's minor unit using roundingMode.
+    //
+    // A fixed::OverflowException will be thrown if the count of minor
+    // units doesn't fit.
+    //
+    Money (
+        const Number& amount,
+        const uint16_t currency,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    //
+    // A fixed::BadValueException will be thrown if minorUnits is int64_t
+    // min, which has no negation.
+    //
+    static Money fromMinorUnits (
+        const int64_t minorUnits,
+        const uint16_t currency
+    );
+
+    int64_t minorUnits () const noexcept;
+
+    uint16_t currency () const noexcept;
+
+    unsigned int decimalPlaces () const;
+
+    //
+    // The amount as a Number with the currency's decimal places.
+    //
+    Number amount () const;
+
+    //
+    // The amount followed by the currency code, "1234.50 USD".
+    //
+    std::string toString () const;
+
+    bool isZero () const noexcept;
+
+    Money& operator+= (const Money& rhs);
+    Money& operator-= (const Money& rhs);
+
+    const Money operator- () const noexcept;
+
+    //
+    // The amount in another currency at rate units of it per unit of this
+    // one, rounded once to its minor unit using roundingMode.
+    //
+    // A fixed::BadValueException will be thrown if rate isn't positive or
+    // currency is unknown, and a fixed::OverflowException if the result
+    // doesn't fit.
+    //
+    Money convert (
+        const uint16_t currency,
+        const Number& rate,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    ) const;
+
+  private:
+    Money (const int64_t minorUnits, const uint16_t currency) noexcept;
+
+    void checkCurrency (const Money& rhs, const char* function) const;
+
+    static void tooLarge (const char* function);
+
+    int64_t minorUnits_;
+    uint16_t currency_;
+};
+
+static_assert (sizeof (Money) <= 16, "Money should fit in 16 bytes");
+
+const Money operator+ (const Money& lhs, const Money& rhs);
+const Money operator- (const Money& lhs, const Money& rhs);
+
+//
+// Amounts of different currencies are never equal.  The ordering throws a
+// fixed::BadValueException when the currencies differ.
+//
+bool operator== (const Money& lhs, const Money& rhs) noexcept;
+bool operator!= (const Money& lhs, const Money& rhs) noexcept;
+bool operator<  (const Money& lhs, const Money& rhs);
+bool operator<= (const Money& lhs, const Money& rhs);
+bool operator>  (const Money& lhs, const Money& rhs);
+bool operator>= (const Money& lhs, const Money& rhs);
+
+inline Money::Money (
+    const int64_t minorUnits,
+    const uint16_t currency
+) noexcept
+  : minorUnits_ (minorUnits),
+    currency_ (currency)
+{
+}
+
+inline Money::Money () noexcept
+  : Money (0, Currency::XXX)
+{
+}
+
+inline int64_t Money::minorUnits () const noexcept
+{
+    return minorUnits_;
+}
+
+inline uint16_t Money::currency () const noexcept
+{
+    return currency_;
+}
+
+inline bool Money::isZero () const noexcept
+{
+    return ! minorUnits_;
+}
+
+inline Money& Money::operator+= (const Money& rhs)
+{
+    checkCurrency (rhs, "Money::operator+=");
+
+    int64_t sum = 0;
+
+    if (__builtin_add_overflow (minorUnits_, rhs.minorUnits_, &sum) ||
+        sum == std::numeric_limits<int64_t>::min ())
+    {
+        tooLarge ("Money::operator+=");
+    }
+
+    minorUnits_ = sum;
+
+    return *this;
+}
+
+inline Money& Money::operator-= (const Money& rhs)
+{
+    checkCurrency (rhs, "Money::operator-=");
+
+    int64_t difference = 0;
+
+    if (__builtin_sub_overflow (minorUnits_, rhs.minorUnits_, &difference) ||
+        difference == std::numeric_limits<int64_t>::min ())
+    {
+        tooLarge ("Money::operator-=");
+    }
+
+    minorUnits_ = difference;
+
+    return *this;
+}
+
+inline const Money Money::operator- () const noexcept
+{
+    return Money (-minorUnits_, currency_);
+}
+
+inline void Money::checkCurrency (
+    const Money& rhs,
+    const char* function
+) const
+{
+    if (currency_ != rhs.currency_)
+    {
+        throw fixed::BadValueException (
+            std::string (function) + " () Currency mismatch"
+        );
+    }
+}
+
+inline const Money operator+ (const Money& lhs, const Money& rhs)
+{
+    Money result (lhs);
+
+    result += rhs;
+
+    return result;
+}
+
+inline const Money operator- (const Money& lhs, const Money& rhs)
+{
+    Money result (lhs);
+
+    result -= rhs;
+
+    return result;
+}
+
+inline bool operator== (const Money& lhs, const Money& rhs) noexcept
+{
+    return lhs.currency () == rhs.currency () &&
+           lhs.minorUnits () == rhs.minorUnits ();
+}
+
+inline bool operator!= (const Money& lhs, const Money& rhs) noexcept
+{
+    return ! (lhs == rhs);
+}
+
+} // namespace fixed
+
+#endif // FIXED_MONEY_H
@@ -35,6 +35,7 @@
 
 #include <cstdint>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <iomanip>
 #include <limits>
@@ -133,17 +134,25 @@ class Number {
     // when possible as it provides more accuracy for the Number
     // representation.
     //
+    // The value is first converted to the shortest decimal, with at most
+    // MAX_DECIMAL_PLACES, that converts back to exactly the same floating
+    // point value, e.g. 0.1 becomes 0.1 and not 0.09999999999999.  If no such
+    // decimal exists the exact binary value is rounded to MAX_DECIMAL_PLACES
+    // using the roundingMode.
+    //
     // If the desired decimalPlaces are not specified, then the min decimal
     // places required to accurately store the number will be used.  This means
     // any excess 0's at the end of the number will be trimmed if possible.
     // However if decimalPlaces is provided that will be the decimal places in
-    // use.  If a decimalPlaces larger than MAX_DECIMAL_PLACES is passed in
-    // this is considered the same as not specifying the desired decimal places
-    // and then the min decimal places required will be used.
+    // use, rounding the shortest decimal with roundingMode if needed.  If a
+    // decimalPlaces larger than MAX_DECIMAL_PLACES is passed in this is
+    // considered the same as not specifying the desired decimal places and
+    // then the min decimal places required will be used.
     //
     //
     // NOTE: Numbers that are smaller than our minimum representable value
-    //       will simply result in a Number of 0.  The method isZero () can
+    //       will simply be rounded to MAX_DECIMAL_PLACES, under most rounding
+    //       modes this results in a Number of 0.  The method isZero () can
     //       be queried to check for this after the fact.
     //
     // A fixed::BadValueException will be thrown in the following cases:
@@ -179,6 +188,15 @@ class Number {
     // -0.01
     // 1.23456
     //
+    // A decimal exponent may follow the value, it is folded into the decimal
+    // places exactly, no floating point conversion is involved.  The exponent
+    // must not cause more than MAX_DECIMAL_PLACES decimal places to be
+    // required, nor the integer value to exceed MAX_INTEGER_VALUE.
+    //
+    // 1.5e-5    is the Number 0.000015
+    // 2E+3      is the Number 2000
+    // 1.250e2   is the Number 125.0
+    //
     explicit Number (const std::string& numberStr);
     explicit Number (const char* c_str);
 
@@ -332,6 +350,31 @@ class Number {
     //
     bool value64Set () const noexcept;
 
+    //
+    // Returns the Number as an integer scaled by 10^decimalPlaces (), the
+    // sign included.
+    //
+    // Examples:
+    //   Returns 1234 for the Number 12.34
+    //   Returns -5 for the Number -0.05
+    //   Returns 100 for the Number 1.00
+    //
+    __int128_t scaledValue () const noexcept;
+
+    //
+    // A 'named' constructor, the inverse of scaledValue (), the Number
+    // created has the value scaledValue / 10^decimalPlaces.
+    //
+    // A fixed::BadValueException will be thrown in the following cases:
+    //   - The decimalPlaces passed in exceeds MAX_DECIMAL_PLACES.
+    //   - The magnitude of the resulting integer value would exceed
+    //     MAX_INTEGER_VALUE.
+    //
+    static Number fromScaledValue (
+        const __int128_t scaledValue,
+        const unsigned int decimalPlaces
+    );
+
     //
     // Modifies the number of decimal places used by the Number.  In the
     // event the number of decimal places is being reduced the current
@@ -343,6 +386,52 @@ class Number {
     //
     void setDecimalPlaces (unsigned int targetDecimalPlaces);
 
+    //
+    // Applies setDecimalPlaces (targetDecimalPlaces) to count Numbers in
+    // place, rounding with roundingMode rather than each Number's own
+    // rounding mode, which is left as it was.  The results are the same as
+    // the loop would give, but the common 64 bit case doesn't go through the
+    // std::function dispatch in Rounding or a runtime division.
+    //
+    static void setDecimalPlaces (
+        Number* numbers,
+        const size_t count,
+        const unsigned int targetDecimalPlaces,
+        const Rounding::Mode roundingMode
+    );
+
+    //
+    // The number of bytes written by encodeKey ().
+    //
+    static constexpr size_t KEY_SIZE = 16;
+
+    //
+    // Writes KEY_SIZE bytes to out that identify the value of the Number, for
+    // use as a key in ordered indexes.  Comparing two keys with memcmp gives
+    // the same order as comparing the Numbers, and equal values give equal
+    // keys whatever their decimal places, so 1.5 and 1.50 encode the same.
+    //
+    // The key is the value at MAX_DECIMAL_PLACES, big endian, with the sign
+    // bit flipped so negative values sort first.
+    //
+    void encodeKey (uint8_t* out) const noexcept;
+
+    //
+    // The inverse of encodeKey (), the Number returned has as few decimal
+    // places as represent the value exactly, so 1.50 decodes as 1.5.
+    //
+    // A fixed::BadValueException will be thrown if the key is outside the
+    // range of a Number, which encodeKey () never produces.
+    //
+    static Number decodeKey (const uint8_t* key);
+
+    //
+    // A hash of the value, Numbers that compare equal with operator== have
+    // equal hashes whatever their decimal places or internal width.  Used by
+    // the std::hash<fixed::Number> specialisation.
+    //
+    size_t hash () const noexcept;
+
     //
     // The +=, -=, *= and =/ operators can throw fixed::OverflowException.
     //
@@ -391,11 +480,23 @@ class Number {
     static Number negate (const Number& n) noexcept;
 
     //
-    // Return the number represented as a double and long double respectively
+    // Return the number represented as a double and long double respectively,
+    // the result is correctly rounded, ie it is the floating point value
+    // nearest to the Number, ties going to even.
     //
     double toDouble () const noexcept;
     long double toLongDouble () const noexcept;
 
+    //
+    // Converts count Numbers to doubles, storing them in results.  Each result
+    // is the same as calling toDouble () on the corresponding Number.
+    //
+    static void toDouble (
+        const Number* numbers,
+        double* results,
+        size_t count
+    ) noexcept;
+
     //
     // Modifies the default multiplication precision policy at the library
     // level, all future instantiations of a Number will use this value.
@@ -478,6 +579,33 @@ class Number {
         const Sign sign
     );
 
+    //
+    // Does the work for floatingPoint (), the value converted is:
+    //
+    //   (negative ? -1 : 1) * mantissa * 2^exponent
+    //
+    // Where mantissa has at most mantissaBits significant bits.
+    //
+    static Number fromBinaryFloatingPoint (
+        const uint64_t mantissa,
+        const int exponent,
+        const unsigned int mantissaBits,
+        const bool negative,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    );
+
+    //
+    // Splits a floating point value into value = mantissa * 2^exponent,
+    // ignoring the sign.  Expects a finite value.
+    //
+    template <typename T>
+    static void decomposeFloatingPoint (
+        const T& value,
+        uint64_t& mantissa,
+        int& exponent
+    ) noexcept;
+
     template <typename T>
     static void setValue (
         const uint64_t integerValue,
@@ -487,6 +615,12 @@ class Number {
         T& value
     );
 
+    //
+    // The value at MAX_DECIMAL_PLACES, the same for all Numbers that are
+    // equal.  The magnitude is below 2^110 so this can't overflow.
+    //
+    __int128_t canonicalValue () const noexcept;
+
     //
     // Determines if there are any trailing zeros after the decimal point that
     // can simply be removed for the purpose of keeping numbers smaller
@@ -517,6 +651,22 @@ class Number {
     template <typename T>
     T toFloatingPoint () const noexcept;
 
+    //
+    // Returns 10^exp exactly, valid for exp <= MAX_DECIMAL_PLACES.
+    //
+    template <typename T>
+    static T powerOfTen (unsigned int exp) noexcept;
+
+    //
+    // Correctly rounded magnitude / 10^decimalPlaces, used by
+    // toFloatingPoint () when the operands can't be represented exactly by T.
+    //
+    template <typename T>
+    static T divideRounded (
+        const __uint128_t& magnitude,
+        const unsigned int decimalPlaces
+    ) noexcept;
+
     friend bool operator== (const Number& lhs, const Number& rhs);
     friend bool operator< (const Number& lhs, const Number& rhs);
     friend bool operator<= (const Number& lhs, const Number& rhs);
@@ -528,6 +678,8 @@ class Number {
 
     friend const Number operator% (const Number& lhs, const Number& rhs);
 
+    friend class Accumulator;
+
     template <typename T> bool isCompact (const T& val) const noexcept;
 
     template <typename T> unsigned int makeCompact (
@@ -595,6 +747,18 @@ class Number {
         const std::string& errMsgHeader
     );
 
+    //
+    // Utility function meant for Number::Number (std::string), can throw
+    // fixed::BadValueException
+    //
+    static void applyExponent (
+        const unsigned long long exponent,
+        const Sign exponentSign,
+        unsigned long long& integerValue,
+        unsigned long long& fractionalValue,
+        unsigned int& fractionalDigits
+    );
+
     //
     // Can throw fixed::OverflowException
     //
@@ -809,66 +973,107 @@ inline Number Number::floatingPoint (
         "This method is only expected to be invoked with a floating point type"
     );
 
-    long double val = static_cast<long double> (floatingPointValue);
+    static_assert (
+        std::numeric_limits<T>::radix == 2 &&
+        std::numeric_limits<T>::digits <= 64,
+        "Only binary floating point types with up to a 64 bit mantissa are "
+        "supported"
+    );
 
-    if (std::isnan (val))
+    if (std::isnan (floatingPointValue))
     {
         throw fixed::BadValueException (
             "Floating point constructor value is not a number"
         );
     }
 
-    if (std::isinf (val))
+    if (std::isinf (floatingPointValue))
     {
         throw fixed::BadValueException (
             "Floating point constructor value is + or - infinity"
         );
     }
 
-    bool minimizeDps = false;
+    uint64_t mantissa = 0;
+    int exponent = 0;
 
-    if (decimalPlaces > MAX_DECIMAL_PLACES)
-    {
-        minimizeDps = true;
-        decimalPlaces = MAX_DECIMAL_PLACES;
-    }
+    decomposeFloatingPoint (floatingPointValue, mantissa, exponent);
 
+    return fromBinaryFloatingPoint (
+        mantissa,
+        exponent,
+        std::numeric_limits<T>::digits,
+        std::signbit (floatingPointValue),
+        decimalPlaces,
+        roundingMode
+    );
+}
+
+template <typename T>
+inline void Number::decomposeFloatingPoint (
+    const T& value,
+    uint64_t& mantissa,
+    int& exponent
+) noexcept
+{
     //
-    // Note, passing in fabsl (val) into modf, this way both intPart and
-    // fractPart will be positive, will simplify things.
+    // Both frexp and ldexp are exact, mantissa * 2^exponent is precisely the
+    // value passed in.
     //
-    long double intPart = 0.0;
-    long double fractPart = std::modf (fabsl (val), &intPart);
+    T fraction = std::frexp (value, &exponent);
 
-    if (intPart > static_cast<long double> (MAX_INTEGER_VALUE))
-    {
-        throw fixed::BadValueException (
-            "Floating point constructor, integer value too large."
-        );
-    }
+    mantissa = static_cast<uint64_t> (
+        std::ldexp (std::fabs (fraction), std::numeric_limits<T>::digits)
+    );
 
-    //
-    // Initially use MAX_DECIMAL_PLACES so we can then get the desired rounding
-    // when switching to desired decimalPlaces
-    //
-    Number number (
-        static_cast<uint64_t> (intPart),
-        static_cast<uint64_t> (
-            fractPart * shiftTable64 () [MAX_DECIMAL_PLACES].value
-        ),
-        MAX_DECIMAL_PLACES,
-        (val < 0.0) ? Sign::NEGATIVE : Sign::POSITIVE
+    exponent -= std::numeric_limits<T>::digits;
+}
+
+//
+// The common case of a double is done by picking apart the IEEE 754 bits,
+// which is a lot cheaper than the frexp and ldexp library calls.
+//
+template <>
+inline void Number::decomposeFloatingPoint (
+    const double& value,
+    uint64_t& mantissa,
+    int& exponent
+) noexcept
+{
+    static_assert (
+        std::numeric_limits<double>::is_iec559 && sizeof (double) == 8,
+        "Expecting double to be an IEEE 754 64 bit value"
     );
 
-    number.setRoundingMode (roundingMode);
-    number.setDecimalPlaces (decimalPlaces);
+    static constexpr unsigned int FRACTION_BITS =
+        std::numeric_limits<double>::digits - 1;
+
+    static constexpr int EXPONENT_BIAS =
+        std::numeric_limits<double>::max_exponent - 1 + FRACTION_BITS;
+
+    uint64_t bits = 0;
+
+    std::memcpy (&bits, &value, sizeof (bits));
+
+    const uint64_t fraction =
+        bits & ((static_cast<uint64_t> (1) << FRACTION_BITS) - 1);
 
-    if (minimizeDps)
+    const int biasedExponent =
+        static_cast<int> ((bits >> FRACTION_BITS) & 0x7FF);
+
+    if (biasedExponent)
     {
-        number.makeCompact ();
+        mantissa = fraction | (static_cast<uint64_t> (1) << FRACTION_BITS);
+        exponent = biasedExponent - EXPONENT_BIAS;
+    }
+    else
+    {
+        //
+        // Subnormal
+        //
+        mantissa = fraction;
+        exponent = 1 - EXPONENT_BIAS;
     }
-
-    return number;
 }
 
 inline Number::Number () noexcept
@@ -1072,6 +1277,11 @@ inline bool Number::value64Set () const noexcept
     return value64Set_;
 }
 
+inline __int128_t Number::scaledValue () const noexcept
+{
+    return value64Set_ ? static_cast<__int128_t> (value64_) : value128_;
+}
+
 template <typename T>
 unsigned int Number::squeezeZeros (
     T& val,
@@ -1227,18 +1437,75 @@ inline long double Number::toLongDouble () const noexcept
     return toFloatingPoint<long double> ();
 }
 
+inline void Number::toDouble (
+    const Number* numbers,
+    double* results,
+    size_t count
+) noexcept
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        results[i] = numbers[i].toFloatingPoint<double> ();
+    }
+}
+
+//
+// When both the value and 10^decimalPlaces are exactly representable by T
+// a single IEEE division gives the correctly rounded result, this covers
+// nearly all Numbers stored in 64 bits.  Otherwise we fall back to an exact
+// integer division.
+//
 template <typename T> inline T Number::toFloatingPoint () const noexcept
 {
-    T val = static_cast<T> (integerValue ());
+    static_assert (
+        std::numeric_limits<T>::radix == 2 &&
+        std::numeric_limits<T>::digits <= 64 &&
+        std::numeric_limits<T>::digits10 >=
+            static_cast<int> (MAX_DECIMAL_PLACES),
+        "Expecting a binary floating point type that can hold "
+        "10^MAX_DECIMAL_PLACES exactly"
+    );
+
+    static constexpr uint64_t MAX_EXACT_VALUE = (
+        std::numeric_limits<T>::digits >= 64 ?
+            std::numeric_limits<uint64_t>::max () :
+            static_cast<uint64_t> (1) << (std::numeric_limits<T>::digits % 64)
+    );
+
+    if (value64Set_ &&
+        (absoluteValue<uint64_t> (value64_) <= MAX_EXACT_VALUE))
+    {
+        return static_cast<T> (value64_) / powerOfTen<T> (decimalPlaces ());
+    }
 
-    val += (
-        static_cast<T> (fractionalValue ()) /
-        static_cast<T> (shiftTable64 () [decimalPlaces ()].value)
+    const T val = divideRounded<T> (
+        value64Set_ ?
+            absoluteValue<__uint128_t> (value64_) :
+            absoluteValue<__uint128_t> (value128_),
+        decimalPlaces ()
     );
 
     return isNegative () ? - val : val;
 }
 
+template <typename T> inline T Number::powerOfTen (unsigned int exp) noexcept
+{
+    static_assert (
+        MAX_DECIMAL_PLACES <= 18,
+        "Table below needs updating if MAX_DECIMAL_PLACES changes"
+    );
+
+    //
+    // All of these are exactly representable by a double
+    //
+    static constexpr T table[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+    };
+
+    return table[exp];
+}
+
 inline std::string Number::toString () const noexcept
 {
     std::ostringstream os;
@@ -1275,4 +1542,16 @@ inline Number operator- (const Number& n)
 
 } // namespace fixed
 
+namespace std {
+
+template <>
+struct hash<fixed::Number> {
+    size_t operator() (const fixed::Number& number) const noexcept
+    {
+        return number.hash ();
+    }
+};
+
+} // namespace std
+
 #endif // FIXED_NUMBER_H
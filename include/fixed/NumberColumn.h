@@ -0,0 +1,290 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_NUMBER_COLUMN_H
+#define FIXED_NUMBER_COLUMN_H
+
+#include "fixed/Number.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace fixed {
+
+//
+// A column of Numbers which all share the same number of decimal places,
+// stored as a structure of arrays.
+//
+// Each value is kept as its integer mantissa at the column scale, i.e. the
+// Number multiplied by 10^decimalPlaces (), in one contiguous int64_t array.
+// The rare value needing more than 64 bits at the column scale has
+// WIDE_MARKER stored in its mantissa slot, and its actual value kept in a
+// sparse side table.  Batch operations can therefore run straight over
+// mantissas () and only fall back to the side table for flagged slots.
+//
+// Numbers with more decimal places than the column are rounded on the way
+// in using the column rounding mode, those with fewer are scaled up, which
+// is always exact.  Numbers handed back out have the column's decimal
+// places.
+//
+class NumberColumn {
+  public:
+    class const_iterator;
+
+    //
+    // Marks a mantissa slot whose value lives in the wide value table.
+    // Number itself never stores int64_t min in its 64 bit form, for the
+    // same reason it can't be used here as an ordinary value: its
+    // magnitude has no int64_t representation.
+    //
+    static constexpr int64_t WIDE_MARKER =
+        std::numeric_limits<int64_t>::min ();
+
+    //
+    // Creates an empty column.  A fixed::BadValueException will be thrown
+    // if decimalPlaces exceeds Number::MAX_DECIMAL_PLACES.
+    //
+    explicit NumberColumn (
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    //
+    // Creates a column holding each of the numbers, in order, converted to
+    // decimalPlaces.
+    //
+    NumberColumn (
+        const std::vector<Number>& numbers,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    std::vector<Number> toNumbers () const;
+
+    unsigned int decimalPlaces () const noexcept;
+
+    Rounding::Mode roundingMode () const noexcept;
+
+    size_t size () const noexcept;
+
+    bool empty () const noexcept;
+
+    void reserve (const size_t count);
+
+    void clear () noexcept;
+
+    void push_back (const Number& number);
+
+    //
+    // Unchecked element access.
+    //
+    Number operator[] (const size_t idx) const;
+
+    //
+    // Element access, throws a fixed::BadValueException if idx is out of
+    // range.
+    //
+    Number at (const size_t idx) const;
+
+    //
+    // Replaces the value at idx, which must be in range.
+    //
+    void set (const size_t idx, const Number& number);
+
+    //
+    // Access to the values as integers at the column scale, the way
+    // Number::scaledValue () and Number::fromScaledValue () see them.
+    //
+    // The setters throw a fixed::BadValueException when the magnitude of
+    // the integer value would exceed Number::MAX_INTEGER_VALUE.
+    //
+    __int128_t scaledValue (const size_t idx) const noexcept;
+
+    void setScaledValue (const size_t idx, const __int128_t value);
+
+    void pushBackScaledValue (const __int128_t value);
+
+    //
+    // The contiguous mantissa array, size () entries long.  Slots holding
+    // WIDE_MARKER need scaledValue () to read.
+    //
+    const int64_t* mantissas () const noexcept;
+
+    bool isWide (const size_t idx) const noexcept;
+
+    //
+    // Number of values held in the wide value table.
+    //
+    size_t wideCount () const noexcept;
+
+    const_iterator begin () const noexcept;
+
+    const_iterator end () const noexcept;
+
+  private:
+    friend class ColumnOps;
+    friend class Financing;
+    friend class Reductions;
+
+    __int128_t toColumnScale (const Number& number) const;
+
+    void storeWide (const size_t idx, const __int128_t value);
+
+    static bool fitsMantissa (const __int128_t value) noexcept;
+
+    unsigned int decimalPlaces_;
+
+    Rounding::Mode roundingMode_;
+
+    std::vector<int64_t> mantissas_;
+
+    std::unordered_map<size_t, __int128_t> wideValues_;
+};
+
+//
+// Iterates over the column producing Numbers by value.
+//
+class NumberColumn::const_iterator {
+  public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef Number value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Number* pointer;
+    typedef Number reference;
+
+    const_iterator (const NumberColumn* column, const size_t idx) noexcept
+      : column_ (column),
+        idx_ (idx)
+    {}
+
+    Number operator* () const { return (*column_) [idx_]; }
+
+    const_iterator& operator++ () noexcept
+    {
+        ++idx_;
+
+        return *this;
+    }
+
+    const_iterator operator++ (int) noexcept
+    {
+        const_iterator previous (*this);
+
+        ++idx_;
+
+        return previous;
+    }
+
+    bool operator== (const const_iterator& rhs) const noexcept
+    {
+        return column_ == rhs.column_ && idx_ == rhs.idx_;
+    }
+
+    bool operator!= (const const_iterator& rhs) const noexcept
+    {
+        return ! (*this == rhs);
+    }
+
+  private:
+    const NumberColumn* column_;
+
+    size_t idx_;
+};
+
+inline unsigned int NumberColumn::decimalPlaces () const noexcept
+{
+    return decimalPlaces_;
+}
+
+inline Rounding::Mode NumberColumn::roundingMode () const noexcept
+{
+    return roundingMode_;
+}
+
+inline size_t NumberColumn::size () const noexcept
+{
+    return mantissas_.size ();
+}
+
+inline bool NumberColumn::empty () const noexcept
+{
+    return mantissas_.empty ();
+}
+
+inline Number NumberColumn::operator[] (const size_t idx) const
+{
+    return Number::fromScaledValue (scaledValue (idx), decimalPlaces_);
+}
+
+inline __int128_t NumberColumn::scaledValue (const size_t idx) const noexcept
+{
+    const int64_t mantissa = mantissas_ [idx];
+
+    if (mantissa != WIDE_MARKER)
+    {
+        return mantissa;
+    }
+
+    return wideValues_.find (idx)->second;
+}
+
+inline const int64_t* NumberColumn::mantissas () const noexcept
+{
+    return mantissas_.data ();
+}
+
+inline bool NumberColumn::isWide (const size_t idx) const noexcept
+{
+    return mantissas_ [idx] == WIDE_MARKER;
+}
+
+inline size_t NumberColumn::wideCount () const noexcept
+{
+    return wideValues_.size ();
+}
+
+inline NumberColumn::const_iterator NumberColumn::begin () const noexcept
+{
+    return const_iterator (this, 0);
+}
+
+inline NumberColumn::const_iterator NumberColumn::end () const noexcept
+{
+    return const_iterator (this, size ());
+}
+
+inline bool NumberColumn::fitsMantissa (const __int128_t value) noexcept
+{
+    return value > WIDE_MARKER &&
+           value <= std::numeric_limits<int64_t>::max ();
+}
+
+} // namespace fixed
+
+#endif // FIXED_NUMBER_COLUMN_H
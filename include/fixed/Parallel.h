@@ -0,0 +1,159 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_PARALLEL_H
+#define FIXED_PARALLEL_H
+
+#include "fixed/Accumulator.h"
+#include "fixed/Number.h"
+#include "fixed/ThreadPool.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace fixed {
+namespace parallel {
+
+//
+// Parallel algorithms over arrays of Numbers, run on a ThreadPool, the
+// shared one unless another is given.
+//
+// The arrays are split into chunks of CHUNK_SIZE Numbers.  Sums are
+// accumulated exactly, an Accumulator per chunk merged at the end, so the
+// result is the same whatever the number of threads or however the chunks
+// were shared out: exactly what a loop over operator+= gives when that
+// doesn't overflow.  Only the final sum must be in range, a
+// fixed::OverflowException is thrown otherwise.
+//
+// An exception thrown by an operation, or by the Number arithmetic, is
+// rethrown once the other threads have stopped, with some of the results
+// of a transform () possibly written.
+//
+static constexpr size_t CHUNK_SIZE = 16384;
+
+//
+// The sum of the Numbers.
+//
+Number reduce (
+    const Number* numbers,
+    const size_t count,
+    ThreadPool& pool = ThreadPool::shared ()
+);
+
+//
+// result [idx] = operation (numbers [idx]) for each idx in [0, count).
+//
+template <typename UnaryOperation>
+void transform (
+    const Number* numbers,
+    const size_t count,
+    Number* result,
+    UnaryOperation operation,
+    ThreadPool& pool = ThreadPool::shared ()
+);
+
+//
+// The sum of operation (numbers [idx]) for each idx in [0, count).
+//
+template <typename UnaryOperation>
+Number transform_reduce (
+    const Number* numbers,
+    const size_t count,
+    UnaryOperation operation,
+    ThreadPool& pool = ThreadPool::shared ()
+);
+
+//
+// The sum of lhs [idx] * rhs [idx] for each idx in [0, count), each
+// product rounded as operator* would.
+//
+Number transform_reduce (
+    const Number* lhs,
+    const Number* rhs,
+    const size_t count,
+    ThreadPool& pool = ThreadPool::shared ()
+);
+
+//
+// The number of chunks count Numbers are split into.
+//
+size_t chunkCount (const size_t count) noexcept;
+
+//
+// The sum of the Accumulators sum (begin, end, total) adds each chunk's
+// Numbers to, which is what the sums above are built on.
+//
+Number sumChunks (
+    const size_t count,
+    const std::function<void (size_t, size_t, Accumulator&)>& sum,
+    ThreadPool& pool
+);
+
+template <typename UnaryOperation>
+inline void transform (
+    const Number* numbers,
+    const size_t count,
+    Number* result,
+    UnaryOperation operation,
+    ThreadPool& pool
+)
+{
+    pool.run (chunkCount (count), [&] (const size_t chunk) {
+        const size_t begin = chunk * CHUNK_SIZE;
+        const size_t end = count - begin < CHUNK_SIZE ?
+                           count :
+                           begin + CHUNK_SIZE;
+
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            result [idx] = operation (numbers [idx]);
+        }
+    });
+}
+
+template <typename UnaryOperation>
+inline Number transform_reduce (
+    const Number* numbers,
+    const size_t count,
+    UnaryOperation operation,
+    ThreadPool& pool
+)
+{
+    return sumChunks (
+        count,
+        [&] (const size_t begin, const size_t end, Accumulator& total) {
+            for (size_t idx = begin; idx < end; ++idx)
+            {
+                total.add (operation (numbers [idx]));
+            }
+        },
+        pool
+    );
+}
+
+} // namespace parallel
+} // namespace fixed
+
+#endif // FIXED_PARALLEL_H
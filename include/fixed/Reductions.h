@@ -0,0 +1,110 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_REDUCTIONS_H
+#define FIXED_REDUCTIONS_H
+
+#include "fixed/NumberColumn.h"
+
+#include <cstddef>
+#include <string>
+
+namespace fixed {
+
+//
+// Exact reductions over NumberColumns and arrays of Numbers.
+//
+// Sums are accumulated without intermediate rounding or overflow checks
+// against MAX_INTEGER_VALUE, only the final result must be in range, a
+// fixed::OverflowException is thrown otherwise.  Sums over Numbers with
+// differing decimal places are done at the largest of them, the same as a
+// loop over operator+= would give.
+//
+// The mean is the exact sum divided by the count, rounded to the same
+// decimal places as the sum using the rounding mode given.  Taking the mean,
+// min or max of nothing throws a fixed::BadValueException.
+//
+class Reductions {
+  public:
+    static Number sum (const NumberColumn& column);
+
+    static Number min (const NumberColumn& column);
+
+    static Number max (const NumberColumn& column);
+
+    //
+    // Rounds using the column rounding mode.
+    //
+    static Number mean (const NumberColumn& column);
+
+    static Number mean (
+        const NumberColumn& column,
+        const Rounding::Mode roundingMode
+    );
+
+    static size_t countNonZero (const NumberColumn& column) noexcept;
+
+    static Number sum (const Number* numbers, const size_t count);
+
+    static Number min (const Number* numbers, const size_t count);
+
+    static Number max (const Number* numbers, const size_t count);
+
+    static Number mean (
+        const Number* numbers,
+        const size_t count,
+        const Rounding::Mode roundingMode
+    );
+
+    static size_t countNonZero (
+        const Number* numbers,
+        const size_t count
+    ) noexcept;
+
+  private:
+    static __int128_t scaledSum (const NumberColumn& column);
+
+    static __int128_t scaledSum (
+        const Number* numbers,
+        const size_t count,
+        unsigned int& decimalPlaces
+    );
+
+    static __int128_t divideRounded (
+        const __int128_t sum,
+        const size_t count,
+        const Rounding::Mode roundingMode
+    );
+
+    static Number toNumber (
+        const __int128_t value,
+        const unsigned int decimalPlaces,
+        const std::string& opName
+    );
+};
+
+} // namespace fixed
+
+#endif // FIXED_REDUCTIONS_H
@@ -0,0 +1,195 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_ROLLING_WINDOW_H
+#define FIXED_ROLLING_WINDOW_H
+
+#include "fixed/Int256.h"
+#include "fixed/Number.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fixed {
+
+//
+// Moving sum, mean, min and max over the last count values, or over the
+// values in the last span of time.
+//
+// Values are held in a ring buffer as integers at the window's fixed
+// decimal places, rounded to it on the way in if they have more, so
+// sliding the window never rescales anything.  The sum is exact, each value
+// being added on the way in and subtracted on the way out, and min and max
+// come from monotonic queues, so every update is O(1) amortised.  All
+// storage is allocated by the constructor.
+//
+// Timestamps are integers in whatever unit the caller uses and must not go
+// backwards, a fixed::BadValueException is thrown if one does.
+//
+class RollingWindow {
+  public:
+    //
+    // A window over the last count values.
+    //
+    // A fixed::BadValueException will be thrown if count is zero or the
+    // decimalPlaces exceeds MAX_DECIMAL_PLACES.
+    //
+    RollingWindow (
+        const size_t count,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    //
+    // A window over the values with timestamps in (latest - span, latest],
+    // latest being the last timestamp added or advanced to, holding at most
+    // capacity values, the oldest being dropped to make room.
+    //
+    // A fixed::BadValueException will be thrown if capacity or span isn't
+    // positive or the decimalPlaces exceeds MAX_DECIMAL_PLACES.
+    //
+    RollingWindow (
+        const size_t capacity,
+        const int64_t span,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode = Number::DEFAULT_ROUNDING_MODE
+    );
+
+    //
+    // Adds value with the last timestamp seen, for count windows.
+    //
+    void add (const Number& value);
+
+    void add (const Number& value, const int64_t timestamp);
+
+    //
+    // Drops the values that have aged out of the window by time now.
+    //
+    void advance (const int64_t now);
+
+    void clear () noexcept;
+
+    size_t size () const noexcept;
+
+    bool isEmpty () const noexcept;
+
+    size_t capacity () const noexcept;
+
+    unsigned int decimalPlaces () const noexcept;
+
+    //
+    // The sum of the values in the window at decimalPlaces (), zero for an
+    // empty window.
+    //
+    // A fixed::OverflowException will be thrown if the sum is outside the
+    // range of a Number.
+    //
+    Number sum () const;
+
+    //
+    // The mean of the values in the window, at decimalPlaces () unless given.
+    //
+    // A fixed::BadValueException will be thrown if the window is empty.
+    //
+    Number mean (const Rounding::Mode roundingMode) const;
+
+    Number mean (
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    ) const;
+
+    //
+    // The smallest and largest values in the window, at decimalPlaces ().
+    //
+    // A fixed::BadValueException will be thrown if the window is empty.
+    //
+    Number min () const;
+
+    Number max () const;
+
+  private:
+    //
+    // A queue of positions in the window, in a ring as large as the window
+    // so it never needs to grow.
+    //
+    struct PositionQueue {
+        std::vector<uint64_t> positions;
+        uint64_t front;
+        uint64_t back;
+    };
+
+    void initialise (const size_t capacity, const unsigned int decimalPlaces);
+
+    __int128_t scale (const Number& value) const;
+
+    __int128_t valueAt (const uint64_t position) const noexcept;
+
+    void push (const __int128_t value, const int64_t timestamp);
+
+    void pop ();
+
+    //
+    // The ring is capacity rounded up to a power of 2, a position being
+    // stored at position & mask_.
+    //
+    std::vector<__int128_t> values_;
+    std::vector<int64_t> timestamps_;
+
+    size_t capacity_;
+    uint64_t mask_;
+
+    //
+    // Positions count every value ever added, the oldest value in the
+    // window being at first_ and the next to be added at next_.
+    //
+    uint64_t first_;
+    uint64_t next_;
+
+    //
+    // Ascending and descending, the front of each is the min or the max.
+    //
+    PositionQueue minimums_;
+    PositionQueue maximums_;
+
+    //
+    // The sum, which can't overflow as the window holds at most capacity
+    // values below 2^110.
+    //
+    Int256 sum_;
+
+    //
+    // Zero for count windows.
+    //
+    int64_t span_;
+    int64_t latest_;
+
+    uint8_t decimalPlaces_;
+    Rounding::Mode roundingMode_;
+};
+
+} // namespace fixed
+
+#endif // FIXED_ROLLING_WINDOW_H
@@ -0,0 +1,127 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_SHARDED_ACCUMULATOR_H
+#define FIXED_SHARDED_ACCUMULATOR_H
+
+#include "fixed/Accumulator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace fixed {
+
+//
+// An exact running total that many threads can add to at once.
+//
+// Each thread that calls add () or sub () is given its own shard on first
+// use, an exact Accumulator padded out to its own cache lines, and only
+// ever writes to that.  Adds are wait free and don't share any cache lines
+// with other threads, so they scale with the thread count where a mutex
+// guarded Number serialises them.
+//
+// snapshot () combines the shards exactly, and can be called from any
+// thread at any time.  Each add is either wholly included or not, adds
+// racing with the snapshot may or may not be.
+//
+// A shard stays with the accumulator until it's destroyed, keeping the
+// total of its thread after that thread exits.  The accumulator itself
+// can't be copied or moved, and must outlive every thread using it.
+//
+class ShardedAccumulator {
+  public:
+    ShardedAccumulator () noexcept;
+
+    ~ShardedAccumulator ();
+
+    ShardedAccumulator (const ShardedAccumulator&) = delete;
+    ShardedAccumulator& operator= (const ShardedAccumulator&) = delete;
+
+    //
+    // Only the first add () or sub () of each thread can throw, a
+    // std::bad_alloc if its shard can't be allocated.
+    //
+    void add (const Number& number);
+
+    void sub (const Number& number);
+
+    //
+    // The total of every shard.
+    //
+    Accumulator total () const noexcept;
+
+    //
+    // total ().toNumber (), throwing a fixed::OverflowException if the total
+    // is outside the range of a Number.
+    //
+    Number snapshot () const;
+
+    //
+    // The number of threads that have added to the accumulator.
+    //
+    size_t shardCount () const noexcept;
+
+  private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    //
+    // A sequence lock guards the total so snapshots see it whole, the
+    // owning thread makes the sequence odd while it writes.  The limbs are
+    // atomics only so the racing reads are well defined, plain loads and
+    // stores are all they compile to.
+    //
+    struct Shard {
+        std::atomic<uint64_t> sequence;
+
+        std::atomic<uint64_t> low;
+        std::atomic<uint64_t> middle;
+        std::atomic<uint64_t> high;
+        std::atomic<unsigned int> decimalPlaces;
+
+        std::thread::id owner;
+        Shard* next;
+    };
+
+    Shard* localShard ();
+
+    Shard* claimShard ();
+
+    static Accumulator read (const Shard& shard) noexcept;
+
+    static void write (Shard& shard, const Accumulator& total) noexcept;
+
+    //
+    // Unique over the life of the process, so a thread's cached shard can't
+    // be mistaken for one of a later accumulator at the same address.
+    //
+    const uint64_t id_;
+
+    std::atomic<Shard*> shards_;
+};
+
+} // namespace fixed
+
+#endif // FIXED_SHARDED_ACCUMULATOR_H
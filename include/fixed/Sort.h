@@ -0,0 +1,62 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_SORT_H
+#define FIXED_SORT_H
+
+#include "fixed/Number.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace fixed {
+
+//
+// Sorts Numbers into ascending order by value.
+//
+// Every value is brought to the largest decimal places in the input once,
+// giving an integer key whose order matches the numeric order, and the keys
+// are then radix sorted.  The keys are 64 bit when every value fits and 128
+// bit otherwise, the work being linear in the count either way.
+//
+// Both sorts are stable, Numbers with equal values, such as 1.5 and 1.50,
+// keep their original relative order.  The Numbers themselves are left as
+// they are, only their order changes.
+//
+void sort (Number* numbers, const size_t count);
+
+void sort (std::vector<Number>& numbers);
+
+//
+// Returns the indices that would sort the numbers, numbers [result [0]]
+// being the smallest.
+//
+std::vector<size_t> argsort (const Number* numbers, const size_t count);
+
+std::vector<size_t> argsort (const std::vector<Number>& numbers);
+
+} // namespace fixed
+
+#endif // FIXED_SORT_H
@@ -0,0 +1,198 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_STREAMING_STATS_H
+#define FIXED_STREAMING_STATS_H
+
+#include "fixed/Int256.h"
+#include "fixed/Number.h"
+
+#include <cstdint>
+
+namespace fixed {
+
+//
+// Streaming estimators, updated in O(1) per value.
+//
+// Each keeps exact integer sums, rescaled upwards only when a value with
+// more decimal places than any before it arrives, and only divides when a
+// result is read.  Reading a result rounds once, using the Rounding::Mode
+// passed in, so it doesn't depend on the order the values were added in.
+//
+// Reading a result before anything has been added throws a
+// fixed::BadValueException, as does asking for more than MAX_DECIMAL_PLACES.
+// A fixed::OverflowException is thrown if a sum outgrows 256 bits or a
+// result is outside the range of a Number.
+//
+
+//
+// Volume weighted average price, sum (price * quantity) / sum (quantity).
+//
+class Vwap {
+  public:
+    Vwap () noexcept;
+
+    void add (const Number& price, const Number& quantity);
+
+    void clear () noexcept;
+
+    bool isEmpty () const noexcept;
+
+    //
+    // The VWAP at the largest decimal places of the prices added.
+    //
+    // A fixed::DivideByZeroException will be thrown if the quantities add up
+    // to zero.
+    //
+    Number vwap (const Rounding::Mode roundingMode) const;
+
+    Number vwap (
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    ) const;
+
+  private:
+    Int256 notional_;
+    Int256 quantity_;
+
+    uint64_t count_;
+
+    uint8_t priceDecimalPlaces_;
+    uint8_t quantityDecimalPlaces_;
+};
+
+//
+// Time weighted average price, each price weighted by how long it stood
+// until the next one, or until the end time for the last.
+//
+// Timestamps are integers in whatever unit the caller uses and must not go
+// backwards, a fixed::BadValueException is thrown if one does.
+//
+class Twap {
+  public:
+    Twap () noexcept;
+
+    void add (const Number& price, const int64_t timestamp);
+
+    void clear () noexcept;
+
+    bool isEmpty () const noexcept;
+
+    //
+    // The TWAP from the first timestamp to endTime, at the largest decimal
+    // places of the prices added.  With no time elapsed that's the last
+    // price.
+    //
+    // A fixed::BadValueException will be thrown if endTime is before the
+    // last timestamp added.
+    //
+    Number twap (
+        const int64_t endTime,
+        const Rounding::Mode roundingMode
+    ) const;
+
+    Number twap (
+        const int64_t endTime,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    ) const;
+
+  private:
+    Int256 weighted_;
+
+    __int128_t lastPrice_;
+
+    int64_t firstTimestamp_;
+    int64_t lastTimestamp_;
+
+    uint64_t count_;
+
+    uint8_t decimalPlaces_;
+};
+
+//
+// Running mean and variance, from the count, sum and sum of squares.
+//
+class RunningVariance {
+  public:
+    RunningVariance () noexcept;
+
+    void add (const Number& number);
+
+    void clear () noexcept;
+
+    uint64_t count () const noexcept;
+
+    //
+    // The mean at the largest decimal places of the Numbers added.
+    //
+    Number mean (const Rounding::Mode roundingMode) const;
+
+    Number mean (
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    ) const;
+
+    //
+    // The population variance, divided by count (), at twice the largest
+    // decimal places of the Numbers added, capped at MAX_DECIMAL_PLACES.
+    //
+    Number variance (const Rounding::Mode roundingMode) const;
+
+    Number variance (
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    ) const;
+
+    //
+    // The sample variance, divided by count () - 1, which throws a
+    // fixed::BadValueException with fewer than two Numbers added.
+    //
+    Number sampleVariance (const Rounding::Mode roundingMode) const;
+
+    Number sampleVariance (
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    ) const;
+
+  private:
+    //
+    // count () * sum of squares - sum * sum, the variance numerator.
+    //
+    Int256 spread () const;
+
+    unsigned int varianceDecimalPlaces () const noexcept;
+
+    Int256 sum_;
+    Int256 sumSquares_;
+
+    uint64_t count_;
+
+    uint8_t decimalPlaces_;
+};
+
+} // namespace fixed
+
+#endif // FIXED_STREAMING_STATS_H
@@ -0,0 +1,139 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_THREAD_POOL_H
+#define FIXED_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fixed {
+
+//
+// A fixed set of threads that run the chunks of one job at a time, the
+// calling thread included, for the algorithms in fixed::parallel.
+//
+// The chunks of a job are dealt out to the threads in equal contiguous
+// ranges up front.  Each thread takes chunks from the front of its own
+// range, and once that is empty steals the back half of another's, so the
+// load evens out without any locking or allocation per chunk.
+//
+class ThreadPool {
+  public:
+    //
+    // A pool of threads threads, the caller of run () being one of them, so
+    // a pool of 1 runs everything on the caller.
+    //
+    // A fixed::BadValueException will be thrown if threads is zero.
+    //
+    explicit ThreadPool (const unsigned int threads);
+
+    ~ThreadPool ();
+
+    ThreadPool (const ThreadPool&) = delete;
+    ThreadPool& operator= (const ThreadPool&) = delete;
+
+    unsigned int threads () const noexcept;
+
+    //
+    // Calls task (chunk) for each chunk in [0, chunks), spread over the
+    // pool's threads, and returns once they have all finished.  Jobs from
+    // different callers run one after another.
+    //
+    // A run () from inside a task on the same pool, such as a
+    // fixed::parallel call on the pool it is already running on, calls its
+    // chunks in turn on that thread, as the pool is busy with the outer job.
+    //
+    // The first exception a task throws is rethrown once the job has
+    // finished, the chunks that hadn't started by then being skipped.
+    // A fixed::BadValueException will be thrown if chunks exceeds 2^32 - 1.
+    //
+    void run (const size_t chunks, const std::function<void (size_t)>& task);
+
+    //
+    // A pool shared by the process, created on first use with the number of
+    // threads in the FIXED_THREADS environment variable, or one per
+    // hardware thread if that isn't set.
+    //
+    static ThreadPool& shared ();
+
+  private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    //
+    // The chunks [begin, end) a thread has left, packed as begin << 32 |
+    // end so it can be taken from and stolen from with a single CAS.
+    //
+    struct alignas (CACHE_LINE_SIZE) Range {
+        std::atomic<uint64_t> chunks;
+    };
+
+    void workerLoop (const unsigned int self);
+
+    void work (const unsigned int self);
+
+    bool next (const unsigned int self, size_t& chunk);
+
+    bool take (const unsigned int self, size_t& chunk);
+
+    bool steal (const unsigned int self, const unsigned int victim);
+
+    const unsigned int threads_;
+
+    Range* ranges_;
+
+    std::vector<std::thread> workers_;
+
+    //
+    // Serialises jobs from different callers.
+    //
+    std::mutex runMutex_;
+
+    //
+    // Guards the job being started and finished, and the error.
+    //
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable finish_;
+
+    const std::function<void (size_t)>* task_;
+    uint64_t generation_;
+    unsigned int active_;
+    bool stopping_;
+
+    std::atomic<bool> failed_;
+    std::exception_ptr error_;
+};
+
+} // namespace fixed
+
+#endif // FIXED_THREAD_POOL_H
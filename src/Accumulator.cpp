@@ -0,0 +1,164 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Accumulator.h"
+
+#include <algorithm>
+
+namespace fixed {
+
+Accumulator::Accumulator () noexcept
+  : low_ (0),
+    high_ (0),
+    decimalPlaces_ (0)
+{
+}
+
+void Accumulator::add (const Number& number) noexcept
+{
+    addScaled (number.canonicalValue ());
+
+    decimalPlaces_ = std::max (decimalPlaces_, number.decimalPlaces_);
+}
+
+void Accumulator::sub (const Number& number) noexcept
+{
+    //
+    // The magnitude of a canonical value is below 2^110, so this can't
+    // overflow.
+    //
+    addScaled (-number.canonicalValue ());
+
+    decimalPlaces_ = std::max (decimalPlaces_, number.decimalPlaces_);
+}
+
+void Accumulator::merge (const Accumulator& other) noexcept
+{
+    const __uint128_t low = low_ + other.low_;
+
+    high_ = static_cast<int64_t> (
+        static_cast<uint64_t> (high_) + static_cast<uint64_t> (other.high_) +
+        (low < low_)
+    );
+    low_ = low;
+
+    decimalPlaces_ = std::max (decimalPlaces_, other.decimalPlaces_);
+}
+
+void Accumulator::clear () noexcept
+{
+    low_ = 0;
+    high_ = 0;
+    decimalPlaces_ = 0;
+}
+
+bool Accumulator::isZero () const noexcept
+{
+    return ! low_ && ! high_;
+}
+
+unsigned int Accumulator::decimalPlaces () const noexcept
+{
+    return decimalPlaces_;
+}
+
+Number Accumulator::toNumber () const
+{
+    //
+    // Every value added is a multiple of 10^-decimalPlaces (), so this
+    // doesn't round.
+    //
+    return toNumber (decimalPlaces_, Rounding::Mode::TOWARDS_ZERO);
+}
+
+Number Accumulator::toNumber (
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (decimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "Accumulator::toNumber () Decimal place exceeds max"
+        );
+    }
+
+    __int128_t total;
+
+    if (! total128 (total))
+    {
+        throw fixed::OverflowException (
+            "Accumulator::toNumber () Result too large"
+        );
+    }
+
+    const __int128_t divisor = Number::shiftTable64 () [
+        Number::MAX_DECIMAL_PLACES - decimalPlaces
+    ].value;
+
+    const __int128_t quotient = total / divisor;
+    const __int128_t remainder = total % divisor;
+
+    const __int128_t result = Rounding::round<__int128_t> (
+        roundingMode,
+        quotient,
+        2 * (remainder < 0 ? -remainder : remainder),
+        divisor,
+        total < 0
+    );
+
+    try {
+        return Number::fromScaledValue (result, decimalPlaces);
+    }
+    catch (const fixed::BadValueException&)
+    {
+        throw fixed::OverflowException (
+            "Accumulator::toNumber () Result too large"
+        );
+    }
+}
+
+void Accumulator::addScaled (const __int128_t value) noexcept
+{
+    const __uint128_t low = low_ + static_cast<__uint128_t> (value);
+
+    //
+    // Sign extending value to 192 bits gives an upper part of 0 or -1.
+    //
+    high_ = static_cast<int64_t> (
+        static_cast<uint64_t> (high_) + (low < low_) -
+        static_cast<uint64_t> (value < 0)
+    );
+    low_ = low;
+}
+
+bool Accumulator::total128 (__int128_t& value) const noexcept
+{
+    value = static_cast<__int128_t> (low_);
+
+    return high_ == (value < 0 ? -1 : 0);
+}
+
+} // namespace fixed
@@ -0,0 +1,197 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Allocate.h"
+#include "fixed/Divisor.h"
+#include "fixed/Exceptions.h"
+#include "fixed/Int256.h"
+#include "Ratio.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace fixed {
+
+//
+// weight as an integer at decimalPlaces, at least its own, which can't
+// overflow 128 bits.
+//
+static __int128_t scaledWeight (
+    const Number& weight,
+    const unsigned int decimalPlaces
+) noexcept
+{
+    return weight.scaledValue () *
+           Ratio::powerOfTen (decimalPlaces - weight.decimalPlaces ());
+}
+
+void allocate (
+    const Number& total,
+    const Number* weights,
+    const size_t count,
+    Number* out,
+    const Rounding::Mode roundingMode
+)
+{
+    if (! count)
+    {
+        throw fixed::BadValueException ("fixed::allocate () No weights");
+    }
+
+    unsigned int weightDecimalPlaces = 0;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        if (weights [idx].scaledValue () < 0)
+        {
+            throw fixed::BadValueException (
+                "fixed::allocate () Negative weight"
+            );
+        }
+
+        weightDecimalPlaces =
+            std::max (weightDecimalPlaces, weights [idx].decimalPlaces ());
+    }
+
+    __int128_t weightSum = 0;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        if (__builtin_add_overflow (
+                weightSum,
+                scaledWeight (weights [idx], weightDecimalPlaces),
+                &weightSum
+            ))
+        {
+            throw fixed::OverflowException (
+                "fixed::allocate () Weights too large"
+            );
+        }
+    }
+
+    if (! weightSum)
+    {
+        throw fixed::BadValueException (
+            "fixed::allocate () Weights sum to zero"
+        );
+    }
+
+    const Divisor divisor ((Int256 (weightSum)));
+
+    const __int128_t scaledTotal = total.scaledValue ();
+    const unsigned int decimalPlaces = total.decimalPlaces ();
+
+    //
+    // Each leg's exact share less its rounded share, times the weight sum,
+    // which is below the weight sum in magnitude, so comparing those
+    // compares how far each leg was rounded.  Paired with the leg's index.
+    //
+    std::vector<std::pair<__int128_t, size_t>> residues (count);
+
+    __int128_t allocated = 0;
+
+    const bool narrow =
+        divisor.isNarrow () && Divisor::fitsInt64 (scaledTotal);
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const __int128_t weight =
+            scaledWeight (weights [idx], weightDecimalPlaces);
+
+        __int128_t share = 0;
+
+        if (narrow && Divisor::fitsInt64 (weight))
+        {
+            const __int128_t product = scaledTotal * weight;
+
+            divisor.divideRounded (product, roundingMode, share);
+
+            residues [idx].first = product - share * weightSum;
+        }
+        else
+        {
+            Int256 product = Int256::multiply (scaledTotal, weight);
+
+            share =
+                Int256::divideRounded (product, divisor.value (), roundingMode);
+
+            product -= Int256::multiply (share, weightSum);
+            product.toInt128 (residues [idx].first);
+        }
+
+        residues [idx].second = idx;
+
+        out [idx] = Number::fromScaledValue (share, decimalPlaces);
+        allocated += share;
+    }
+
+    //
+    // The residues sum to the weight sum times the units left over, each
+    // below the weight sum, so more legs than are left over were rounded
+    // the way that needs correcting, and no leg moves past its exact share
+    // or off zero.
+    //
+    const __int128_t leftOver = scaledTotal - allocated;
+
+    if (! leftOver)
+    {
+        return;
+    }
+
+    const bool up = leftOver > 0;
+    const size_t adjustments =
+        static_cast<size_t> (up ? leftOver : -leftOver);
+
+    //
+    // Most rounded down first when units are left over, most rounded up
+    // first when too many were handed out, then the earlier leg, which is
+    // ascending order of the residue, negated for the first, and index.
+    //
+    if (up)
+    {
+        for (auto& residue: residues)
+        {
+            residue.first = -residue.first;
+        }
+    }
+
+    std::nth_element (
+        residues.begin (),
+        residues.begin () + (adjustments - 1),
+        residues.end ()
+    );
+
+    for (size_t idx = 0; idx < adjustments; ++idx)
+    {
+        Number& leg = out [residues [idx].second];
+
+        leg = Number::fromScaledValue (
+            leg.scaledValue () + (up ? 1 : -1), decimalPlaces
+        );
+    }
+}
+
+} // namespace fixed
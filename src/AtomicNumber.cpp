@@ -0,0 +1,320 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/AtomicNumber.h"
+#include "Ratio.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+namespace fixed {
+
+static int64_t atomicLoad (const int64_t* value) noexcept
+{
+    return __atomic_load_n (value, __ATOMIC_ACQUIRE);
+}
+
+//
+// Strong compare and swap, on failure expected is set to the value seen.
+//
+static bool atomicCompareExchange (
+    int64_t* value,
+    int64_t& expected,
+    const int64_t desired
+) noexcept
+{
+    return __atomic_compare_exchange_n (
+        value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE
+    );
+}
+
+//
+// GCC only inlines cmpxchg16b for the __sync builtins, the __atomic ones
+// go through libatomic, which may take a lock.  Every x86-64 CPU since the
+// early AMD64 ones has cmpxchg16b.
+//
+__attribute__ ((target ("cx16")))
+static bool atomicCompareExchange (
+    __int128_t* value,
+    __int128_t& expected,
+    const __int128_t desired
+) noexcept
+{
+    const __int128_t prior =
+        __sync_val_compare_and_swap (value, expected, desired);
+
+    if (prior == expected)
+    {
+        return true;
+    }
+
+    expected = prior;
+
+    return false;
+}
+
+//
+// There is no 16 byte load, a compare and swap that writes back what's
+// already there stands in for one.
+//
+static __int128_t atomicLoad (const __int128_t* value) noexcept
+{
+    __int128_t expected = 0;
+
+    atomicCompareExchange (const_cast<__int128_t*> (value), expected, 0);
+
+    return expected;
+}
+
+//
+// A first guess at the value for a compare and swap loop, which needn't be
+// atomic as a torn read just fails the compare and swap, saving the extra
+// cmpxchg16b of a 16 byte atomicLoad ().
+//
+static int64_t guessValue (const int64_t* value) noexcept
+{
+    return __atomic_load_n (value, __ATOMIC_RELAXED);
+}
+
+static __int128_t guessValue (const __int128_t* value) noexcept
+{
+    typedef uint64_t __attribute__ ((may_alias)) Word;
+
+    const Word* words = reinterpret_cast<const Word*> (value);
+
+    const uint64_t low = __atomic_load_n (&words [0], __ATOMIC_RELAXED);
+    const uint64_t high = __atomic_load_n (&words [1], __ATOMIC_RELAXED);
+
+    return static_cast<__int128_t> (
+        static_cast<__uint128_t> (high) << 64 | low
+    );
+}
+
+//
+// The constructor throws for too many decimal places only after this has
+// run, so they are kept within the table meanwhile.
+//
+template <typename T>
+static T scaledLimit (const unsigned int decimalPlaces)
+{
+    const __int128_t power = Ratio::powerOfTen (
+        decimalPlaces > Number::MAX_DECIMAL_PLACES ? 0 : decimalPlaces
+    );
+
+    const __int128_t limit =
+        static_cast<__int128_t> (Number::MAX_INTEGER_VALUE) * power +
+        (power - 1);
+
+    return static_cast<T> (
+        std::min<__int128_t> (limit, std::numeric_limits<T>::max ())
+    );
+}
+
+template <typename T>
+BasicAtomicNumber<T>::BasicAtomicNumber (
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+  : value_ (0),
+    limit_ (scaledLimit<T> (decimalPlaces)),
+    decimalPlaces_ (static_cast<uint8_t> (decimalPlaces)),
+    roundingMode_ (roundingMode)
+{
+    if (decimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "AtomicNumber () Decimal place exceeds max"
+        );
+    }
+}
+
+template <typename T>
+BasicAtomicNumber<T>::BasicAtomicNumber (
+    const Number& initial,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+  : BasicAtomicNumber (decimalPlaces, roundingMode)
+{
+    value_ = toScaled (initial, "AtomicNumber");
+}
+
+template <typename T>
+unsigned int BasicAtomicNumber<T>::decimalPlaces () const noexcept
+{
+    return decimalPlaces_;
+}
+
+template <typename T>
+Rounding::Mode BasicAtomicNumber<T>::roundingMode () const noexcept
+{
+    return roundingMode_;
+}
+
+template <typename T>
+Number BasicAtomicNumber<T>::load () const
+{
+    return toNumber (atomicLoad (&value_));
+}
+
+template <typename T>
+void BasicAtomicNumber<T>::store (const Number& number)
+{
+    exchange (number);
+}
+
+template <typename T>
+Number BasicAtomicNumber<T>::exchange (const Number& number)
+{
+    const T desired = toScaled (number, "exchange");
+
+    T expected = guessValue (&value_);
+
+    while (! atomicCompareExchange (&value_, expected, desired))
+    {
+    }
+
+    return toNumber (expected);
+}
+
+template <typename T>
+Number BasicAtomicNumber<T>::fetch_add (const Number& number)
+{
+    return update (toScaled (number, "fetch_add"), "fetch_add");
+}
+
+template <typename T>
+Number BasicAtomicNumber<T>::fetch_sub (const Number& number)
+{
+    //
+    // The magnitude of a scaled value is at most limit_, so this can't
+    // overflow.
+    //
+    return update (-toScaled (number, "fetch_sub"), "fetch_sub");
+}
+
+template <typename T>
+bool BasicAtomicNumber<T>::compare_exchange (
+    Number& expected,
+    const Number& desired
+)
+{
+    T expectedValue = toScaled (expected, "compare_exchange");
+    const T desiredValue = toScaled (desired, "compare_exchange");
+
+    if (atomicCompareExchange (&value_, expectedValue, desiredValue))
+    {
+        return true;
+    }
+
+    expected = toNumber (expectedValue);
+
+    return false;
+}
+
+template <typename T>
+T BasicAtomicNumber<T>::toScaled (
+    const Number& number,
+    const char* opName
+) const
+{
+    __int128_t value;
+
+    if (number.decimalPlaces () == decimalPlaces_)
+    {
+        value = number.scaledValue ();
+    }
+    else
+    {
+        Number scaled (number);
+
+        scaled.setRoundingMode (roundingMode_);
+        scaled.setDecimalPlaces (decimalPlaces_);
+
+        value = scaled.scaledValue ();
+    }
+
+    if (value > limit_ || value < -limit_)
+    {
+        throw fixed::OverflowException (
+            std::string ("AtomicNumber::") + opName + " () Value too large"
+        );
+    }
+
+    return static_cast<T> (value);
+}
+
+template <typename T>
+Number BasicAtomicNumber<T>::toNumber (const T value) const
+{
+    return Number::fromScaledValue (value, decimalPlaces_);
+}
+
+template <typename T>
+Number BasicAtomicNumber<T>::update (const T delta, const char* opName)
+{
+    T expected = guessValue (&value_);
+
+    //
+    // Whether expected is known to be a value actually held, a guess that
+    // overflows is checked before throwing.
+    //
+    bool seen = false;
+
+    for (;;)
+    {
+        T result;
+
+        if (__builtin_add_overflow (expected, delta, &result) ||
+            result > limit_ ||
+            result < -limit_)
+        {
+            if (seen)
+            {
+                throw fixed::OverflowException (
+                    std::string ("AtomicNumber::") + opName +
+                    " () Result too large"
+                );
+            }
+
+            expected = atomicLoad (&value_);
+            seen = true;
+        }
+        else if (atomicCompareExchange (&value_, expected, result))
+        {
+            return toNumber (expected);
+        }
+        else
+        {
+            seen = true;
+        }
+    }
+}
+
+template class BasicAtomicNumber<int64_t>;
+template class BasicAtomicNumber<__int128_t>;
+
+} // namespace fixed
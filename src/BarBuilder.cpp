@@ -0,0 +1,287 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/BarBuilder.h"
+#include "fixed/Exceptions.h"
+#include "Ratio.h"
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <string>
+
+namespace fixed {
+
+BarBuilder::BarBuilder (
+    const size_t instruments,
+    const int64_t interval,
+    const unsigned int priceDecimalPlaces,
+    const unsigned int sizeDecimalPlaces,
+    const Rounding::Mode roundingMode
+)
+  : states_ (nullptr),
+    instruments_ (instruments),
+    interval_ (interval),
+    priceDecimalPlaces_ (priceDecimalPlaces),
+    sizeDecimalPlaces_ (sizeDecimalPlaces),
+    roundingMode_ (roundingMode)
+{
+    if (! instruments || interval <= 0)
+    {
+        throw fixed::BadValueException (
+            "BarBuilder::BarBuilder () Instruments and interval must be "
+            "positive"
+        );
+    }
+
+    if (instruments - 1 > std::numeric_limits<uint32_t>::max ())
+    {
+        throw fixed::BadValueException (
+            "BarBuilder::BarBuilder () Too many instruments"
+        );
+    }
+
+    if (priceDecimalPlaces > Number::MAX_DECIMAL_PLACES ||
+        sizeDecimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "BarBuilder::BarBuilder () Decimal place exceeds max"
+        );
+    }
+
+    void* memory = nullptr;
+
+    if (posix_memalign (
+            &memory, CACHE_LINE_SIZE, instruments * sizeof (BarState)
+        ))
+    {
+        throw std::bad_alloc ();
+    }
+
+    states_ = static_cast<BarState*> (memory);
+
+    for (size_t idx = 0; idx < instruments; ++idx)
+    {
+        new (states_ + idx) BarState ();
+    }
+}
+
+BarBuilder::~BarBuilder ()
+{
+    std::free (states_);
+}
+
+size_t BarBuilder::add (
+    const uint32_t instrument,
+    const int64_t timestamp,
+    const Number& price,
+    const Number& size,
+    Bar* completed
+)
+{
+    if (instrument >= instruments_)
+    {
+        throw fixed::BadValueException (
+            "BarBuilder::add () Instrument out of range"
+        );
+    }
+
+    BarState& state = states_ [instrument];
+
+    const int64_t start = intervalStart (timestamp);
+    const int64_t scaledPrice = mantissa (price, priceDecimalPlaces_, "Price");
+    const int64_t scaledSize = mantissa (size, sizeDecimalPlaces_, "Size");
+
+    if (state.ticks && start == state.start)
+    {
+        int64_t volume;
+
+        if (__builtin_add_overflow (state.volume, scaledSize, &volume))
+        {
+            throw fixed::OverflowException (
+                "BarBuilder::add () Volume too large"
+            );
+        }
+
+        state.high = scaledPrice > state.high ? scaledPrice : state.high;
+        state.low = scaledPrice < state.low ? scaledPrice : state.low;
+        state.close = scaledPrice;
+        state.volume = volume;
+        ++state.ticks;
+
+        return 0;
+    }
+
+    if (state.ticks && start < state.start)
+    {
+        throw fixed::BadValueException (
+            "BarBuilder::add () Tick before the bar in progress"
+        );
+    }
+
+    size_t written = 0;
+
+    if (state.ticks)
+    {
+        emit (instrument, state, *completed);
+
+        written = 1;
+    }
+
+    state.start = start;
+    state.open = scaledPrice;
+    state.high = scaledPrice;
+    state.low = scaledPrice;
+    state.close = scaledPrice;
+    state.volume = scaledSize;
+    state.ticks = 1;
+
+    return written;
+}
+
+size_t BarBuilder::add (const Tick* ticks, const size_t count, Bar* completed)
+{
+    Bar* next = completed;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const Tick& tick = ticks [idx];
+
+        next += add (
+            tick.instrument, tick.timestamp, tick.price, tick.size, next
+        );
+    }
+
+    return next - completed;
+}
+
+size_t BarBuilder::close (const int64_t now, Bar* completed)
+{
+    size_t written = 0;
+
+    for (size_t idx = 0; idx < instruments_; ++idx)
+    {
+        BarState& state = states_ [idx];
+
+        if (state.ticks &&
+            static_cast<__int128_t> (now) - state.start >= interval_)
+        {
+            emit (idx, state, completed [written++]);
+
+            state.ticks = 0;
+        }
+    }
+
+    return written;
+}
+
+bool BarBuilder::current (const uint32_t instrument, Bar& bar) const
+{
+    if (instrument >= instruments_)
+    {
+        throw fixed::BadValueException (
+            "BarBuilder::current () Instrument out of range"
+        );
+    }
+
+    const BarState& state = states_ [instrument];
+
+    if (! state.ticks)
+    {
+        return false;
+    }
+
+    emit (instrument, state, bar);
+
+    return true;
+}
+
+size_t BarBuilder::instruments () const noexcept
+{
+    return instruments_;
+}
+
+int64_t BarBuilder::interval () const noexcept
+{
+    return interval_;
+}
+
+int64_t BarBuilder::mantissa (
+    const Number& value,
+    const unsigned int decimalPlaces,
+    const char* what
+) const
+{
+    const __int128_t scaled =
+        Ratio::rescale (value, decimalPlaces, roundingMode_);
+
+    if (scaled < std::numeric_limits<int64_t>::min () ||
+        scaled > std::numeric_limits<int64_t>::max ())
+    {
+        throw fixed::OverflowException (
+            std::string ("BarBuilder::add () ") + what + " too large"
+        );
+    }
+
+    return static_cast<int64_t> (scaled);
+}
+
+int64_t BarBuilder::intervalStart (const int64_t timestamp) const
+{
+    const int64_t remainder = timestamp % interval_;
+
+    int64_t start;
+
+    if (__builtin_sub_overflow (
+            timestamp,
+            remainder < 0 ? remainder + interval_ : remainder,
+            &start
+        ))
+    {
+        throw fixed::BadValueException (
+            "BarBuilder::add () Interval starts before the earliest timestamp"
+        );
+    }
+
+    return start;
+}
+
+void BarBuilder::emit (
+    const uint32_t instrument,
+    const BarState& state,
+    Bar& bar
+) const
+{
+    bar.instrument = instrument;
+    bar.start = state.start;
+    bar.ticks = state.ticks;
+    bar.open = Number::fromScaledValue (state.open, priceDecimalPlaces_);
+    bar.high = Number::fromScaledValue (state.high, priceDecimalPlaces_);
+    bar.low = Number::fromScaledValue (state.low, priceDecimalPlaces_);
+    bar.close = Number::fromScaledValue (state.close, priceDecimalPlaces_);
+    bar.volume = Number::fromScaledValue (state.volume, sizeDecimalPlaces_);
+}
+
+} // namespace fixed
@@ -0,0 +1,83 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "ColumnKernels.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace fixed {
+
+//
+// ColumnKernels.inc is compiled once per tier, each copy in its own
+// namespace so they don't clash, and the target pragmas let the compiler
+// use that tier's instructions for the copy.  Nothing shared with the rest
+// of the library is defined inside the pragmas, so no code needing the
+// newer instructions can end up being used on a CPU without them.
+//
+namespace baseline {
+#include "ColumnKernels.inc"
+} // namespace baseline
+
+#pragma GCC push_options
+#pragma GCC target ("sse4.2,popcnt")
+namespace sse4_2 {
+#include "ColumnKernels.inc"
+} // namespace sse4_2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target ("avx2,bmi,bmi2,popcnt")
+namespace avx2 {
+#include "ColumnKernels.inc"
+} // namespace avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target ("avx512f,avx512dq,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt")
+namespace avx512 {
+#include "ColumnKernels.inc"
+} // namespace avx512
+#pragma GCC pop_options
+
+const ColumnKernels& ColumnKernels::get () noexcept
+{
+    static const ColumnKernels* tiers [] = {
+        &baseline::kernels,
+        &sse4_2::kernels,
+        &avx2::kernels,
+        &avx512::kernels
+    };
+
+    static_assert (
+        sizeof (tiers) / sizeof (tiers [0]) ==
+            static_cast<size_t> (CpuDispatch::Tier::TIER_MAX_VAL),
+        "A kernel build is needed for each CpuDispatch::Tier"
+    );
+
+    return *tiers [static_cast<size_t> (CpuDispatch::tier ())];
+}
+
+} // namespace fixed
@@ -0,0 +1,321 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_COLUMN_KERNELS_H
+#define FIXED_COLUMN_KERNELS_H
+
+#include "fixed/ColumnMask.h"
+#include "fixed/CpuDispatch.h"
+#include "fixed/NumberColumn.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fixed {
+
+//
+// The batch kernels behind ColumnOps and Reductions.  They are compiled
+// once for each CpuDispatch::Tier, see ColumnKernels.cpp, and get () hands
+// back those for the tier in use.
+//
+// The operations they apply are shared with the scalar slow paths in
+// ColumnOps, so those give the same results.
+//
+struct ColumnKernels {
+    typedef bool (*AddSubKernel) (
+        const int64_t* lhs,
+        const int64_t* rhs,
+        int64_t* result,
+        uint8_t* flags,
+        const size_t count
+    );
+
+    typedef void (*SelectKernel) (
+        const int64_t* lhs,
+        const int64_t* rhs,
+        int64_t* result,
+        const size_t count
+    );
+
+    typedef void (*UnaryKernel) (
+        const int64_t* values,
+        int64_t* result,
+        const size_t count
+    );
+
+    typedef void (*CompareKernel) (
+        const int64_t* lhs,
+        const int64_t* rhs,
+        uint64_t* words,
+        const size_t count
+    );
+
+    typedef void (*RangeKernel) (
+        const int64_t* values,
+        uint64_t* words,
+        const size_t count,
+        const int64_t low,
+        const int64_t high,
+        const bool empty,
+        const bool invert
+    );
+
+    typedef bool (*IncreaseKernel) (
+        const int64_t* values,
+        int64_t* results,
+        uint8_t* flags,
+        const size_t count,
+        const int64_t multiplier
+    );
+
+    typedef __int128_t (*SumKernel) (const int64_t* values, const size_t count);
+
+    typedef int64_t (*ExtremeKernel) (
+        const int64_t* values,
+        const size_t count
+    );
+
+    typedef size_t (*CountKernel) (const int64_t* values, const size_t count);
+
+    //
+    // The operations, each also gives its kernel from a ColumnKernels.
+    //
+    // The arithmetic is done on uint64_t so that wrapping on overflow is
+    // defined, the sign bit test then recovers the signed overflow condition.
+    //
+    struct Addition {
+        static uint64_t apply (const uint64_t a, const uint64_t b)
+        {
+            return a + b;
+        }
+
+        static uint64_t overflow (
+            const uint64_t a,
+            const uint64_t b,
+            const uint64_t result
+        )
+        {
+            return ((a ^ result) & (b ^ result)) >> 63;
+        }
+
+        static Number scalar (const Number& a, const Number& b)
+        {
+            return a + b;
+        }
+
+        static AddSubKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.add;
+        }
+    };
+
+    struct Subtraction {
+        static uint64_t apply (const uint64_t a, const uint64_t b)
+        {
+            return a - b;
+        }
+
+        static uint64_t overflow (
+            const uint64_t a,
+            const uint64_t b,
+            const uint64_t result
+        )
+        {
+            return ((a ^ b) & (a ^ result)) >> 63;
+        }
+
+        static Number scalar (const Number& a, const Number& b)
+        {
+            return a - b;
+        }
+
+        static AddSubKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.subtract;
+        }
+    };
+
+    struct Minimum {
+        template <typename T>
+        static T apply (const T& a, const T& b)
+        {
+            return b < a ? b : a;
+        }
+
+        static SelectKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.min;
+        }
+    };
+
+    struct Maximum {
+        template <typename T>
+        static T apply (const T& a, const T& b)
+        {
+            return a < b ? b : a;
+        }
+
+        static SelectKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.max;
+        }
+    };
+
+    //
+    // WIDE_MARKER itself never reaches these as a value to be used, the wide
+    // lanes are redone afterwards from the wide value table.
+    //
+    struct Absolute {
+        static int64_t apply (const int64_t a)
+        {
+            return a < 0 ?
+                static_cast<int64_t> (0 - static_cast<uint64_t> (a)) :
+                a;
+        }
+
+        static __int128_t apply (const __int128_t& a)
+        {
+            return a < 0 ? -a : a;
+        }
+
+        static UnaryKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.abs;
+        }
+    };
+
+    struct Negation {
+        static int64_t apply (const int64_t a)
+        {
+            return static_cast<int64_t> (0 - static_cast<uint64_t> (a));
+        }
+
+        static __int128_t apply (const __int128_t& a)
+        {
+            return -a;
+        }
+
+        static UnaryKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.negate;
+        }
+    };
+
+    struct Equal {
+        template <typename T>
+        static bool apply (const T& a, const T& b) { return a == b; }
+
+        static CompareKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.equal;
+        }
+    };
+
+    struct NotEqual {
+        template <typename T>
+        static bool apply (const T& a, const T& b) { return a != b; }
+
+        static CompareKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.notEqual;
+        }
+    };
+
+    struct LessThan {
+        template <typename T>
+        static bool apply (const T& a, const T& b) { return a < b; }
+
+        static CompareKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.lessThan;
+        }
+    };
+
+    struct LessThanOrEqual {
+        template <typename T>
+        static bool apply (const T& a, const T& b) { return a <= b; }
+
+        static CompareKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.lessThanOrEqual;
+        }
+    };
+
+    struct GreaterThan {
+        template <typename T>
+        static bool apply (const T& a, const T& b) { return a > b; }
+
+        static CompareKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.greaterThan;
+        }
+    };
+
+    struct GreaterThanOrEqual {
+        template <typename T>
+        static bool apply (const T& a, const T& b) { return a >= b; }
+
+        static CompareKernel kernel (const ColumnKernels& kernels)
+        {
+            return kernels.greaterThanOrEqual;
+        }
+    };
+
+    AddSubKernel add;
+    AddSubKernel subtract;
+
+    SelectKernel min;
+    SelectKernel max;
+
+    UnaryKernel abs;
+    UnaryKernel negate;
+
+    CompareKernel equal;
+    CompareKernel notEqual;
+    CompareKernel lessThan;
+    CompareKernel lessThanOrEqual;
+    CompareKernel greaterThan;
+    CompareKernel greaterThanOrEqual;
+
+    RangeKernel range;
+
+    IncreaseKernel increase;
+
+    SumKernel sum;
+
+    ExtremeKernel minValue;
+    ExtremeKernel maxValue;
+
+    CountKernel countNonZero;
+
+    //
+    // The kernels for CpuDispatch::tier ().
+    //
+    static const ColumnKernels& get () noexcept;
+};
+
+} // namespace fixed
+
+#endif // FIXED_COLUMN_KERNELS_H
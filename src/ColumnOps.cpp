@@ -0,0 +1,539 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ColumnOps.h"
+#include "ColumnKernels.h"
+#include "Ratio.h"
+#include "RescaleKernel.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+namespace fixed {
+
+//
+// Stand in for an interval with no lower or upper end, any value a column
+// holds lies well inside these.
+//
+static constexpr __int128_t UNBOUNDED_LOW =
+    -(static_cast<__int128_t> (1) << 126);
+
+static constexpr __int128_t UNBOUNDED_HIGH =
+    static_cast<__int128_t> (1) << 126;
+
+NumberColumn ColumnOps::add (const NumberColumn& lhs, const NumberColumn& rhs)
+{
+    return addSub<ColumnKernels::Addition> (lhs, rhs, "add");
+}
+
+NumberColumn ColumnOps::subtract (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs
+)
+{
+    return addSub<ColumnKernels::Subtraction> (lhs, rhs, "subtract");
+}
+
+NumberColumn ColumnOps::min (const NumberColumn& lhs, const NumberColumn& rhs)
+{
+    return select<ColumnKernels::Minimum> (lhs, rhs, "min");
+}
+
+NumberColumn ColumnOps::max (const NumberColumn& lhs, const NumberColumn& rhs)
+{
+    return select<ColumnKernels::Maximum> (lhs, rhs, "max");
+}
+
+NumberColumn ColumnOps::abs (const NumberColumn& column)
+{
+    return unary<ColumnKernels::Absolute> (column);
+}
+
+NumberColumn ColumnOps::negate (const NumberColumn& column)
+{
+    return unary<ColumnKernels::Negation> (column);
+}
+
+ColumnMask ColumnOps::equal (const NumberColumn& lhs, const NumberColumn& rhs)
+{
+    return compare<ColumnKernels::Equal> (lhs, rhs, "equal");
+}
+
+ColumnMask ColumnOps::notEqual (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs
+)
+{
+    return compare<ColumnKernels::NotEqual> (lhs, rhs, "notEqual");
+}
+
+ColumnMask ColumnOps::lessThan (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs
+)
+{
+    return compare<ColumnKernels::LessThan> (lhs, rhs, "lessThan");
+}
+
+ColumnMask ColumnOps::lessThanOrEqual (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs
+)
+{
+    return compare<ColumnKernels::LessThanOrEqual> (
+        lhs, rhs, "lessThanOrEqual"
+    );
+}
+
+ColumnMask ColumnOps::greaterThan (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs
+)
+{
+    return compare<ColumnKernels::GreaterThan> (lhs, rhs, "greaterThan");
+}
+
+ColumnMask ColumnOps::greaterThanOrEqual (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs
+)
+{
+    return compare<ColumnKernels::GreaterThanOrEqual> (
+        lhs, rhs, "greaterThanOrEqual"
+    );
+}
+
+//
+// Each threshold comparison becomes a test of whether the scaled value lies
+// in an interval of integers.  With floor the threshold scaled down and
+// rounded down, value < threshold is value <= floor - 1 when the scaling
+// was exact and value <= floor when it wasn't, and so on.
+//
+ColumnMask ColumnOps::equal (
+    const NumberColumn& column,
+    const Number& threshold
+)
+{
+    bool exact;
+    const __int128_t floor =
+        floorToScale (threshold, column.decimalPlaces (), exact);
+
+    return exact ?
+        inRange (column, floor, floor, false) :
+        inRange (column, 1, 0, false);
+}
+
+ColumnMask ColumnOps::notEqual (
+    const NumberColumn& column,
+    const Number& threshold
+)
+{
+    bool exact;
+    const __int128_t floor =
+        floorToScale (threshold, column.decimalPlaces (), exact);
+
+    return exact ?
+        inRange (column, floor, floor, true) :
+        inRange (column, 1, 0, true);
+}
+
+ColumnMask ColumnOps::lessThan (
+    const NumberColumn& column,
+    const Number& threshold
+)
+{
+    bool exact;
+    const __int128_t floor =
+        floorToScale (threshold, column.decimalPlaces (), exact);
+
+    return inRange (column, floor + (exact ? 0 : 1), UNBOUNDED_HIGH, true);
+}
+
+ColumnMask ColumnOps::lessThanOrEqual (
+    const NumberColumn& column,
+    const Number& threshold
+)
+{
+    bool exact;
+    const __int128_t floor =
+        floorToScale (threshold, column.decimalPlaces (), exact);
+
+    return inRange (column, UNBOUNDED_LOW, floor, false);
+}
+
+ColumnMask ColumnOps::greaterThan (
+    const NumberColumn& column,
+    const Number& threshold
+)
+{
+    bool exact;
+    const __int128_t floor =
+        floorToScale (threshold, column.decimalPlaces (), exact);
+
+    return inRange (column, UNBOUNDED_LOW, floor, true);
+}
+
+ColumnMask ColumnOps::greaterThanOrEqual (
+    const NumberColumn& column,
+    const Number& threshold
+)
+{
+    bool exact;
+    const __int128_t floor =
+        floorToScale (threshold, column.decimalPlaces (), exact);
+
+    return inRange (column, floor + (exact ? 0 : 1), UNBOUNDED_HIGH, false);
+}
+
+ColumnMask ColumnOps::between (
+    const NumberColumn& column,
+    const Number& low,
+    const Number& high
+)
+{
+    bool lowExact;
+    const __int128_t lowFloor =
+        floorToScale (low, column.decimalPlaces (), lowExact);
+
+    bool highExact;
+    const __int128_t highFloor =
+        floorToScale (high, column.decimalPlaces (), highExact);
+
+    return inRange (
+        column, lowFloor + (lowExact ? 0 : 1), highFloor, false
+    );
+}
+
+__int128_t ColumnOps::floorToScale (
+    const Number& threshold,
+    const unsigned int decimalPlaces,
+    bool& exact
+)
+{
+    const __int128_t value = threshold.scaledValue ();
+
+    exact = true;
+
+    if (threshold.decimalPlaces () <= decimalPlaces)
+    {
+        //
+        // Can't overflow, the result is at most MAX_INTEGER_VALUE with
+        // MAX_DECIMAL_PLACES.
+        //
+        return value *
+               Ratio::powerOfTen (decimalPlaces - threshold.decimalPlaces ());
+    }
+
+    const __int128_t divisor =
+        Ratio::powerOfTen (threshold.decimalPlaces () - decimalPlaces);
+
+    const __int128_t quotient = value / divisor;
+    const __int128_t remainder = value % divisor;
+
+    exact = remainder == 0;
+
+    return remainder < 0 ? quotient - 1 : quotient;
+}
+
+ColumnMask ColumnOps::inRange (
+    const NumberColumn& column,
+    const __int128_t low,
+    const __int128_t high,
+    const bool invert
+)
+{
+    //
+    // The kernel only sees 64 bit mantissas, never WIDE_MARKER, so clamping
+    // the bounds to (WIDE_MARKER, int64_t max] changes nothing for them.
+    //
+    const __int128_t clampedLow =
+        std::max<__int128_t> (low, NumberColumn::WIDE_MARKER + 1);
+    const __int128_t clampedHigh =
+        std::min<__int128_t> (high, std::numeric_limits<int64_t>::max ());
+
+    ColumnMask mask (column.size ());
+
+    ColumnKernels::get ().range (
+        column.mantissas (),
+        mask.words (),
+        column.size (),
+        static_cast<int64_t> (clampedLow),
+        static_cast<int64_t> (clampedHigh),
+        clampedLow > clampedHigh,
+        invert
+    );
+
+    for (const auto& wide: column.wideValues_)
+    {
+        mask.set (
+            wide.first,
+            (low <= wide.second && wide.second <= high) != invert
+        );
+    }
+
+    return mask;
+}
+
+NumberColumn ColumnOps::rescale (
+    const NumberColumn& column,
+    const unsigned int decimalPlaces
+)
+{
+    return rescale (column, decimalPlaces, column.roundingMode ());
+}
+
+NumberColumn ColumnOps::rescale (
+    const NumberColumn& column,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    NumberColumn result (decimalPlaces, column.roundingMode ());
+
+    if (decimalPlaces == column.decimalPlaces ())
+    {
+        result.mantissas_ = column.mantissas_;
+        result.wideValues_ = column.wideValues_;
+
+        return result;
+    }
+
+    const size_t count = column.size ();
+
+    result.mantissas_.resize (count);
+
+    //
+    // Lanes the kernels can't do go through Number::setDecimalPlaces (),
+    // which also takes care of its own corner cases for 128 bit values.
+    //
+    auto slowPath = [&] (const size_t idx) {
+        Number number = column [idx];
+
+        number.setRoundingMode (roundingMode);
+        number.setDecimalPlaces (decimalPlaces);
+
+        result.setScaledValue (idx, number.scaledValue ());
+    };
+
+    if (decimalPlaces > column.decimalPlaces ())
+    {
+        std::vector<uint8_t> flags (count);
+
+        const bool anyFlagged = ColumnKernels::get ().increase (
+            column.mantissas (),
+            result.mantissas_.data (),
+            flags.data (),
+            count,
+            static_cast<int64_t> (
+                Ratio::powerOfTen (decimalPlaces - column.decimalPlaces ())
+            )
+        );
+
+        if (anyFlagged)
+        {
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                if (flags [idx])
+                {
+                    slowPath (idx);
+                }
+            }
+        }
+    }
+    else
+    {
+        const DecreaseKernel kernel = decreaseKernelFor (
+            roundingMode, column.decimalPlaces () - decimalPlaces
+        );
+
+        //
+        // WIDE_MARKER lanes produce garbage here, and are redone below.
+        //
+        kernel (column.mantissas (), result.mantissas_.data (), count);
+
+        for (const auto& wide: column.wideValues_)
+        {
+            slowPath (wide.first);
+        }
+    }
+
+    return result;
+}
+
+void ColumnOps::checkCompatible (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs,
+    const std::string& opName
+)
+{
+    if (lhs.size () != rhs.size ())
+    {
+        throw fixed::BadValueException (
+            "ColumnOps::" + opName + " () Column sizes differ"
+        );
+    }
+
+    if (lhs.decimalPlaces () != rhs.decimalPlaces ())
+    {
+        throw fixed::BadValueException (
+            "ColumnOps::" + opName + " () Column decimal places differ"
+        );
+    }
+}
+
+template <typename Op>
+NumberColumn ColumnOps::addSub (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs,
+    const std::string& opName
+)
+{
+    checkCompatible (lhs, rhs, opName);
+
+    const size_t count = lhs.size ();
+
+    NumberColumn result (lhs.decimalPlaces (), lhs.roundingMode ());
+    result.mantissas_.resize (count);
+
+    std::vector<uint8_t> flags (count);
+
+    const bool anyFlagged = Op::kernel (ColumnKernels::get ()) (
+        lhs.mantissas (),
+        rhs.mantissas (),
+        result.mantissas_.data (),
+        flags.data (),
+        count
+    );
+
+    if (anyFlagged)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            if (flags [idx])
+            {
+                result.setScaledValue (
+                    idx, Op::scalar (lhs [idx], rhs [idx]).scaledValue ()
+                );
+            }
+        }
+    }
+
+    return result;
+}
+
+template <typename Op>
+NumberColumn ColumnOps::select (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs,
+    const std::string& opName
+)
+{
+    checkCompatible (lhs, rhs, opName);
+
+    NumberColumn result (lhs.decimalPlaces (), lhs.roundingMode ());
+    result.mantissas_.resize (lhs.size ());
+
+    Op::kernel (ColumnKernels::get ()) (
+        lhs.mantissas (),
+        rhs.mantissas (),
+        result.mantissas_.data (),
+        lhs.size ()
+    );
+
+    for (const auto* wideValues: {&lhs.wideValues_, &rhs.wideValues_})
+    {
+        for (const auto& wide: *wideValues)
+        {
+            result.setScaledValue (
+                wide.first,
+                Op::apply (
+                    lhs.scaledValue (wide.first),
+                    rhs.scaledValue (wide.first)
+                )
+            );
+        }
+    }
+
+    return result;
+}
+
+template <typename Op>
+NumberColumn ColumnOps::unary (const NumberColumn& column)
+{
+    NumberColumn result (column.decimalPlaces (), column.roundingMode ());
+    result.mantissas_.resize (column.size ());
+
+    Op::kernel (ColumnKernels::get ()) (
+        column.mantissas (),
+        result.mantissas_.data (),
+        column.size ()
+    );
+
+    for (const auto& wide: column.wideValues_)
+    {
+        result.setScaledValue (wide.first, Op::apply (wide.second));
+    }
+
+    return result;
+}
+
+template <typename Compare>
+ColumnMask ColumnOps::compare (
+    const NumberColumn& lhs,
+    const NumberColumn& rhs,
+    const std::string& opName
+)
+{
+    checkCompatible (lhs, rhs, opName);
+
+    ColumnMask mask (lhs.size ());
+
+    Compare::kernel (ColumnKernels::get ()) (
+        lhs.mantissas (),
+        rhs.mantissas (),
+        mask.words (),
+        lhs.size ()
+    );
+
+    for (const auto* wideValues: {&lhs.wideValues_, &rhs.wideValues_})
+    {
+        for (const auto& wide: *wideValues)
+        {
+            mask.set (
+                wide.first,
+                Compare::apply (
+                    lhs.scaledValue (wide.first),
+                    rhs.scaledValue (wide.first)
+                )
+            );
+        }
+    }
+
+    return mask;
+}
+
+} // namespace fixed
@@ -0,0 +1,149 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/CpuDispatch.h"
+#include "fixed/Exceptions.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+namespace fixed {
+
+typedef std::underlying_type<CpuDispatch::Tier>::type TierValue;
+
+static const std::vector<std::string> tierStrings = {
+    "baseline",
+    "sse4.2",
+    "avx2",
+    "avx512"
+};
+
+static CpuDispatch::Tier initialTier () noexcept
+{
+    const char* requested = std::getenv ("FIXED_CPU_TIER");
+
+    CpuDispatch::Tier tier;
+
+    if (requested &&
+        CpuDispatch::stringToTier (requested, tier) &&
+        tier < CpuDispatch::supportedTier ())
+    {
+        return tier;
+    }
+
+    return CpuDispatch::supportedTier ();
+}
+
+static std::atomic<TierValue>& currentTier () noexcept
+{
+    static std::atomic<TierValue> current (
+        static_cast<TierValue> (initialTier ())
+    );
+
+    return current;
+}
+
+CpuDispatch::Tier CpuDispatch::tier () noexcept
+{
+    return static_cast<Tier> (currentTier ().load (std::memory_order_relaxed));
+}
+
+CpuDispatch::Tier CpuDispatch::supportedTier () noexcept
+{
+    static const Tier supported = [] () {
+        __builtin_cpu_init ();
+
+        //
+        // Everything each tier's kernels are built with in ColumnKernels.cpp,
+        // the tiers above SSE4_2 also needing what's below them.
+        //
+        const bool sse4_2 = __builtin_cpu_supports ("sse4.2") &&
+                            __builtin_cpu_supports ("popcnt");
+
+        const bool avx2 = sse4_2 &&
+                          __builtin_cpu_supports ("avx2") &&
+                          __builtin_cpu_supports ("bmi") &&
+                          __builtin_cpu_supports ("bmi2");
+
+        if (avx2 &&
+            __builtin_cpu_supports ("avx512f") &&
+            __builtin_cpu_supports ("avx512dq") &&
+            __builtin_cpu_supports ("avx512bw") &&
+            __builtin_cpu_supports ("avx512vl"))
+        {
+            return Tier::AVX512;
+        }
+
+        if (avx2)
+        {
+            return Tier::AVX2;
+        }
+
+        if (sse4_2)
+        {
+            return Tier::SSE4_2;
+        }
+
+        return Tier::BASELINE;
+    } ();
+
+    return supported;
+}
+
+void CpuDispatch::setTier (const Tier tier)
+{
+    if (tier >= Tier::TIER_MAX_VAL || tier > supportedTier ())
+    {
+        throw fixed::BadValueException (
+            "CpuDispatch::setTier () Tier not supported by this CPU"
+        );
+    }
+
+    currentTier ().store (static_cast<TierValue> (tier));
+}
+
+const std::string& CpuDispatch::tierToString (const Tier tier)
+{
+    return tierStrings.at (static_cast<TierValue> (tier));
+}
+
+bool CpuDispatch::stringToTier (const std::string& str, Tier& tier) noexcept
+{
+    for (size_t idx = 0; idx < tierStrings.size (); ++idx)
+    {
+        if (str == tierStrings [idx])
+        {
+            tier = static_cast<Tier> (idx);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace fixed
@@ -0,0 +1,414 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/CrossRates.h"
+#include "fixed/Exceptions.h"
+#include "Ratio.h"
+
+#include <limits>
+#include <string>
+
+namespace fixed {
+
+static __int128_t tooLarge ()
+{
+    throw fixed::OverflowException (
+        "CrossRates::convert () Result too large"
+    );
+}
+
+CrossRates::CrossRates (const size_t currencies, const uint32_t pivot)
+  : pivot_ (pivot)
+{
+    if (! currencies || currencies > MAX_CURRENCIES)
+    {
+        throw fixed::BadValueException (
+            "CrossRates::CrossRates () Currencies out of range"
+        );
+    }
+
+    if (pivot >= currencies)
+    {
+        throw fixed::BadValueException (
+            "CrossRates::CrossRates () Pivot out of range"
+        );
+    }
+
+    const Rate unset = {0, 1, false};
+
+    rates_.assign (currencies, unset);
+    entries_.resize (currencies * currencies);
+
+    rates_ [pivot] = {1, 1, true};
+
+    refresh (pivot, pivot);
+}
+
+size_t CrossRates::currencies () const noexcept
+{
+    return rates_.size ();
+}
+
+uint32_t CrossRates::pivot () const noexcept
+{
+    return pivot_;
+}
+
+bool CrossRates::hasRate (const uint32_t currency) const
+{
+    if (currency >= currencies ())
+    {
+        throw fixed::BadValueException (
+            "CrossRates::hasRate () Currency out of range"
+        );
+    }
+
+    return rates_ [currency].isSet;
+}
+
+void CrossRates::setRate (
+    const uint32_t currency,
+    const Number& rate,
+    const Quote quote
+)
+{
+    if (currency >= currencies ())
+    {
+        throw fixed::BadValueException (
+            "CrossRates::setRate () Currency out of range"
+        );
+    }
+
+    if (currency == pivot_)
+    {
+        throw fixed::BadValueException (
+            "CrossRates::setRate () Pivot rate is fixed"
+        );
+    }
+
+    if (rate.scaledValue () <= 0)
+    {
+        throw fixed::BadValueException (
+            "CrossRates::setRate () Rate must be positive"
+        );
+    }
+
+    const __int128_t scale = Ratio::powerOfTen (rate.decimalPlaces ());
+
+    Rate& updated = rates_ [currency];
+
+    if (quote == Quote::PIVOT_PER_UNIT)
+    {
+        updated = {rate.scaledValue (), scale, true};
+    }
+    else
+    {
+        updated = {scale, rate.scaledValue (), true};
+    }
+
+    for (uint32_t other = 0; other < currencies (); ++other)
+    {
+        if (rates_ [other].isSet)
+        {
+            refresh (currency, other);
+            refresh (other, currency);
+        }
+    }
+}
+
+Number CrossRates::rate (
+    const uint32_t from,
+    const uint32_t to,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    checkCurrency (from, "CrossRates::rate");
+    checkCurrency (to, "CrossRates::rate");
+
+    const Entry& cross = entry (from, to);
+
+    return Ratio::toNumber (
+        cross.numerator,
+        cross.denominator.value (),
+        0,
+        decimalPlaces,
+        roundingMode,
+        "CrossRates::rate"
+    );
+}
+
+Number CrossRates::convert (
+    const Number& amount,
+    const uint32_t from,
+    const uint32_t to,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    checkCurrency (from, "CrossRates::convert");
+    checkCurrency (to, "CrossRates::convert");
+
+    const __int128_t value = convertScaled (
+        amount.scaledValue (),
+        conversion (entry (from, to), amount.decimalPlaces (), decimalPlaces),
+        roundingMode
+    );
+
+    try {
+        return Number::fromScaledValue (value, decimalPlaces);
+    }
+    catch (const fixed::BadValueException&)
+    {
+        throw fixed::OverflowException (
+            "CrossRates::convert () Result too large"
+        );
+    }
+}
+
+NumberColumn CrossRates::convert (
+    const NumberColumn& amounts,
+    const uint32_t from,
+    const uint32_t to,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    checkCurrency (from, "CrossRates::convert");
+    checkCurrency (to, "CrossRates::convert");
+
+    const Conversion prepared = conversion (
+        entry (from, to), amounts.decimalPlaces (), decimalPlaces
+    );
+
+    NumberColumn result (decimalPlaces, roundingMode);
+
+    result.reserve (amounts.size ());
+
+    for (size_t idx = 0; idx < amounts.size (); ++idx)
+    {
+        pushBack (
+            result,
+            convertScaled (amounts.scaledValue (idx), prepared, roundingMode)
+        );
+    }
+
+    return result;
+}
+
+NumberColumn CrossRates::convert (
+    const NumberColumn& amounts,
+    const std::vector<uint32_t>& from,
+    const uint32_t to,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (from.size () != amounts.size ())
+    {
+        throw fixed::BadValueException (
+            "CrossRates::convert () Column sizes differ"
+        );
+    }
+
+    checkCurrency (to, "CrossRates::convert");
+
+    //
+    // A conversion for each currency with a rate, prepared once up front.
+    //
+    std::vector<Conversion> prepared (currencies ());
+
+    for (uint32_t currency = 0; currency < currencies (); ++currency)
+    {
+        if (rates_ [currency].isSet)
+        {
+            prepared [currency] = conversion (
+                entry (currency, to), amounts.decimalPlaces (), decimalPlaces
+            );
+        }
+    }
+
+    NumberColumn result (decimalPlaces, roundingMode);
+
+    result.reserve (amounts.size ());
+
+    for (size_t idx = 0; idx < amounts.size (); ++idx)
+    {
+        checkCurrency (from [idx], "CrossRates::convert");
+
+        pushBack (
+            result,
+            convertScaled (
+                amounts.scaledValue (idx), prepared [from [idx]], roundingMode
+            )
+        );
+    }
+
+    return result;
+}
+
+void CrossRates::checkCurrency (
+    const uint32_t currency,
+    const char* function
+) const
+{
+    if (currency >= currencies ())
+    {
+        throw fixed::BadValueException (
+            std::string (function) + " () Currency out of range"
+        );
+    }
+
+    if (! rates_ [currency].isSet)
+    {
+        throw fixed::BadValueException (
+            std::string (function) + " () No rate for currency"
+        );
+    }
+}
+
+const CrossRates::Entry& CrossRates::entry (
+    const uint32_t from,
+    const uint32_t to
+) const noexcept
+{
+    return entries_ [from * currencies () + to];
+}
+
+void CrossRates::refresh (const uint32_t from, const uint32_t to)
+{
+    //
+    // (from numerator / from denominator) / (to numerator / to denominator)
+    //
+    Entry& cross = entries_ [from * currencies () + to];
+
+    cross.numerator =
+        Int256::multiply (rates_ [from].numerator, rates_ [to].denominator);
+    cross.denominator = Divisor (
+        Int256::multiply (rates_ [from].denominator, rates_ [to].numerator)
+    );
+}
+
+CrossRates::Conversion CrossRates::conversion (
+    const Entry& entry,
+    const unsigned int fromDecimalPlaces,
+    const unsigned int toDecimalPlaces
+) const
+{
+    if (toDecimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "CrossRates::convert () Decimal place exceeds max"
+        );
+    }
+
+    Conversion result = {entry.numerator, 0, entry.denominator};
+
+    try {
+        if (toDecimalPlaces > fromDecimalPlaces)
+        {
+            result.numerator *= Int256 (
+                Ratio::powerOfTen (toDecimalPlaces - fromDecimalPlaces)
+            );
+        }
+        else if (toDecimalPlaces < fromDecimalPlaces)
+        {
+            Int256 denominator = entry.denominator.value ();
+
+            denominator *= Int256 (
+                Ratio::powerOfTen (fromDecimalPlaces - toDecimalPlaces)
+            );
+
+            result.denominator = Divisor (denominator);
+        }
+    }
+    catch (const fixed::OverflowException&)
+    {
+        tooLarge ();
+    }
+
+    __int128_t narrow = 0;
+
+    if (result.numerator.toInt128 (narrow) &&
+        narrow <= std::numeric_limits<uint64_t>::max ())
+    {
+        result.narrowNumerator = static_cast<uint64_t> (narrow);
+    }
+
+    return result;
+}
+
+__int128_t CrossRates::convertScaled (
+    const __int128_t amount,
+    const Conversion& conversion,
+    const Rounding::Mode roundingMode
+)
+{
+    //
+    // A 64 bit amount times a 64 bit numerator can't overflow 128 bits.
+    //
+    if (conversion.narrowNumerator &&
+        conversion.denominator.isNarrow () &&
+        Divisor::fitsInt64 (amount))
+    {
+        __int128_t result = 0;
+
+        if (! conversion.denominator.divideRounded (
+                amount * conversion.narrowNumerator, roundingMode, result
+            ))
+        {
+            return tooLarge ();
+        }
+
+        return result;
+    }
+
+    try {
+        Int256 product (amount);
+
+        product *= conversion.numerator;
+
+        return Int256::divideRounded (
+            product, conversion.denominator.value (), roundingMode
+        );
+    }
+    catch (const fixed::OverflowException&)
+    {
+        return tooLarge ();
+    }
+}
+
+void CrossRates::pushBack (NumberColumn& result, const __int128_t value)
+{
+    try {
+        result.pushBackScaledValue (value);
+    }
+    catch (const fixed::BadValueException&)
+    {
+        tooLarge ();
+    }
+}
+
+} // namespace fixed
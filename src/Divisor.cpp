@@ -0,0 +1,73 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Divisor.h"
+#include "fixed/Exceptions.h"
+#include "fixed/FirstBitSet.h"
+
+#include <limits>
+
+namespace fixed {
+
+Divisor::Divisor () noexcept
+  : value_ (1),
+    normalized_ (static_cast<uint64_t> (1) << 63),
+    reciprocal_ (std::numeric_limits<uint64_t>::max ()),
+    shift_ (63)
+{
+}
+
+Divisor::Divisor (const Int256& value)
+  : value_ (value),
+    normalized_ (0),
+    reciprocal_ (0),
+    shift_ (0)
+{
+    if (value.isNegative () || value.isZero ())
+    {
+        throw fixed::BadValueException (
+            "Divisor::Divisor () Divisor must be positive"
+        );
+    }
+
+    __int128_t narrow = 0;
+
+    if (value.toInt128 (narrow) &&
+        narrow <= std::numeric_limits<uint64_t>::max ())
+    {
+        shift_ = 64 - FirstBitSet () (static_cast<uint64_t> (narrow));
+        normalized_ = static_cast<uint64_t> (narrow) << shift_;
+        reciprocal_ = static_cast<uint64_t> (
+            ~static_cast<__uint128_t> (0) / normalized_
+        );
+    }
+}
+
+const Int256& Divisor::value () const noexcept
+{
+    return value_;
+}
+
+} // namespace fixed
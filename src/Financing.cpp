@@ -0,0 +1,315 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/Financing.h"
+#include "fixed/Parallel.h"
+#include "Ratio.h"
+
+#include <utility>
+#include <vector>
+
+namespace fixed {
+
+static __int128_t tooLarge ()
+{
+    throw fixed::OverflowException (
+        "Financing::accrue () Result too large"
+    );
+}
+
+static uint64_t magnitudeOf (const __int128_t value) noexcept
+{
+    return value < 0 ?
+           -static_cast<uint64_t> (value) :
+           static_cast<uint64_t> (value);
+}
+
+//
+// Sets product to lhs * rhs and returns true if it fits in 128 bits.
+//
+static bool multiplyFits (
+    const __uint128_t lhs,
+    const uint64_t rhs,
+    __uint128_t& product
+) noexcept
+{
+    const __uint128_t high = (lhs >> 64) * rhs;
+
+    if (high >> 64)
+    {
+        return false;
+    }
+
+    product = static_cast<__uint128_t> (static_cast<uint64_t> (lhs)) * rhs;
+
+    return ! __builtin_add_overflow (product, high << 64, &product);
+}
+
+Financing::Financing (
+    const unsigned int basis,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+  : basis_ (basis),
+    decimalPlaces_ (decimalPlaces),
+    roundingMode_ (roundingMode)
+{
+    if (! basis)
+    {
+        throw fixed::BadValueException (
+            "Financing::Financing () Basis must be positive"
+        );
+    }
+
+    if (decimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "Financing::Financing () Decimal place exceeds max"
+        );
+    }
+
+    //
+    // The largest scale is beyond Ratio::powerOfTen (), so those divisors
+    // are built in two steps.
+    //
+    const unsigned int maxPower = 2 * Number::MAX_DECIMAL_PLACES;
+
+    for (unsigned int scale = 0; scale < SCALES; ++scale)
+    {
+        Int256 divisor (static_cast<__int128_t> (basis));
+
+        scales_ [scale].multiplier = 1;
+
+        if (scale < decimalPlaces)
+        {
+            scales_ [scale].multiplier = static_cast<uint64_t> (
+                Ratio::powerOfTen (decimalPlaces - scale)
+            );
+        }
+        else if (scale - decimalPlaces > maxPower)
+        {
+            divisor *= Int256 (Ratio::powerOfTen (maxPower));
+            divisor *= Int256 (
+                Ratio::powerOfTen (scale - decimalPlaces - maxPower)
+            );
+        }
+        else
+        {
+            divisor *= Int256 (Ratio::powerOfTen (scale - decimalPlaces));
+        }
+
+        scales_ [scale].divisor = Divisor (divisor);
+    }
+}
+
+unsigned int Financing::basis () const noexcept
+{
+    return basis_;
+}
+
+unsigned int Financing::decimalPlaces () const noexcept
+{
+    return decimalPlaces_;
+}
+
+Rounding::Mode Financing::roundingMode () const noexcept
+{
+    return roundingMode_;
+}
+
+Number Financing::accrue (
+    const Number& units,
+    const Number& price,
+    const Number& rate,
+    const unsigned int days
+) const
+{
+    const __int128_t value = accrueScaled (
+        units.scaledValue (),
+        price.scaledValue (),
+        rate.scaledValue (),
+        days,
+        scales_ [
+            units.decimalPlaces () +
+            price.decimalPlaces () +
+            rate.decimalPlaces ()
+        ]
+    );
+
+    try {
+        return Number::fromScaledValue (value, decimalPlaces_);
+    }
+    catch (const fixed::BadValueException&)
+    {
+        throw fixed::OverflowException (
+            "Financing::accrue () Result too large"
+        );
+    }
+}
+
+NumberColumn Financing::accrue (
+    const NumberColumn& units,
+    const NumberColumn& prices,
+    const NumberColumn& rates,
+    const unsigned int days,
+    ThreadPool& pool
+) const
+{
+    if (units.size () != prices.size () || units.size () != rates.size ())
+    {
+        throw fixed::BadValueException (
+            "Financing::accrue () Column sizes differ"
+        );
+    }
+
+    const Scale& scale = scales_ [
+        units.decimalPlaces () +
+        prices.decimalPlaces () +
+        rates.decimalPlaces ()
+    ];
+
+    const size_t count = units.size ();
+
+    NumberColumn result (decimalPlaces_, roundingMode_);
+    result.mantissas_.resize (count);
+
+    //
+    // Results too wide for a mantissa are rare, so each chunk notes its own
+    // and they go in the wide value table once the threads are done.
+    //
+    std::vector<std::vector<std::pair<size_t, __int128_t>>> wideValues (
+        parallel::chunkCount (count)
+    );
+
+    pool.run (wideValues.size (), [&] (const size_t chunk) {
+        const size_t begin = chunk * parallel::CHUNK_SIZE;
+        const size_t end = count - begin < parallel::CHUNK_SIZE ?
+                           count :
+                           begin + parallel::CHUNK_SIZE;
+
+        int64_t* mantissas = result.mantissas_.data ();
+
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            const __int128_t value = accrueScaled (
+                units.scaledValue (idx),
+                prices.scaledValue (idx),
+                rates.scaledValue (idx),
+                days,
+                scale
+            );
+
+            if (NumberColumn::fitsMantissa (value))
+            {
+                mantissas [idx] = static_cast<int64_t> (value);
+            }
+            else
+            {
+                mantissas [idx] = NumberColumn::WIDE_MARKER;
+                wideValues [chunk].emplace_back (idx, value);
+            }
+        }
+    });
+
+    for (const auto& chunkValues: wideValues)
+    {
+        for (const auto& wide: chunkValues)
+        {
+            try {
+                result.storeWide (wide.first, wide.second);
+            }
+            catch (const fixed::BadValueException&)
+            {
+                tooLarge ();
+            }
+        }
+    }
+
+    return result;
+}
+
+__int128_t Financing::accrueScaled (
+    const __int128_t units,
+    const __int128_t price,
+    const __int128_t rate,
+    const unsigned int days,
+    const Scale& scale
+) const
+{
+    //
+    // The magnitude of the product when it fits in 128 bits, units * price
+    // being unable to overflow and the other factors usually fitting in 64
+    // bits between them.
+    //
+    uint64_t factor = 0;
+    __uint128_t product = 0;
+
+    if (scale.divisor.isNarrow () &&
+        Divisor::fitsInt64 (units) &&
+        Divisor::fitsInt64 (price) &&
+        Divisor::fitsInt64 (rate) &&
+        ! __builtin_mul_overflow (magnitudeOf (rate), days, &factor) &&
+        ! __builtin_mul_overflow (factor, scale.multiplier, &factor) &&
+        multiplyFits (
+            static_cast<__uint128_t> (magnitudeOf (units)) *
+                magnitudeOf (price),
+            factor,
+            product
+        ))
+    {
+        __int128_t result = 0;
+
+        if (! scale.divisor.divideRounded (
+                product,
+                ((units < 0) != (price < 0)) != (rate < 0),
+                roundingMode_,
+                result
+            ))
+        {
+            return tooLarge ();
+        }
+
+        return result;
+    }
+
+    try {
+        Int256 wideProduct = Int256::multiply (units, price);
+
+        wideProduct *= Int256 (rate);
+        wideProduct *= Int256 (static_cast<__int128_t> (days));
+        wideProduct *= Int256 (static_cast<__int128_t> (scale.multiplier));
+
+        return Int256::divideRounded (
+            wideProduct, scale.divisor.value (), roundingMode_
+        );
+    }
+    catch (const fixed::OverflowException&)
+    {
+        return tooLarge ();
+    }
+}
+
+} // namespace fixed
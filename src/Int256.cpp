@@ -0,0 +1,472 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/Int256.h"
+
+#include <algorithm>
+
+namespace fixed {
+
+//
+// Unsigned 256 bit magnitudes, least significant word first, for the
+// multiplication and division, which are done on magnitudes and signed
+// afterwards.
+//
+struct Magnitude {
+    uint64_t words [4];
+};
+
+static bool isNegativeWords (const uint64_t* words) noexcept
+{
+    return static_cast<int64_t> (words [3]) < 0;
+}
+
+static void negateWords (uint64_t* words) noexcept
+{
+    uint64_t carry = 1;
+
+    for (unsigned int idx = 0; idx < 4; ++idx)
+    {
+        const uint64_t inverted = ~words [idx];
+
+        words [idx] = inverted + carry;
+        carry = carry && ! words [idx];
+    }
+}
+
+static Magnitude magnitude (const uint64_t* words) noexcept
+{
+    Magnitude result;
+
+    std::copy (words, words + 4, result.words);
+
+    if (isNegativeWords (words))
+    {
+        negateWords (result.words);
+    }
+
+    return result;
+}
+
+static int compareMagnitudes (const Magnitude& lhs, const Magnitude& rhs)
+{
+    for (unsigned int idx = 4; idx-- > 0; )
+    {
+        if (lhs.words [idx] != rhs.words [idx])
+        {
+            return lhs.words [idx] < rhs.words [idx] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+static void subtractMagnitude (Magnitude& lhs, const Magnitude& rhs) noexcept
+{
+    uint64_t borrow = 0;
+
+    for (unsigned int idx = 0; idx < 4; ++idx)
+    {
+        const uint64_t word = lhs.words [idx];
+        const uint64_t result = word - rhs.words [idx] - borrow;
+
+        borrow = word < rhs.words [idx] ||
+                 (word == rhs.words [idx] && borrow);
+
+        lhs.words [idx] = result;
+    }
+}
+
+static unsigned int significantBits (const Magnitude& value) noexcept
+{
+    for (unsigned int idx = 4; idx-- > 0; )
+    {
+        if (value.words [idx])
+        {
+            return idx * 64 + 64 - __builtin_clzll (value.words [idx]);
+        }
+    }
+
+    return 0;
+}
+
+//
+// quotient = numerator / denominator and remainder what's left over, with
+// native division when the operands allow and a bit at a time otherwise.
+//
+static void divideMagnitudes (
+    const Magnitude& numerator,
+    const Magnitude& denominator,
+    Magnitude& quotient,
+    Magnitude& remainder
+) noexcept
+{
+    quotient = Magnitude ();
+    remainder = Magnitude ();
+
+    if (significantBits (numerator) <= 128)
+    {
+        const __uint128_t num =
+            static_cast<__uint128_t> (numerator.words [1]) << 64 |
+            numerator.words [0];
+        const __uint128_t den =
+            static_cast<__uint128_t> (denominator.words [1]) << 64 |
+            denominator.words [0];
+
+        if (significantBits (denominator) > 128)
+        {
+            remainder = numerator;
+
+            return;
+        }
+
+        const __uint128_t quot = num / den;
+        const __uint128_t rem = num % den;
+
+        quotient.words [0] = static_cast<uint64_t> (quot);
+        quotient.words [1] = static_cast<uint64_t> (quot >> 64);
+        remainder.words [0] = static_cast<uint64_t> (rem);
+        remainder.words [1] = static_cast<uint64_t> (rem >> 64);
+
+        return;
+    }
+
+    if (significantBits (denominator) <= 64)
+    {
+        const uint64_t den = denominator.words [0];
+
+        __uint128_t rem = 0;
+
+        for (unsigned int idx = 4; idx-- > 0; )
+        {
+            const __uint128_t current = rem << 64 | numerator.words [idx];
+
+            quotient.words [idx] = static_cast<uint64_t> (current / den);
+            rem = current % den;
+        }
+
+        remainder.words [0] = static_cast<uint64_t> (rem);
+
+        return;
+    }
+
+    for (unsigned int bit = significantBits (numerator); bit-- > 0; )
+    {
+        for (unsigned int idx = 4; idx-- > 1; )
+        {
+            remainder.words [idx] =
+                remainder.words [idx] << 1 | remainder.words [idx - 1] >> 63;
+        }
+
+        remainder.words [0] =
+            remainder.words [0] << 1 |
+            ((numerator.words [bit / 64] >> (bit % 64)) & 1);
+
+        if (compareMagnitudes (remainder, denominator) >= 0)
+        {
+            subtractMagnitude (remainder, denominator);
+            quotient.words [bit / 64] |= uint64_t (1) << (bit % 64);
+        }
+    }
+}
+
+Int256::Int256 () noexcept
+  : words_ {0, 0, 0, 0}
+{
+}
+
+Int256::Int256 (const __int128_t value) noexcept
+{
+    const uint64_t fill = value < 0 ? ~uint64_t (0) : 0;
+
+    words_ [0] = static_cast<uint64_t> (value);
+    words_ [1] = static_cast<uint64_t> (static_cast<__uint128_t> (value) >> 64);
+    words_ [2] = fill;
+    words_ [3] = fill;
+}
+
+Int256::Int256 (const int64_t high, const __uint128_t low) noexcept
+{
+    words_ [0] = static_cast<uint64_t> (low);
+    words_ [1] = static_cast<uint64_t> (low >> 64);
+    words_ [2] = static_cast<uint64_t> (high);
+    words_ [3] = high < 0 ? ~uint64_t (0) : 0;
+}
+
+Int256 Int256::multiply (const __int128_t lhs, const __int128_t rhs) noexcept
+{
+    const __uint128_t lhsMagnitude =
+        lhs < 0 ? -static_cast<__uint128_t> (lhs) : lhs;
+    const __uint128_t rhsMagnitude =
+        rhs < 0 ? -static_cast<__uint128_t> (rhs) : rhs;
+
+    const uint64_t lhsWords [2] = {
+        static_cast<uint64_t> (lhsMagnitude),
+        static_cast<uint64_t> (lhsMagnitude >> 64)
+    };
+    const uint64_t rhsWords [2] = {
+        static_cast<uint64_t> (rhsMagnitude),
+        static_cast<uint64_t> (rhsMagnitude >> 64)
+    };
+
+    Int256 product;
+
+    for (unsigned int lhsIdx = 0; lhsIdx < 2; ++lhsIdx)
+    {
+        uint64_t carry = 0;
+
+        for (unsigned int rhsIdx = 0; rhsIdx < 2; ++rhsIdx)
+        {
+            const __uint128_t partial =
+                static_cast<__uint128_t> (lhsWords [lhsIdx]) *
+                    rhsWords [rhsIdx] +
+                product.words_ [lhsIdx + rhsIdx] + carry;
+
+            product.words_ [lhsIdx + rhsIdx] = static_cast<uint64_t> (partial);
+            carry = static_cast<uint64_t> (partial >> 64);
+        }
+
+        product.words_ [lhsIdx + 2] = carry;
+    }
+
+    //
+    // The magnitude is at most 2^254, so negating it can't overflow.
+    //
+    if ((lhs < 0) != (rhs < 0))
+    {
+        negateWords (product.words_);
+    }
+
+    return product;
+}
+
+Int256& Int256::operator+= (const Int256& rhs)
+{
+    const bool lhsNegative = isNegative ();
+    const bool rhsNegative = rhs.isNegative ();
+
+    uint64_t carry = 0;
+
+    for (unsigned int idx = 0; idx < WORDS; ++idx)
+    {
+        const __uint128_t sum =
+            static_cast<__uint128_t> (words_ [idx]) + rhs.words_ [idx] + carry;
+
+        words_ [idx] = static_cast<uint64_t> (sum);
+        carry = static_cast<uint64_t> (sum >> 64);
+    }
+
+    if (lhsNegative == rhsNegative && isNegative () != lhsNegative)
+    {
+        throw fixed::OverflowException ("Int256::operator+= () Overflow");
+    }
+
+    return *this;
+}
+
+Int256& Int256::operator-= (const Int256& rhs)
+{
+    const bool lhsNegative = isNegative ();
+    const bool rhsNegative = rhs.isNegative ();
+
+    uint64_t borrow = 0;
+
+    for (unsigned int idx = 0; idx < WORDS; ++idx)
+    {
+        const uint64_t word = words_ [idx];
+
+        words_ [idx] = word - rhs.words_ [idx] - borrow;
+        borrow = word < rhs.words_ [idx] ||
+                 (word == rhs.words_ [idx] && borrow);
+    }
+
+    if (lhsNegative != rhsNegative && isNegative () != lhsNegative)
+    {
+        throw fixed::OverflowException ("Int256::operator-= () Overflow");
+    }
+
+    return *this;
+}
+
+Int256& Int256::operator*= (const Int256& rhs)
+{
+    const Magnitude lhsMagnitude = magnitude (words_);
+    const Magnitude rhsMagnitude = magnitude (rhs.words_);
+    const bool negative = isNegative () != rhs.isNegative ();
+
+    uint64_t product [2 * WORDS] = {};
+
+    for (unsigned int lhsIdx = 0; lhsIdx < WORDS; ++lhsIdx)
+    {
+        uint64_t carry = 0;
+
+        for (unsigned int rhsIdx = 0; rhsIdx < WORDS; ++rhsIdx)
+        {
+            const __uint128_t partial =
+                static_cast<__uint128_t> (lhsMagnitude.words [lhsIdx]) *
+                    rhsMagnitude.words [rhsIdx] +
+                product [lhsIdx + rhsIdx] + carry;
+
+            product [lhsIdx + rhsIdx] = static_cast<uint64_t> (partial);
+            carry = static_cast<uint64_t> (partial >> 64);
+        }
+
+        product [lhsIdx + WORDS] = carry;
+    }
+
+    if (product [4] || product [5] || product [6] || product [7] ||
+        isNegativeWords (product))
+    {
+        throw fixed::OverflowException ("Int256::operator*= () Overflow");
+    }
+
+    std::copy (product, product + WORDS, words_);
+
+    if (negative)
+    {
+        negateWords (words_);
+    }
+
+    return *this;
+}
+
+bool Int256::isNegative () const noexcept
+{
+    return isNegativeWords (words_);
+}
+
+bool Int256::isZero () const noexcept
+{
+    return ! (words_ [0] | words_ [1] | words_ [2] | words_ [3]);
+}
+
+bool Int256::toInt128 (__int128_t& value) const noexcept
+{
+    value = static_cast<__int128_t> (
+        static_cast<__uint128_t> (words_ [1]) << 64 | words_ [0]
+    );
+
+    const uint64_t fill = value < 0 ? ~uint64_t (0) : 0;
+
+    return words_ [2] == fill && words_ [3] == fill;
+}
+
+__int128_t Int256::divideRounded (
+    const Int256& numerator,
+    const Int256& denominator,
+    const Rounding::Mode roundingMode
+)
+{
+    if (denominator.isZero ())
+    {
+        throw fixed::DivideByZeroException (
+            "Int256::divideRounded () Divide by zero"
+        );
+    }
+
+    Magnitude quotient;
+    Magnitude remainder;
+
+    const Magnitude denominatorMagnitude = magnitude (denominator.words_);
+
+    divideMagnitudes (
+        magnitude (numerator.words_),
+        denominatorMagnitude,
+        quotient,
+        remainder
+    );
+
+    if (significantBits (quotient) > 127)
+    {
+        throw fixed::OverflowException (
+            "Int256::divideRounded () Result too large"
+        );
+    }
+
+    const bool negative =
+        ! numerator.isZero () &&
+        numerator.isNegative () != denominator.isNegative ();
+
+    const __int128_t truncated = static_cast<__int128_t> (
+        static_cast<__uint128_t> (quotient.words [1]) << 64 |
+        quotient.words [0]
+    );
+
+    //
+    // Rounding only compares the remainder against half the denominator,
+    // twice the remainder against the denominator is mapped on to
+    // 1, 2 or 3 against a half range of 2 to stay within 128 bits.
+    //
+    __int128_t fraction = 0;
+
+    if (significantBits (remainder))
+    {
+        Magnitude doubled = remainder;
+
+        for (unsigned int idx = 4; idx-- > 1; )
+        {
+            doubled.words [idx] =
+                doubled.words [idx] << 1 | doubled.words [idx - 1] >> 63;
+        }
+
+        doubled.words [0] <<= 1;
+
+        fraction = 2 + compareMagnitudes (doubled, denominatorMagnitude);
+    }
+
+    return Rounding::round<__int128_t> (
+        roundingMode,
+        negative ? -truncated : truncated,
+        fraction,
+        2,
+        negative
+    );
+}
+
+bool operator== (const Int256& lhs, const Int256& rhs) noexcept
+{
+    return std::equal (lhs.words_, lhs.words_ + Int256::WORDS, rhs.words_);
+}
+
+bool operator< (const Int256& lhs, const Int256& rhs) noexcept
+{
+    if (lhs.isNegative () != rhs.isNegative ())
+    {
+        return lhs.isNegative ();
+    }
+
+    for (unsigned int idx = Int256::WORDS; idx-- > 0; )
+    {
+        if (lhs.words_ [idx] != rhs.words_ [idx])
+        {
+            return lhs.words_ [idx] < rhs.words_ [idx];
+        }
+    }
+
+    return false;
+}
+
+} // namespace fixed
@@ -0,0 +1,1092 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/FirstBitSet.h"
+#include "fixed/Int256.h"
+#include "fixed/Math.h"
+#include "Ratio.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace fixed {
+
+//
+// Table entries and series terms are binary fixed point with FRACTION_BITS
+// bits after the point, ONE being 1.0.  They are all below 2, so a product
+// of two fits in 256 bits.
+//
+static const unsigned int FRACTION_BITS = 124;
+
+static const __uint128_t ONE = static_cast<__uint128_t> (1) << FRACTION_BITS;
+
+//
+// Arguments to exp () and results of log () have ARGUMENT_BITS bits after
+// the point, leaving room for magnitudes up to ARGUMENT_LIMIT.  Past that
+// exp () is far outside the range of a Number either way.
+//
+static const unsigned int ARGUMENT_BITS = 120;
+
+static const unsigned int ARGUMENT_DROP = FRACTION_BITS - ARGUMENT_BITS;
+
+static const __uint128_t ARGUMENT_LIMIT =
+    static_cast<__uint128_t> (64) << ARGUMENT_BITS;
+
+//
+// exp (r) is taken as exp (j / 64) * exp (r - j / 64) and log (m) as
+// log (1 + j / 64) + log (m * 64 / (64 + j)), leaving series in values
+// under 1 / 64 that converge in the degrees below.
+//
+static const unsigned int TABLE_BITS = 6;
+
+static const unsigned int TABLE_SIZE = 1 << TABLE_BITS;
+
+static const unsigned int TABLE_SHIFT = FRACTION_BITS - TABLE_BITS;
+
+static const unsigned int EXP_DEGREE = 14;
+
+static const unsigned int LOG_DEGREE = 20;
+
+//
+// A result within 2^-SNAP_BITS of a rounding boundary, relative to its size,
+// and within 2^-SNAP_LIMIT of the last place, is rounded as if it were on
+// the boundary.
+//
+static const unsigned int SNAP_BITS = 104;
+
+static const unsigned int SNAP_LIMIT = 16;
+
+namespace {
+
+struct Wide {
+    __uint128_t high;
+    __uint128_t low;
+};
+
+struct Tables {
+    Tables () noexcept;
+
+    __uint128_t ln2;
+
+    // 1 / n and 1 / n!
+    __uint128_t inverses [LOG_DEGREE + 1];
+    __uint128_t inverseFactorials [EXP_DEGREE + 1];
+
+    // exp (j / 64), log (1 + j / 64) and 64 / (64 + j) rounded up.
+    __uint128_t exponentials [TABLE_SIZE];
+    __uint128_t logarithms [TABLE_SIZE];
+    __uint128_t reciprocals [TABLE_SIZE];
+};
+
+} // namespace
+
+static Wide multiplyWide (
+    const __uint128_t lhs,
+    const __uint128_t rhs
+) noexcept
+{
+    const uint64_t lhsLow = static_cast<uint64_t> (lhs);
+    const uint64_t lhsHigh = static_cast<uint64_t> (lhs >> 64);
+    const uint64_t rhsLow = static_cast<uint64_t> (rhs);
+    const uint64_t rhsHigh = static_cast<uint64_t> (rhs >> 64);
+
+    const __uint128_t lowLow = static_cast<__uint128_t> (lhsLow) * rhsLow;
+    const __uint128_t lowHigh = static_cast<__uint128_t> (lhsLow) * rhsHigh;
+    const __uint128_t highLow = static_cast<__uint128_t> (lhsHigh) * rhsLow;
+    const __uint128_t highHigh = static_cast<__uint128_t> (lhsHigh) * rhsHigh;
+
+    const __uint128_t middle =
+        (lowLow >> 64) +
+        static_cast<uint64_t> (lowHigh) +
+        static_cast<uint64_t> (highLow);
+
+    Wide product;
+
+    product.low = middle << 64 | static_cast<uint64_t> (lowLow);
+    product.high =
+        highHigh + (lowHigh >> 64) + (highLow >> 64) + (middle >> 64);
+
+    return product;
+}
+
+//
+// The low 128 bits of value >> shift.
+//
+static __uint128_t shiftRight (
+    const Wide& value,
+    const unsigned int shift
+) noexcept
+{
+    if (shift == 0)
+    {
+        return value.low;
+    }
+
+    if (shift < 128)
+    {
+        return value.high << (128 - shift) | value.low >> shift;
+    }
+
+    return shift < 256 ? value.high >> (shift - 128) : 0;
+}
+
+static __uint128_t multiplyShift (
+    const __uint128_t lhs,
+    const __uint128_t rhs,
+    const unsigned int shift = FRACTION_BITS
+) noexcept
+{
+    return shiftRight (multiplyWide (lhs, rhs), shift);
+}
+
+static Wide powerOfTwo (const unsigned int exponent) noexcept
+{
+    Wide value = {0, 0};
+
+    if (exponent < 128)
+    {
+        value.low = static_cast<__uint128_t> (1) << exponent;
+    }
+    else
+    {
+        value.high = static_cast<__uint128_t> (1) << (exponent - 128);
+    }
+
+    return value;
+}
+
+static bool lessOrEqual (const Wide& lhs, const Wide& rhs) noexcept
+{
+    return lhs.high != rhs.high ? lhs.high < rhs.high : lhs.low <= rhs.low;
+}
+
+//
+// lhs - rhs, lhs must not be less than rhs.
+//
+static Wide subtract (const Wide& lhs, const Wide& rhs) noexcept
+{
+    Wide difference;
+
+    difference.low = lhs.low - rhs.low;
+    difference.high = lhs.high - rhs.high - (lhs.low < rhs.low ? 1 : 0);
+
+    return difference;
+}
+
+//
+// floor (remainder * 2^bits / divisor) for remainder < divisor, produced 64
+// bits at a time.  The result must fit in 128 bits.
+//
+static __uint128_t fractionBits (
+    __uint128_t remainder,
+    const uint64_t divisor,
+    unsigned int bits
+) noexcept
+{
+    __uint128_t result = 0;
+
+    while (bits > 0)
+    {
+        const unsigned int chunk = bits < 64 ? bits : 64;
+        const __uint128_t shifted = remainder << chunk;
+        const __uint128_t quotient = shifted / divisor;
+
+        result = result << chunk | quotient;
+        remainder = shifted - quotient * divisor;
+        bits -= chunk;
+    }
+
+    return result;
+}
+
+//
+// 2 * atanh (numerator / denominator), for numerator < denominator.  Only
+// used to build the tables, so it divides freely.
+//
+static __uint128_t twiceAtanh (
+    const uint64_t numerator,
+    const uint64_t denominator
+) noexcept
+{
+    const __uint128_t ratio =
+        fractionBits (numerator, denominator, FRACTION_BITS);
+    const __uint128_t ratioSquared = multiplyShift (ratio, ratio);
+
+    __uint128_t sum = 0;
+    __uint128_t power = ratio;
+
+    for (unsigned int idx = 1; power != 0; idx += 2)
+    {
+        sum += power / idx;
+        power = multiplyShift (power, ratioSquared);
+    }
+
+    return 2 * sum;
+}
+
+Tables::Tables () noexcept
+{
+    ln2 = twiceAtanh (1, 3);
+
+    inverses [0] = 0;
+    inverseFactorials [0] = ONE;
+
+    for (unsigned int idx = 1; idx <= LOG_DEGREE; ++idx)
+    {
+        inverses [idx] = ONE / idx;
+    }
+
+    for (unsigned int idx = 1; idx <= EXP_DEGREE; ++idx)
+    {
+        inverseFactorials [idx] = inverseFactorials [idx - 1] / idx;
+    }
+
+    for (unsigned int idx = 0; idx < TABLE_SIZE; ++idx)
+    {
+        const __uint128_t argument =
+            static_cast<__uint128_t> (idx) << TABLE_SHIFT;
+
+        __uint128_t term = ONE;
+        __uint128_t sum = ONE;
+
+        for (unsigned int power = 1; term != 0; ++power)
+        {
+            term = multiplyShift (term, argument) / power;
+            sum += term;
+        }
+
+        exponentials [idx] = sum;
+
+        //
+        // log (1 + j / 64) = 2 * atanh (j / (128 + j))
+        //
+        logarithms [idx] = twiceAtanh (idx, 2 * TABLE_SIZE + idx);
+
+        reciprocals [idx] = idx == 0 ? ONE :
+            fractionBits (TABLE_SIZE, TABLE_SIZE + idx, FRACTION_BITS) + 1;
+    }
+}
+
+static const Tables& tables () noexcept
+{
+    static const Tables instance;
+
+    return instance;
+}
+
+static void checkDecimalPlaces (
+    const unsigned int decimalPlaces,
+    const char* function
+)
+{
+    if (decimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            std::string (function) + " () Decimal place exceeds max"
+        );
+    }
+}
+
+//
+// Always throws, returning a Number only so callers can return the call.
+//
+static Number tooLarge (const char* function)
+{
+    throw fixed::OverflowException (
+        std::string (function) + " () Result too large"
+    );
+}
+
+//
+// A result too small to show at decimalPlaces, rounded as a value just
+// above zero in magnitude would be.
+//
+static Number tooSmall (
+    const bool negative,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    return Number::fromScaledValue (
+        Rounding::round<__int128_t> (roundingMode, 0, 1, 2, negative),
+        decimalPlaces
+    );
+}
+
+//
+// mantissa / 2^shift, negated if negative, rounded to a Number with
+// decimalPlaces.  The remainder is compared against the half way point as
+// Int256::divideRounded () does, after snapping anything within the error
+// of the calculation on to zero, the half way point or the next unit.
+//
+static Number roundScaled (
+    const __uint128_t mantissa,
+    const unsigned int shift,
+    const bool negative,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode,
+    const char* function
+)
+{
+    const Wide product = multiplyWide (
+        mantissa,
+        static_cast<__uint128_t> (Ratio::powerOfTen (decimalPlaces))
+    );
+
+    if (shift >= 256)
+    {
+        return tooSmall (negative, decimalPlaces, roundingMode);
+    }
+
+    if (shift < 128 && product.high >> shift != 0)
+    {
+        return tooLarge (function);
+    }
+
+    __uint128_t quotient = shiftRight (product, shift);
+
+    if (quotient >> 126 != 0)
+    {
+        return tooLarge (function);
+    }
+
+    Wide remainder = {0, 0};
+
+    if (shift < 128)
+    {
+        remainder.low =
+            product.low & ((static_cast<__uint128_t> (1) << shift) - 1);
+    }
+    else
+    {
+        const unsigned int highBits = shift - 128;
+
+        remainder.high = highBits == 0 ? 0 :
+            product.high & ((static_cast<__uint128_t> (1) << highBits) - 1);
+        remainder.low = product.low;
+    }
+
+    __int128_t fraction = 0;
+
+    if (remainder.high != 0 || remainder.low != 0)
+    {
+        const Wide unit = powerOfTwo (shift);
+        const Wide half = powerOfTwo (shift - 1);
+
+        Wide window = {0, 0};
+
+        if (shift >= SNAP_LIMIT)
+        {
+            const unsigned int productBits = product.high != 0 ?
+                128 + FirstBitSet () (product.high) :
+                FirstBitSet () (product.low);
+
+            int windowBits =
+                static_cast<int> (productBits) - static_cast<int> (SNAP_BITS);
+
+            windowBits = windowBits < 0 ? 0 : windowBits;
+            windowBits =
+                windowBits > static_cast<int> (shift - SNAP_LIMIT) ?
+                    shift - SNAP_LIMIT : windowBits;
+
+            window = powerOfTwo (windowBits);
+        }
+
+        const bool belowHalf = lessOrEqual (remainder, half);
+
+        if (lessOrEqual (remainder, window))
+        {
+            fraction = 0;
+        }
+        else if (lessOrEqual (subtract (unit, remainder), window))
+        {
+            ++quotient;
+            fraction = 0;
+        }
+        else if (
+            lessOrEqual (
+                belowHalf ?
+                    subtract (half, remainder) :
+                    subtract (remainder, half),
+                window
+            )
+        )
+        {
+            fraction = 2;
+        }
+        else
+        {
+            fraction = belowHalf ? 1 : 3;
+        }
+    }
+
+    const __int128_t truncated = static_cast<__int128_t> (quotient);
+
+    try {
+        return Number::fromScaledValue (
+            Rounding::round<__int128_t> (
+                roundingMode,
+                negative ? -truncated : truncated,
+                fraction,
+                2,
+                negative
+            ),
+            decimalPlaces
+        );
+    }
+    catch (const fixed::BadValueException&)
+    {
+        return tooLarge (function);
+    }
+}
+
+//
+// The magnitude of a Number with decimalPlaces as a binary fixed point value
+// with ARGUMENT_BITS bits after the point.  It must be below ARGUMENT_LIMIT.
+//
+static __uint128_t toBinary (
+    const __uint128_t magnitude,
+    const unsigned int decimalPlaces
+) noexcept
+{
+    const uint64_t divisor =
+        static_cast<uint64_t> (Ratio::powerOfTen (decimalPlaces));
+
+    const __uint128_t whole = magnitude / divisor;
+
+    return whole << ARGUMENT_BITS |
+        fractionBits (magnitude - whole * divisor, divisor, ARGUMENT_BITS);
+}
+
+//
+// exp (argument), argument having ARGUMENT_BITS bits after the point and a
+// magnitude below ARGUMENT_LIMIT, negated if negative.
+//
+static Number expBinary (
+    const __int128_t argument,
+    const bool negative,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode,
+    const char* function
+)
+{
+    const Tables& table = tables ();
+
+    //
+    // argument = k * ln2 + reduced, with reduced in [0, ln2).  k is estimated
+    // in double from the top bits of the argument and corrected, saving a
+    // 128 bit division.  Both products wrap in 128 bits, their difference
+    // can't.
+    //
+    const double whole =
+        static_cast<double> (static_cast<int64_t> (argument >> 64)) /
+        static_cast<double> (static_cast<uint64_t> (1) << (ARGUMENT_BITS - 64));
+
+    __int128_t power = static_cast<__int128_t> (std::floor (whole / M_LN2));
+
+    __uint128_t reduced =
+        (static_cast<__uint128_t> (argument) << ARGUMENT_DROP) -
+        static_cast<__uint128_t> (power) * table.ln2;
+
+    while (static_cast<__int128_t> (reduced) < 0)
+    {
+        --power;
+        reduced += table.ln2;
+    }
+
+    while (reduced >= table.ln2)
+    {
+        ++power;
+        reduced -= table.ln2;
+    }
+
+    const unsigned int index =
+        static_cast<unsigned int> (reduced >> TABLE_SHIFT);
+    const __uint128_t remainder =
+        reduced - (static_cast<__uint128_t> (index) << TABLE_SHIFT);
+
+    __uint128_t series = table.inverseFactorials [EXP_DEGREE];
+
+    for (unsigned int idx = EXP_DEGREE; idx-- > 0; )
+    {
+        series =
+            multiplyShift (series, remainder) + table.inverseFactorials [idx];
+    }
+
+    return roundScaled (
+        multiplyShift (table.exponentials [index], series),
+        static_cast<unsigned int> (FRACTION_BITS - power),
+        negative,
+        decimalPlaces,
+        roundingMode,
+        function
+    );
+}
+
+//
+// magnitude / 10^decimalPlaces as mantissa * 2^exponent, the mantissa
+// having FRACTION_BITS bits after the point and being in [1, 2).
+// magnitude must be positive.
+//
+static __uint128_t normalize (
+    const __uint128_t magnitude,
+    const unsigned int decimalPlaces,
+    int& exponent
+) noexcept
+{
+    const uint64_t divisor =
+        static_cast<uint64_t> (Ratio::powerOfTen (decimalPlaces));
+
+    exponent = static_cast<int> (FirstBitSet () (magnitude)) -
+        static_cast<int> (FirstBitSet () (divisor));
+
+    const bool atLeast = exponent >= 0 ?
+        magnitude >= static_cast<__uint128_t> (divisor) << exponent :
+        magnitude << -exponent >= divisor;
+
+    if (! atLeast)
+    {
+        --exponent;
+    }
+
+    const unsigned int shift = static_cast<unsigned int> (
+        static_cast<int> (FRACTION_BITS) - exponent
+    );
+    const __uint128_t whole = magnitude / divisor;
+
+    return (whole != 0 ? whole << shift : 0) |
+        fractionBits (magnitude - whole * divisor, divisor, shift);
+}
+
+//
+// mantissa * 2^exponent *= factor * 2^factorExponent, both mantissas having
+// FRACTION_BITS bits after the point and being in [1, 2).
+//
+static void multiplyNormalized (
+    __uint128_t& mantissa,
+    int64_t& exponent,
+    const __uint128_t factor,
+    const int64_t factorExponent
+) noexcept
+{
+    const Wide product = multiplyWide (mantissa, factor);
+    const unsigned int carry =
+        product.high >> (2 * FRACTION_BITS + 1 - 128) != 0 ? 1 : 0;
+
+    mantissa = shiftRight (product, FRACTION_BITS + carry);
+    exponent += factorExponent + carry;
+}
+
+//
+// log (magnitude / 10^decimalPlaces) with ARGUMENT_BITS bits after the
+// point, magnitude must be positive.
+//
+static __int128_t logBinary (
+    const __uint128_t magnitude,
+    const unsigned int decimalPlaces
+) noexcept
+{
+    const Tables& table = tables ();
+
+    int exponent = 0;
+
+    const __uint128_t mantissa =
+        normalize (magnitude, decimalPlaces, exponent);
+
+    //
+    // log (mantissa) = log (1 + j / 64) + log (1 + reduced), the product with
+    // the reciprocal being rounded up so reduced is never negative.
+    //
+    const unsigned int index = static_cast<unsigned int> (
+        (mantissa >> TABLE_SHIFT) & (TABLE_SIZE - 1)
+    );
+    const __uint128_t reduced =
+        multiplyShift (mantissa, table.reciprocals [index]) - ONE;
+
+    //
+    // log (1 + u) = u * (1 - u * (1/2 - u * (1/3 - ...))), each bracket
+    // staying positive as u is under 1 / 64.
+    //
+    __uint128_t series = table.inverses [LOG_DEGREE];
+
+    for (unsigned int idx = LOG_DEGREE - 1; idx > 0; --idx)
+    {
+        series = table.inverses [idx] - multiplyShift (series, reduced);
+    }
+
+    const __int128_t logMantissa = static_cast<__int128_t> (
+        (table.logarithms [index] + multiplyShift (series, reduced)) >>
+        ARGUMENT_DROP
+    );
+
+    //
+    // exponent * ln2, kept to FRACTION_BITS until the final shift.
+    //
+    const __uint128_t count = exponent < 0 ? -exponent : exponent;
+    const __uint128_t mask =
+        (static_cast<__uint128_t> (1) << ARGUMENT_DROP) - 1;
+    const __int128_t logPower = static_cast<__int128_t> (
+        count * (table.ln2 >> ARGUMENT_DROP) +
+        (count * (table.ln2 & mask) >> ARGUMENT_DROP)
+    );
+
+    return exponent < 0 ? logMantissa - logPower : logMantissa + logPower;
+}
+
+static __uint128_t magnitudeOf (const __int128_t value) noexcept
+{
+    return value < 0 ?
+        - static_cast<__uint128_t> (value) :
+        static_cast<__uint128_t> (value);
+}
+
+Number sqrt (
+    const Number& value,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    checkDecimalPlaces (decimalPlaces, "fixed::sqrt");
+
+    const __int128_t scaled = value.scaledValue ();
+
+    if (scaled < 0)
+    {
+        throw fixed::BadValueException ("fixed::sqrt () Negative value");
+    }
+
+    //
+    // The root at decimalPlaces is floor (sqrt (numerator / denominator)),
+    // the value rescaled to twice decimalPlaces.
+    //
+    const int rescale =
+        2 * static_cast<int> (decimalPlaces) -
+        static_cast<int> (value.decimalPlaces ());
+
+    const __int128_t multiplier = Ratio::powerOfTen (rescale > 0 ? rescale : 0);
+    const __int128_t divisor = Ratio::powerOfTen (rescale < 0 ? -rescale : 0);
+
+    const Int256 numerator = Int256::multiply (scaled, multiplier);
+    const Int256 denominator (divisor);
+
+    //
+    // Most roots are compared in 128 bits, an overflow meaning too large.
+    //
+    __int128_t narrowNumerator = 0;
+
+    const bool narrow = numerator.toInt128 (narrowNumerator);
+
+    const auto squareAtMost = [&] (__int128_t root) {
+        if (narrow)
+        {
+            __int128_t square = 0;
+
+            return
+                ! __builtin_mul_overflow (root, root, &square) &&
+                ! __builtin_mul_overflow (square, divisor, &square) &&
+                square <= narrowNumerator;
+        }
+
+        Int256 square = Int256::multiply (root, root);
+
+        square *= denominator;
+
+        return ! (numerator < square);
+    };
+
+    //
+    // A long double estimate is good to around 62 bits, search from there.
+    //
+    const __int128_t estimate = static_cast<__int128_t> (
+        std::sqrt (
+            static_cast<long double> (scaled) *
+            static_cast<long double> (multiplier) /
+            static_cast<long double> (divisor)
+        )
+    );
+    const __int128_t margin = (estimate >> 56) + 2;
+
+    __int128_t low = estimate > margin ? estimate - margin : 0;
+    __int128_t high = estimate + margin;
+
+    while (! squareAtMost (low))
+    {
+        low /= 2;
+    }
+
+    while (squareAtMost (high))
+    {
+        high *= 2;
+    }
+
+    while (high - low > 1)
+    {
+        const __int128_t middle = low + (high - low) / 2;
+
+        if (squareAtMost (middle))
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    //
+    // (root + 1/2)^2 = root^2 + (4 * root + 1) / 4, so four times what is
+    // left of the value over root^2 against (4 * root + 1) says which side
+    // of half way the rest of the root lies.
+    //
+    __int128_t fraction = 0;
+
+    if (narrow)
+    {
+        const __int128_t rest = narrowNumerator - low * low * divisor;
+        const __int128_t midpoint = (4 * low + 1) * divisor;
+
+        if (rest != 0)
+        {
+            fraction = 4 * rest < midpoint ? 1 : 4 * rest == midpoint ? 2 : 3;
+        }
+    }
+    else
+    {
+        Int256 rest = Int256::multiply (-low, low);
+        Int256 midpoint (4 * low + 1);
+
+        rest *= denominator;
+        rest += numerator;
+        rest *= Int256 (4);
+        midpoint *= denominator;
+
+        if (! rest.isZero ())
+        {
+            fraction = rest < midpoint ? 1 : rest == midpoint ? 2 : 3;
+        }
+    }
+
+    return Number::fromScaledValue (
+        Rounding::round<__int128_t> (roundingMode, low, fraction, 2, false),
+        decimalPlaces
+    );
+}
+
+Number exp (
+    const Number& value,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    checkDecimalPlaces (decimalPlaces, "fixed::exp");
+
+    const __int128_t scaled = value.scaledValue ();
+    const __uint128_t magnitude = magnitudeOf (scaled);
+
+    if (
+        magnitude / static_cast<__uint128_t> (
+            Ratio::powerOfTen (value.decimalPlaces ())
+        ) >= ARGUMENT_LIMIT >> ARGUMENT_BITS
+    )
+    {
+        if (scaled > 0)
+        {
+            return tooLarge ("fixed::exp");
+        }
+
+        return tooSmall (false, decimalPlaces, roundingMode);
+    }
+
+    const __int128_t argument = static_cast<__int128_t> (
+        toBinary (magnitude, value.decimalPlaces ())
+    );
+
+    return expBinary (
+        scaled < 0 ? -argument : argument,
+        false,
+        decimalPlaces,
+        roundingMode,
+        "fixed::exp"
+    );
+}
+
+Number log (
+    const Number& value,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    checkDecimalPlaces (decimalPlaces, "fixed::log");
+
+    const __int128_t scaled = value.scaledValue ();
+
+    if (scaled <= 0)
+    {
+        throw fixed::BadValueException ("fixed::log () Value not positive");
+    }
+
+    const __int128_t result = logBinary (
+        static_cast<__uint128_t> (scaled),
+        value.decimalPlaces ()
+    );
+
+    return roundScaled (
+        magnitudeOf (result),
+        ARGUMENT_BITS,
+        result < 0,
+        decimalPlaces,
+        roundingMode,
+        "fixed::log"
+    );
+}
+
+Number pow (
+    const Number& base,
+    const unsigned int exponent,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    checkDecimalPlaces (decimalPlaces, "fixed::pow");
+
+    __uint128_t magnitude = magnitudeOf (base.scaledValue ());
+    unsigned int baseDecimalPlaces = base.decimalPlaces ();
+
+    if (exponent == 0 || magnitude == 0)
+    {
+        return Number::fromScaledValue (
+            exponent == 0 ? Ratio::powerOfTen (decimalPlaces) : 0,
+            decimalPlaces
+        );
+    }
+
+    const bool negative = base.scaledValue () < 0 && exponent % 2 != 0;
+
+    //
+    // Trailing zeros would only lengthen the exact power.
+    //
+    while (baseDecimalPlaces > 0 && magnitude % 10 == 0)
+    {
+        magnitude /= 10;
+        --baseDecimalPlaces;
+    }
+
+    //
+    // While the power of the scaled integer fits in 128 bits, and its scale
+    // in the powers of ten to hand, it is rescaled and rounded exactly.
+    //
+    const uint64_t scale =
+        static_cast<uint64_t> (exponent) * baseDecimalPlaces;
+
+    if (scale <= 2 * Number::MAX_DECIMAL_PLACES)
+    {
+        __int128_t power = 1;
+        __int128_t square = static_cast<__int128_t> (magnitude);
+        bool fits = true;
+
+        for (unsigned int remaining = exponent; fits; )
+        {
+            if (remaining % 2 != 0)
+            {
+                fits = ! __builtin_mul_overflow (power, square, &power);
+            }
+
+            remaining /= 2;
+
+            if (remaining == 0)
+            {
+                break;
+            }
+
+            fits = fits && ! __builtin_mul_overflow (square, square, &square);
+        }
+
+        if (fits)
+        {
+            return Ratio::toNumber (
+                Int256 (negative ? -power : power),
+                Int256 (1),
+                static_cast<unsigned int> (scale),
+                decimalPlaces,
+                roundingMode,
+                "fixed::pow"
+            );
+        }
+    }
+
+    //
+    // Otherwise the squares and products are carried as mantissa * 2^exponent
+    // with the mantissa in [1, 2), each product being cut back to
+    // FRACTION_BITS, and rounded once at the end.
+    //
+    int baseExponent = 0;
+
+    __uint128_t square = normalize (magnitude, baseDecimalPlaces, baseExponent);
+    int64_t squareExponent = baseExponent;
+
+    __uint128_t power = ONE;
+    int64_t powerExponent = 0;
+
+    for (unsigned int remaining = exponent; ; )
+    {
+        if (remaining % 2 != 0)
+        {
+            multiplyNormalized (power, powerExponent, square, squareExponent);
+        }
+
+        remaining /= 2;
+
+        if (remaining == 0)
+        {
+            break;
+        }
+
+        multiplyNormalized (square, squareExponent, square, squareExponent);
+    }
+
+    const int64_t shift = FRACTION_BITS - powerExponent;
+
+    if (shift < 0)
+    {
+        return tooLarge ("fixed::pow");
+    }
+
+    return roundScaled (
+        power,
+        static_cast<unsigned int> (shift < 256 ? shift : 256),
+        negative,
+        decimalPlaces,
+        roundingMode,
+        "fixed::pow"
+    );
+}
+
+Number pow (
+    const Number& base,
+    const Number& exponent,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    checkDecimalPlaces (decimalPlaces, "fixed::pow");
+
+    const __int128_t scaledBase = base.scaledValue ();
+    const __int128_t scaledExponent = exponent.scaledValue ();
+
+    const __uint128_t divisor = static_cast<__uint128_t> (
+        Ratio::powerOfTen (exponent.decimalPlaces ())
+    );
+    const __uint128_t exponentMagnitude = magnitudeOf (scaledExponent);
+    const __uint128_t whole = exponentMagnitude / divisor;
+    const __uint128_t part = exponentMagnitude - whole * divisor;
+
+    //
+    // Whole exponents from 0 up are multiplied out.
+    //
+    if (scaledExponent >= 0 && part == 0 &&
+        whole <= std::numeric_limits<unsigned int>::max ())
+    {
+        return pow (
+            base,
+            static_cast<unsigned int> (whole),
+            decimalPlaces,
+            roundingMode
+        );
+    }
+
+    if (scaledBase == 0)
+    {
+        if (scaledExponent < 0)
+        {
+            throw fixed::DivideByZeroException (
+                "fixed::pow () Zero to a negative power"
+            );
+        }
+
+        return Number::fromScaledValue (0, decimalPlaces);
+    }
+
+    if (scaledBase < 0 && part != 0)
+    {
+        throw fixed::BadValueException (
+            "fixed::pow () Negative base with a fractional exponent"
+        );
+    }
+
+    const bool negative = scaledBase < 0 && (whole & 1) != 0;
+
+    //
+    // exponent * log (|base|), anything at or past ARGUMENT_LIMIT being out
+    // of range one way or the other.
+    //
+    const __int128_t logBase = logBinary (
+        magnitudeOf (scaledBase),
+        base.decimalPlaces ()
+    );
+    const __uint128_t logMagnitude = magnitudeOf (logBase);
+
+    __uint128_t product = 0;
+
+    const bool outOfRange =
+        __builtin_mul_overflow (logMagnitude, whole, &product) ||
+        __builtin_add_overflow (
+            product,
+            multiplyShift (
+                logMagnitude,
+                fractionBits (part, static_cast<uint64_t> (divisor),
+                    ARGUMENT_BITS),
+                ARGUMENT_BITS
+            ),
+            &product
+        ) ||
+        product >= ARGUMENT_LIMIT;
+
+    const bool shrinks = (logBase < 0) != (scaledExponent < 0);
+
+    if (outOfRange)
+    {
+        if (! shrinks)
+        {
+            return tooLarge ("fixed::pow");
+        }
+
+        return tooSmall (negative, decimalPlaces, roundingMode);
+    }
+
+    const __int128_t argument = static_cast<__int128_t> (product);
+
+    return expBinary (
+        shrinks ? -argument : argument,
+        negative,
+        decimalPlaces,
+        roundingMode,
+        "fixed::pow"
+    );
+}
+
+} // namespace fixed
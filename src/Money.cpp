@@ -0,0 +1,341 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Divisor.h"
+#include "fixed/Exceptions.h"
+#include "fixed/Int256.h"
+#include "fixed/Money.h"
+#include "Ratio.h"
+
+#include <cstring>
+
+namespace fixed {
+
+namespace {
+
+struct CurrencyInfo {
+    uint16_t currency;
+    char code [4];
+    uint8_t decimalPlaces;
+};
+
+//
+// ISO 4217 minor units.
+//
+const CurrencyInfo CURRENCIES [] = {
+    {784, "AED", 2},
+    {32, "ARS", 2},
+    {Currency::AUD, "AUD", 2},
+    {Currency::BHD, "BHD", 3},
+    {986, "BRL", 2},
+    {Currency::CAD, "CAD", 2},
+    {Currency::CHF, "CHF", 2},
+    {152, "CLP", 0},
+    {Currency::CNY, "CNY", 2},
+    {203, "CZK", 2},
+    {208, "DKK", 2},
+    {Currency::EUR, "EUR", 2},
+    {Currency::GBP, "GBP", 2},
+    {Currency::HKD, "HKD", 2},
+    {348, "HUF", 2},
+    {360, "IDR", 2},
+    {376, "ILS", 2},
+    {356, "INR", 2},
+    {368, "IQD", 3},
+    {352, "ISK", 0},
+    {400, "JOD", 3},
+    {Currency::JPY, "JPY", 0},
+    {410, "KRW", 0},
+    {Currency::KWD, "KWD", 3},
+    {434, "LYD", 3},
+    {484, "MXN", 2},
+    {578, "NOK", 2},
+    {Currency::NZD, "NZD", 2},
+    {512, "OMR", 3},
+    {608, "PHP", 2},
+    {985, "PLN", 2},
+    {946, "RON", 2},
+    {682, "SAR", 2},
+    {752, "SEK", 2},
+    {702, "SGD", 2},
+    {764, "THB", 2},
+    {788, "TND", 3},
+    {949, "TRY", 2},
+    {901, "TWD", 2},
+    {Currency::USD, "USD", 2},
+    {704, "VND", 0},
+    {Currency::XXX, "XXX", 0},
+    {710, "ZAR", 2}
+};
+
+const uint8_t UNKNOWN = 0xFF;
+
+//
+// Decimal places indexed by numeric code, UNKNOWN for codes not in the
+// table, built on first use.
+//
+const uint8_t* decimalPlacesTable ()
+{
+    static const struct Table {
+        Table () noexcept
+        {
+            std::memset (decimalPlaces, UNKNOWN, sizeof (decimalPlaces));
+
+            for (const auto& info: CURRENCIES)
+            {
+                decimalPlaces [info.currency] = info.decimalPlaces;
+            }
+        }
+
+        uint8_t decimalPlaces [Currency::XXX + 1];
+    } table;
+
+    return table.decimalPlaces;
+}
+
+//
+// Enough powers of ten for a rate's decimal places plus the most any
+// currency in the table has, 3.
+//
+const unsigned int POWERS_OF_TEN = Number::MAX_DECIMAL_PLACES + 4;
+
+//
+// A Divisor for 10^exponent, built on first use.
+//
+const Divisor& powerOfTenDivisor (const unsigned int exponent)
+{
+    static const struct Divisors {
+        Divisors ()
+        {
+            for (unsigned int idx = 0; idx < POWERS_OF_TEN; ++idx)
+            {
+                values [idx] = Divisor (Int256 (Ratio::powerOfTen (idx)));
+            }
+        }
+
+        Divisor values [POWERS_OF_TEN];
+    } divisors;
+
+    return divisors.values [exponent];
+}
+
+} // namespace
+
+bool Currency::isKnown (const uint16_t currency) noexcept
+{
+    return currency <= XXX && decimalPlacesTable () [currency] != UNKNOWN;
+}
+
+unsigned int Currency::decimalPlaces (const uint16_t currency)
+{
+    if (! isKnown (currency))
+    {
+        throw fixed::BadValueException (
+            "Currency::decimalPlaces () Unknown currency"
+        );
+    }
+
+    return decimalPlacesTable () [currency];
+}
+
+std::string Currency::code (const uint16_t currency)
+{
+    for (const auto& info: CURRENCIES)
+    {
+        if (info.currency == currency)
+        {
+            return info.code;
+        }
+    }
+
+    throw fixed::BadValueException ("Currency::code () Unknown currency");
+}
+
+uint16_t Currency::fromCode (const std::string& code)
+{
+    for (const auto& info: CURRENCIES)
+    {
+        if (code == info.code)
+        {
+            return info.currency;
+        }
+    }
+
+    throw fixed::BadValueException (
+        "Currency::fromCode () Unknown currency " + code
+    );
+}
+
+Money::Money (
+    const Number& amount,
+    const uint16_t currency,
+    const Rounding::Mode roundingMode
+)
+  : currency_ (currency)
+{
+    const __int128_t scaled = Ratio::rescale (
+        amount, Currency::decimalPlaces (currency), roundingMode
+    );
+
+    if (scaled <= std::numeric_limits<int64_t>::min () ||
+        scaled > std::numeric_limits<int64_t>::max ())
+    {
+        tooLarge ("Money::Money");
+    }
+
+    minorUnits_ = static_cast<int64_t> (scaled);
+}
+
+Money Money::fromMinorUnits (
+    const int64_t minorUnits,
+    const uint16_t currency
+)
+{
+    if (minorUnits == std::numeric_limits<int64_t>::min ())
+    {
+        throw fixed::BadValueException (
+            "Money::fromMinorUnits () Minor units out of range"
+        );
+    }
+
+    Currency::decimalPlaces (currency);
+
+    return Money (minorUnits, currency);
+}
+
+unsigned int Money::decimalPlaces () const
+{
+    return Currency::decimalPlaces (currency_);
+}
+
+Number Money::amount () const
+{
+    return Number::fromScaledValue (minorUnits_, decimalPlaces ());
+}
+
+std::string Money::toString () const
+{
+    return amount ().toString () + " " + Currency::code (currency_);
+}
+
+Money Money::convert (
+    const uint16_t currency,
+    const Number& rate,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (rate.scaledValue () <= 0)
+    {
+        throw fixed::BadValueException (
+            "Money::convert () Rate must be positive"
+        );
+    }
+
+    const unsigned int scale = decimalPlaces () + rate.decimalPlaces ();
+    const unsigned int targetScale = Currency::decimalPlaces (currency);
+
+    const __int128_t rateValue = rate.scaledValue ();
+
+    __int128_t scaled = 0;
+
+    //
+    // Two 64 bit values multiply within 2^126, leaving at most one division
+    // by a power of ten prepared up front, which can't fail for it.
+    //
+    if (Divisor::fitsInt64 (rateValue))
+    {
+        const __int128_t product = minorUnits_ * rateValue;
+
+        if (scale >= targetScale)
+        {
+            powerOfTenDivisor (scale - targetScale).divideRounded (
+                product, roundingMode, scaled
+            );
+        }
+        else if (__builtin_mul_overflow (
+                     product,
+                     Ratio::powerOfTen (targetScale - scale),
+                     &scaled
+                 ))
+        {
+            tooLarge ("Money::convert");
+        }
+    }
+    else
+    {
+        scaled = Ratio::toNumber (
+            Int256::multiply (minorUnits_, rateValue),
+            Int256 (1),
+            scale,
+            targetScale,
+            roundingMode,
+            "Money::convert"
+        ).scaledValue ();
+    }
+
+    if (scaled <= std::numeric_limits<int64_t>::min () ||
+        scaled > std::numeric_limits<int64_t>::max ())
+    {
+        tooLarge ("Money::convert");
+    }
+
+    return Money (static_cast<int64_t> (scaled), currency);
+}
+
+void Money::tooLarge (const char* function)
+{
+    throw fixed::OverflowException (
+        std::string (function) + " () Result too large"
+    );
+}
+
+bool operator< (const Money& lhs, const Money& rhs)
+{
+    if (lhs.currency () != rhs.currency ())
+    {
+        throw fixed::BadValueException (
+            "Money::operator< () Currency mismatch"
+        );
+    }
+
+    return lhs.minorUnits () < rhs.minorUnits ();
+}
+
+bool operator<= (const Money& lhs, const Money& rhs)
+{
+    return ! (rhs < lhs);
+}
+
+bool operator> (const Money& lhs, const Money& rhs)
+{
+    return rhs < lhs;
+}
+
+bool operator>= (const Money& lhs, const Money& rhs)
+{
+    return ! (lhs < rhs);
+}
+
+} // namespace fixed
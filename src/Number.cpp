@@ -25,6 +25,7 @@
 
 #include "fixed/FirstBitSet.h"
 #include "fixed/Number.h"
+#include "RescaleKernel.h"
 #include "Utils.h"
 
 #include <algorithm>
@@ -114,6 +115,7 @@ Number::Number (const char* numberCStr)
     Sign numberSign = Sign::POSITIVE;
     unsigned long long integerValue = 0;
     unsigned long long fractionalValue = 0;
+    unsigned int fractionalDigits = 0;
 
     char* endptr;
 
@@ -139,16 +141,37 @@ Number::Number (const char* numberCStr)
             cptr, endptr, fracSign, "Number::Number (str) FractionalValue "
         );
 
-        decimalPlaces_ = static_cast<uint8_t> (endptr - cptr);
+        fractionalDigits = static_cast<unsigned int> (endptr - cptr);
+    }
 
-        if (decimalPlaces () > MAX_DECIMAL_PLACES)
-        {
-            throw fixed::BadValueException (
-                "Number::Number (str) FractionalValue too large"
-            );
-        }
+    if ((*endptr == 'e') || (*endptr == 'E'))
+    {
+        cptr = endptr + 1;
+
+        Sign exponentSign = Sign::POSITIVE;
+
+        unsigned long long exponent = convertStrToVal (
+            cptr, endptr, exponentSign, "Number::Number (str) Exponent "
+        );
+
+        applyExponent (
+            exponent,
+            exponentSign,
+            integerValue,
+            fractionalValue,
+            fractionalDigits
+        );
     }
 
+    if (fractionalDigits > MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "Number::Number (str) FractionalValue too large"
+        );
+    }
+
+    decimalPlaces_ = static_cast<uint8_t> (fractionalDigits);
+
     if (endptr[0] != '\0')
     {
         throw fixed::BadValueException (
@@ -171,6 +194,288 @@ Number::Number (const char* numberCStr)
     );
 }
 
+//
+// The approach is the one taken by the shortest representation algorithms
+// such as Ryu, except that since we're limited to MAX_DECIMAL_PLACES we can
+// simply try each number of decimal places in turn.  Every floating point
+// value owns the interval half way to each of its neighbours, any decimal
+// inside that interval converts back to the same floating point value.  All
+// values below are scaled by 10^dp * 2^shift so that the value itself and the
+// interval bounds are exact integers, the candidates are multiples of 2^shift.
+//
+Number Number::fromBinaryFloatingPoint (
+    const uint64_t mantissa,
+    const int exponent,
+    const unsigned int mantissaBits,
+    const bool negative,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    Number number;
+
+    number.setRoundingMode (roundingMode);
+
+    const bool minimizeDps = (decimalPlaces > MAX_DECIMAL_PLACES);
+
+    if (! mantissa)
+    {
+        if (! minimizeDps)
+        {
+            number.setDecimalPlaces (decimalPlaces);
+        }
+
+        return number;
+    }
+
+    if ((exponent + static_cast<int> (mantissaBits)) >
+        static_cast<int> (FirstBitSet::maxBitPos<uint64_t> ()))
+    {
+        throw fixed::BadValueException (
+            "Floating point constructor, integer value too large."
+        );
+    }
+
+    //
+    // A shift of 2 more than the exponent keeps the half gaps to the
+    // neighbouring values integers, including the smaller gap below a power
+    // of 2.
+    //
+    const int shift = std::max (0, 2 - exponent);
+
+    //
+    // Past this point the value is far smaller than 10^-MAX_DECIMAL_PLACES,
+    // all that matters for the rounding is that it isn't zero.
+    //
+    static constexpr int MAX_SHIFT = 120;
+
+    __int128_t value = 0;
+    unsigned int valueDecimalPlaces = MAX_DECIMAL_PLACES;
+    bool found = false;
+
+    if (shift > MAX_SHIFT)
+    {
+        value = Rounding::round<__int128_t> (roundingMode, 0, 1, 2, negative);
+    }
+    else
+    {
+        const __uint128_t mask = (static_cast<__uint128_t> (1) << shift) - 1;
+        const __uint128_t half = shift ? (mask >> 1) + 1 : 0;
+
+        const bool inclusive = ! (mantissa & 0x1);
+
+        const bool asymmetric =
+            (mantissa == (static_cast<uint64_t> (1) << (mantissaBits - 1)));
+
+        __uint128_t scaled =
+            static_cast<__uint128_t> (mantissa) << (exponent + shift);
+
+        __uint128_t gapHigh =
+            static_cast<__uint128_t> (1) << (exponent + shift - 1);
+
+        __uint128_t gapLow = asymmetric ? (gapHigh >> 1) : gapHigh;
+
+        for (unsigned int dp = 0; dp <= MAX_DECIMAL_PLACES; ++dp)
+        {
+            if (dp)
+            {
+                scaled *= 10;
+                gapHigh *= 10;
+                gapLow *= 10;
+            }
+
+            const __uint128_t low = scaled - gapLow;
+            const __uint128_t high = scaled + gapHigh;
+
+            const __uint128_t lowCandidate = inclusive ?
+                (low >> shift) + ((low & mask) ? 1 : 0) :
+                (low >> shift) + 1;
+
+            const __uint128_t highCandidate = inclusive ?
+                (high >> shift) :
+                (high >> shift) - ((high & mask) ? 0 : 1);
+
+            if (lowCandidate > highCandidate)
+            {
+                continue;
+            }
+
+            //
+            // Of the candidates, pick the one closest to the exact value.
+            //
+            __uint128_t candidate = scaled >> shift;
+            const __uint128_t remainder = scaled & mask;
+
+            if (shift &&
+                ((remainder > half) ||
+                 ((remainder == half) && (candidate & 0x1))))
+            {
+                ++candidate;
+            }
+
+            candidate = std::min (
+                std::max (candidate, lowCandidate), highCandidate
+            );
+
+            value = static_cast<__int128_t> (candidate);
+            valueDecimalPlaces = dp;
+            found = true;
+
+            break;
+        }
+
+        if (! found)
+        {
+            //
+            // No short representation exists, round the exact value.
+            //
+            const __int128_t integerVal =
+                static_cast<__int128_t> (scaled >> shift);
+
+            value = Rounding::round<__int128_t> (
+                roundingMode,
+                negative ? - integerVal : integerVal,
+                static_cast<__int128_t> (scaled & mask),
+                static_cast<__int128_t> (half),
+                negative
+            );
+        }
+        else if (negative)
+        {
+            value = - value;
+        }
+    }
+
+    number.value128_ = value;
+    number.value64Set_ = false;
+    number.decimalPlaces_ = static_cast<uint8_t> (valueDecimalPlaces);
+
+    number.valueAutoResize ();
+
+    if (number.integerValueOverflowCheck ())
+    {
+        throw fixed::BadValueException (
+            "Floating point constructor, integer value too large."
+        );
+    }
+
+    if (! minimizeDps)
+    {
+        number.setDecimalPlaces (decimalPlaces);
+    }
+    else if (! found)
+    {
+        number.makeCompact ();
+    }
+
+    return number;
+}
+
+Number Number::fromScaledValue (
+    const __int128_t scaledValue,
+    const unsigned int decimalPlaces
+)
+{
+    if (decimalPlaces > MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "Number::fromScaledValue () Decimal place exceeds max"
+        );
+    }
+
+    if (integerValueOverflowCheck (scaledValue, decimalPlaces))
+    {
+        throw fixed::BadValueException (
+            "Number::fromScaledValue () IntegerValue too large"
+        );
+    }
+
+    Number number;
+
+    number.value128_ = scaledValue;
+    number.value64Set_ = false;
+    number.decimalPlaces_ = static_cast<uint8_t> (decimalPlaces);
+
+    number.valueAutoResize ();
+
+    return number;
+}
+
+//
+// Flipping the sign bit of the two's complement value makes the unsigned
+// order of keys match the signed order of the values.
+//
+static const __uint128_t KEY_SIGN_BIT = static_cast<__uint128_t> (1) << 127;
+
+void Number::encodeKey (uint8_t* out) const noexcept
+{
+    const __uint128_t key =
+        static_cast<__uint128_t> (canonicalValue ()) ^ KEY_SIGN_BIT;
+
+    for (size_t idx = 0; idx < KEY_SIZE; ++idx)
+    {
+        out [idx] = static_cast<uint8_t> (key >> (8 * (KEY_SIZE - 1 - idx)));
+    }
+}
+
+Number Number::decodeKey (const uint8_t* key)
+{
+    __uint128_t bits = 0;
+
+    for (size_t idx = 0; idx < KEY_SIZE; ++idx)
+    {
+        bits = (bits << 8) | key [idx];
+    }
+
+    const __int128_t value = static_cast<__int128_t> (bits ^ KEY_SIGN_BIT);
+
+    if (integerValueOverflowCheck (value, MAX_DECIMAL_PLACES))
+    {
+        throw fixed::BadValueException (
+            "Number::decodeKey () Key out of range"
+        );
+    }
+
+    Number number = fromScaledValue (value, MAX_DECIMAL_PLACES);
+
+    number.makeCompact ();
+
+    return number;
+}
+
+size_t Number::hash () const noexcept
+{
+    //
+    // Scaling up to MAX_DECIMAL_PLACES is a single multiply, where stripping
+    // trailing zeros to reach the same canonical form would take a division
+    // per zero.  The halves are then mixed with the MurmurHash3 finaliser.
+    //
+    const __uint128_t value = static_cast<__uint128_t> (canonicalValue ());
+
+    const uint64_t low = static_cast<uint64_t> (value);
+    const uint64_t high = static_cast<uint64_t> (value >> 64);
+
+    uint64_t mixed = low ^ high * 0x9e3779b97f4a7c15ULL;
+
+    mixed ^= mixed >> 33;
+    mixed *= 0xff51afd7ed558ccdULL;
+    mixed ^= mixed >> 33;
+    mixed *= 0xc4ceb9fe1a85ec53ULL;
+    mixed ^= mixed >> 33;
+
+    return static_cast<size_t> (mixed);
+}
+
+__int128_t Number::canonicalValue () const noexcept
+{
+    const int64_t multiplier =
+        shiftTable64 () [MAX_DECIMAL_PLACES - decimalPlaces ()].value;
+
+    return value64Set_ ?
+        static_cast<__int128_t> (value64_) * multiplier :
+        value128_ * multiplier;
+}
+
 bool Number::isCompact () const noexcept
 {
     if (value64Set_)
@@ -299,6 +604,58 @@ void Number::setDecimalPlaces (const unsigned int targetDecimalPlaces)
     valueAutoResize ();
 }
 
+void Number::setDecimalPlaces (
+    Number* numbers,
+    const size_t count,
+    const unsigned int targetDecimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    if (targetDecimalPlaces > MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "Number::setDecimalPlaces () Decimal place exceeds max"
+        );
+    }
+
+    //
+    // Kernels by number of decimal places dropped, looked up as needed.
+    //
+    DecreaseKernel kernels [MAX_DECIMAL_PLACES + 1] = {};
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        Number& number = numbers [idx];
+
+        if (number.value64Set_ && number.decimalPlaces () > targetDecimalPlaces)
+        {
+            const unsigned int shift =
+                number.decimalPlaces () - targetDecimalPlaces;
+
+            if (! kernels [shift])
+            {
+                kernels [shift] = decreaseKernelFor (roundingMode, shift);
+            }
+
+            //
+            // Dropping decimal places can't take a 64 bit value to int64_t
+            // min, so no need for valueAutoResize ().
+            //
+            kernels [shift] (&number.value64_, &number.value64_, 1);
+
+            number.decimalPlaces_ = static_cast<uint8_t> (targetDecimalPlaces);
+        }
+        else
+        {
+            const Rounding::Mode ownRoundingMode = number.roundingMode_;
+
+            number.roundingMode_ = roundingMode;
+            number.setDecimalPlaces (targetDecimalPlaces);
+            number.roundingMode_ = ownRoundingMode;
+        }
+    }
+}
+
 void Number::increaseDecimalPlaces64 (
     unsigned int targetDecimalPlaces
 ) noexcept
@@ -1375,6 +1732,148 @@ unsigned long long Number::convertStrToVal (
     return value;
 }
 
+//
+// Utility function meant for Number::Number (str), folds a decimal exponent
+// into the integer and fractional values parsed so far.  The whole thing is
+// done with integer arithmetic, so the result is exact, a BadValueException
+// is thrown if the value can't be represented.
+//
+void Number::applyExponent (
+    const unsigned long long exponent,
+    const Sign exponentSign,
+    unsigned long long& integerValue,
+    unsigned long long& fractionalValue,
+    unsigned int& fractionalDigits
+)
+{
+    //
+    // Limiting the fractional digits to what fits in a uint64_t ensures the
+    // combined mantissa below can't overflow a __uint128_t.
+    //
+    if (fractionalDigits > std::numeric_limits<uint64_t>::digits10)
+    {
+        throw fixed::BadValueException (
+            "Number::Number (str) FractionalValue too large"
+        );
+    }
+
+    __uint128_t mantissa =
+        static_cast<__uint128_t> (integerValue) *
+        static_cast<__uint128_t> (shiftTable128 () [fractionalDigits].value) +
+        fractionalValue;
+
+    if (exponent > std::numeric_limits<uint64_t>::digits10 + MAX_DECIMAL_PLACES)
+    {
+        //
+        // Any exponent this large in magnitude can only be valid for a value
+        // of zero shifted to the left.
+        //
+        if (mantissa || (exponentSign == Sign::NEGATIVE))
+        {
+            throw fixed::BadValueException (
+                "Number::Number (str) Exponent too large"
+            );
+        }
+
+        integerValue = 0;
+        fractionalValue = 0;
+        fractionalDigits = 0;
+
+        return;
+    }
+
+    const int targetDecimalPlaces =
+        static_cast<int> (fractionalDigits) +
+        ((exponentSign == Sign::NEGATIVE) ?
+            static_cast<int> (exponent) : - static_cast<int> (exponent));
+
+    if (targetDecimalPlaces > static_cast<int> (MAX_DECIMAL_PLACES))
+    {
+        throw fixed::BadValueException (
+            "Number::Number (str) Exponent requires too many decimal places"
+        );
+    }
+
+    if (targetDecimalPlaces < 0)
+    {
+        const __uint128_t shift = static_cast<__uint128_t> (
+            shiftTable128 () [- targetDecimalPlaces].value
+        );
+
+        if (mantissa > MAX_INTEGER_VALUE / shift)
+        {
+            throw fixed::BadValueException (
+                "Number::Number (str) IntegerValue too large"
+            );
+        }
+
+        integerValue = static_cast<unsigned long long> (mantissa * shift);
+        fractionalValue = 0;
+        fractionalDigits = 0;
+
+        return;
+    }
+
+    const __uint128_t shift = static_cast<__uint128_t> (
+        shiftTable128 () [targetDecimalPlaces].value
+    );
+
+    if ((mantissa / shift) > MAX_INTEGER_VALUE)
+    {
+        throw fixed::BadValueException (
+            "Number::Number (str) IntegerValue too large"
+        );
+    }
+
+    integerValue = static_cast<unsigned long long> (mantissa / shift);
+    fractionalValue = static_cast<unsigned long long> (mantissa % shift);
+    fractionalDigits = static_cast<unsigned int> (targetDecimalPlaces);
+}
+
+//
+// The quotient is computed with at least two more bits than T can hold, the
+// lowest of those set if the division wasn't exact.  The conversion of that
+// integer to T then does the one and only rounding, and the guard and sticky
+// bits ensure it rounds the same way the exact quotient would.
+//
+template <typename T>
+T Number::divideRounded (
+    const __uint128_t& magnitude,
+    const unsigned int decimalPlaces
+) noexcept
+{
+    if (! magnitude)
+    {
+        return 0;
+    }
+
+    const uint64_t divisor =
+        static_cast<uint64_t> (shiftTable64 () [decimalPlaces].value);
+
+    const int shift = std::max (
+        0,
+        std::numeric_limits<T>::digits + 1 +
+            static_cast<int> (firstBitSet_ (divisor)) -
+            static_cast<int> (firstBitSet_ (magnitude))
+    );
+
+    const __uint128_t scaled = magnitude << shift;
+    const __uint128_t quotient = scaled / divisor;
+    const __uint128_t sticky = (scaled % divisor) ? 1 : 0;
+
+    return std::ldexp (static_cast<T> ((quotient << 1) | sticky), - shift - 1);
+}
+
+template double Number::divideRounded<double> (
+    const __uint128_t& magnitude,
+    const unsigned int decimalPlaces
+) noexcept;
+
+template long double Number::divideRounded<long double> (
+    const __uint128_t& magnitude,
+    const unsigned int decimalPlaces
+) noexcept;
+
 bool Number::integerValueOverflowCheck ()
 {
     //
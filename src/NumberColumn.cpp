@@ -0,0 +1,178 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/NumberColumn.h"
+
+namespace fixed {
+
+constexpr int64_t NumberColumn::WIDE_MARKER;
+
+NumberColumn::NumberColumn (
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+  : decimalPlaces_ (decimalPlaces),
+    roundingMode_ (roundingMode)
+{
+    if (decimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "NumberColumn::NumberColumn () Decimal place exceeds max"
+        );
+    }
+}
+
+NumberColumn::NumberColumn (
+    const std::vector<Number>& numbers,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+  : NumberColumn (decimalPlaces, roundingMode)
+{
+    mantissas_.reserve (numbers.size ());
+
+    for (const auto& number: numbers)
+    {
+        push_back (number);
+    }
+}
+
+std::vector<Number> NumberColumn::toNumbers () const
+{
+    std::vector<Number> numbers;
+
+    numbers.reserve (size ());
+
+    for (size_t idx = 0; idx < size (); ++idx)
+    {
+        numbers.push_back ((*this) [idx]);
+    }
+
+    return numbers;
+}
+
+void NumberColumn::reserve (const size_t count)
+{
+    mantissas_.reserve (count);
+}
+
+void NumberColumn::clear () noexcept
+{
+    mantissas_.clear ();
+    wideValues_.clear ();
+}
+
+void NumberColumn::push_back (const Number& number)
+{
+    pushBackScaledValue (toColumnScale (number));
+}
+
+Number NumberColumn::at (const size_t idx) const
+{
+    if (idx >= size ())
+    {
+        throw fixed::BadValueException (
+            "NumberColumn::at () Index out of range"
+        );
+    }
+
+    return (*this) [idx];
+}
+
+void NumberColumn::set (const size_t idx, const Number& number)
+{
+    setScaledValue (idx, toColumnScale (number));
+}
+
+void NumberColumn::setScaledValue (const size_t idx, const __int128_t value)
+{
+    if (fitsMantissa (value))
+    {
+        if (mantissas_ [idx] == WIDE_MARKER)
+        {
+            wideValues_.erase (idx);
+        }
+
+        mantissas_ [idx] = static_cast<int64_t> (value);
+    }
+    else
+    {
+        storeWide (idx, value);
+    }
+}
+
+void NumberColumn::pushBackScaledValue (const __int128_t value)
+{
+    //
+    // Any int64_t magnitude is within range at every scale, see
+    // Number::fundamentalAssumptions (), so only wide values need checking.
+    //
+    if (fitsMantissa (value))
+    {
+        mantissas_.push_back (static_cast<int64_t> (value));
+    }
+    else
+    {
+        mantissas_.push_back (WIDE_MARKER);
+
+        try {
+            storeWide (size () - 1, value);
+        }
+        catch (...)
+        {
+            mantissas_.pop_back ();
+
+            throw;
+        }
+    }
+}
+
+void NumberColumn::storeWide (const size_t idx, const __int128_t value)
+{
+    //
+    // Throws when out of range.
+    //
+    Number::fromScaledValue (value, decimalPlaces_);
+
+    wideValues_ [idx] = value;
+    mantissas_ [idx] = WIDE_MARKER;
+}
+
+__int128_t NumberColumn::toColumnScale (const Number& number) const
+{
+    if (number.decimalPlaces () == decimalPlaces_)
+    {
+        return number.scaledValue ();
+    }
+
+    Number scaled (number);
+
+    scaled.setRoundingMode (roundingMode_);
+    scaled.setDecimalPlaces (decimalPlaces_);
+
+    return scaled.scaledValue ();
+}
+
+} // namespace fixed
@@ -0,0 +1,103 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Parallel.h"
+
+#include <vector>
+
+namespace fixed {
+namespace parallel {
+
+Number reduce (
+    const Number* numbers,
+    const size_t count,
+    ThreadPool& pool
+)
+{
+    return sumChunks (
+        count,
+        [numbers] (const size_t begin, const size_t end, Accumulator& total) {
+            for (size_t idx = begin; idx < end; ++idx)
+            {
+                total.add (numbers [idx]);
+            }
+        },
+        pool
+    );
+}
+
+Number transform_reduce (
+    const Number* lhs,
+    const Number* rhs,
+    const size_t count,
+    ThreadPool& pool
+)
+{
+    return sumChunks (
+        count,
+        [lhs, rhs] (const size_t begin, const size_t end, Accumulator& total) {
+            for (size_t idx = begin; idx < end; ++idx)
+            {
+                total.add (lhs [idx] * rhs [idx]);
+            }
+        },
+        pool
+    );
+}
+
+size_t chunkCount (const size_t count) noexcept
+{
+    return (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+}
+
+Number sumChunks (
+    const size_t count,
+    const std::function<void (size_t, size_t, Accumulator&)>& sum,
+    ThreadPool& pool
+)
+{
+    std::vector<Accumulator> totals (chunkCount (count));
+
+    pool.run (totals.size (), [&] (const size_t chunk) {
+        const size_t begin = chunk * CHUNK_SIZE;
+        const size_t end = count - begin < CHUNK_SIZE ?
+                           count :
+                           begin + CHUNK_SIZE;
+
+        sum (begin, end, totals [chunk]);
+    });
+
+    Accumulator total;
+
+    for (const auto& chunkTotal: totals)
+    {
+        total.merge (chunkTotal);
+    }
+
+    return total.toNumber ();
+}
+
+} // namespace parallel
+} // namespace fixed
@@ -0,0 +1,116 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "Ratio.h"
+
+#include <string>
+
+namespace fixed {
+
+static const unsigned int POWERS_OF_TEN = 2 * Number::MAX_DECIMAL_PLACES + 1;
+
+__int128_t Ratio::powerOfTen (const unsigned int exponent) noexcept
+{
+    static const struct PowersOfTen {
+        PowersOfTen () noexcept
+        {
+            for (unsigned int idx = 0; idx < POWERS_OF_TEN; ++idx)
+            {
+                values [idx] = powerOfTenConstant (idx);
+            }
+        }
+
+        __int128_t values [POWERS_OF_TEN];
+    } powers;
+
+    return powers.values [exponent];
+}
+
+__int128_t Ratio::rescale (
+    const Number& value,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+{
+    if (decimalPlaces >= value.decimalPlaces ())
+    {
+        return value.scaledValue () *
+               powerOfTen (decimalPlaces - value.decimalPlaces ());
+    }
+
+    return Int256::divideRounded (
+        Int256 (value.scaledValue ()),
+        Int256 (powerOfTen (value.decimalPlaces () - decimalPlaces)),
+        roundingMode
+    );
+}
+
+Number Ratio::toNumber (
+    Int256 numerator,
+    Int256 denominator,
+    const unsigned int scale,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode,
+    const char* function
+)
+{
+    if (decimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            std::string (function) + " () Decimal place exceeds max"
+        );
+    }
+
+    try {
+        if (decimalPlaces >= scale)
+        {
+            numerator *= Int256 (powerOfTen (decimalPlaces - scale));
+        }
+        else
+        {
+            denominator *= Int256 (powerOfTen (scale - decimalPlaces));
+        }
+
+        return Number::fromScaledValue (
+            Int256::divideRounded (numerator, denominator, roundingMode),
+            decimalPlaces
+        );
+    }
+    catch (const fixed::BadValueException&)
+    {
+        throw fixed::OverflowException (
+            std::string (function) + " () Result too large"
+        );
+    }
+    catch (const fixed::OverflowException&)
+    {
+        throw fixed::OverflowException (
+            std::string (function) + " () Result too large"
+        );
+    }
+}
+
+} // namespace fixed
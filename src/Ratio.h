@@ -0,0 +1,87 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_RATIO_H
+#define FIXED_RATIO_H
+
+#include "fixed/Int256.h"
+#include "fixed/Number.h"
+
+namespace fixed {
+
+//
+// Helpers for the estimators that keep exact integer sums and only divide
+// when a result is read.
+//
+struct Ratio {
+    //
+    // 10^exponent for exponents up to 2 * MAX_DECIMAL_PLACES, the most a sum
+    // of squares is ever rescaled by.
+    //
+    static __int128_t powerOfTen (const unsigned int exponent) noexcept;
+
+    //
+    // The same as a constant expression, for powers fixed at compile time.
+    //
+    static constexpr __int128_t powerOfTenConstant (
+        const unsigned int exponent
+    ) noexcept
+    {
+        return exponent ? 10 * powerOfTenConstant (exponent - 1) : 1;
+    }
+
+    //
+    // The scaled value of value at decimalPlaces, rounded with roundingMode
+    // rather than value's own.  decimalPlaces must not exceed
+    // MAX_DECIMAL_PLACES.
+    //
+    static __int128_t rescale (
+        const Number& value,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode
+    );
+
+    //
+    // numerator / denominator, a ratio of integers at scale decimal places,
+    // rounded to a Number with decimalPlaces.  Whichever of the two needs
+    // rescaling is rescaled, the numerator up or the denominator down.
+    //
+    // A fixed::BadValueException naming function is thrown if decimalPlaces
+    // exceeds MAX_DECIMAL_PLACES, and a fixed::OverflowException if the
+    // result is outside the range of a Number.
+    //
+    static Number toNumber (
+        Int256 numerator,
+        Int256 denominator,
+        const unsigned int scale,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode,
+        const char* function
+    );
+};
+
+} // namespace fixed
+
+#endif // FIXED_RATIO_H
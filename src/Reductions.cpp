@@ -0,0 +1,298 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Reductions.h"
+#include "ColumnKernels.h"
+#include "Ratio.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+namespace fixed {
+
+Number Reductions::sum (const NumberColumn& column)
+{
+    return toNumber (scaledSum (column), column.decimalPlaces (), "sum");
+}
+
+Number Reductions::min (const NumberColumn& column)
+{
+    if (column.empty ())
+    {
+        throw fixed::BadValueException ("Reductions::min () Empty column");
+    }
+
+    //
+    // With every value wide the kernel only sees markers, and returns its
+    // starting value, so start from a wide value instead.
+    //
+    __int128_t result = column.wideCount () < column.size () ?
+        ColumnKernels::get ().minValue (column.mantissas (), column.size ()) :
+        column.wideValues_.begin ()->second;
+
+    for (const auto& wide: column.wideValues_)
+    {
+        result = std::min (result, wide.second);
+    }
+
+    return Number::fromScaledValue (result, column.decimalPlaces ());
+}
+
+Number Reductions::max (const NumberColumn& column)
+{
+    if (column.empty ())
+    {
+        throw fixed::BadValueException ("Reductions::max () Empty column");
+    }
+
+    //
+    // With every value wide the kernel only sees markers, and returns its
+    // starting value, so start from a wide value instead.
+    //
+    __int128_t result = column.wideCount () < column.size () ?
+        ColumnKernels::get ().maxValue (column.mantissas (), column.size ()) :
+        column.wideValues_.begin ()->second;
+
+    for (const auto& wide: column.wideValues_)
+    {
+        result = std::max (result, wide.second);
+    }
+
+    return Number::fromScaledValue (result, column.decimalPlaces ());
+}
+
+Number Reductions::mean (const NumberColumn& column)
+{
+    return mean (column, column.roundingMode ());
+}
+
+Number Reductions::mean (
+    const NumberColumn& column,
+    const Rounding::Mode roundingMode
+)
+{
+    if (column.empty ())
+    {
+        throw fixed::BadValueException ("Reductions::mean () Empty column");
+    }
+
+    return Number::fromScaledValue (
+        divideRounded (scaledSum (column), column.size (), roundingMode),
+        column.decimalPlaces ()
+    );
+}
+
+size_t Reductions::countNonZero (const NumberColumn& column) noexcept
+{
+    //
+    // WIDE_MARKER is non zero, as is every wide value.
+    //
+    return ColumnKernels::get ().countNonZero (
+        column.mantissas (), column.size ()
+    );
+}
+
+Number Reductions::sum (const Number* numbers, const size_t count)
+{
+    unsigned int decimalPlaces;
+    const __int128_t total = scaledSum (numbers, count, decimalPlaces);
+
+    return toNumber (total, decimalPlaces, "sum");
+}
+
+Number Reductions::min (const Number* numbers, const size_t count)
+{
+    if (! count)
+    {
+        throw fixed::BadValueException ("Reductions::min () No numbers");
+    }
+
+    return *std::min_element (numbers, numbers + count);
+}
+
+Number Reductions::max (const Number* numbers, const size_t count)
+{
+    if (! count)
+    {
+        throw fixed::BadValueException ("Reductions::max () No numbers");
+    }
+
+    return *std::max_element (numbers, numbers + count);
+}
+
+Number Reductions::mean (
+    const Number* numbers,
+    const size_t count,
+    const Rounding::Mode roundingMode
+)
+{
+    if (! count)
+    {
+        throw fixed::BadValueException ("Reductions::mean () No numbers");
+    }
+
+    unsigned int decimalPlaces;
+    const __int128_t total = scaledSum (numbers, count, decimalPlaces);
+
+    return Number::fromScaledValue (
+        divideRounded (total, count, roundingMode),
+        decimalPlaces
+    );
+}
+
+size_t Reductions::countNonZero (
+    const Number* numbers,
+    const size_t count
+) noexcept
+{
+    size_t nonZero = 0;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        nonZero += numbers [idx].scaledValue () != 0;
+    }
+
+    return nonZero;
+}
+
+__int128_t Reductions::scaledSum (const NumberColumn& column)
+{
+    __int128_t total = ColumnKernels::get ().sum (
+        column.mantissas (), column.size ()
+    );
+
+    for (const auto& wide: column.wideValues_)
+    {
+        //
+        // The kernel counted WIDE_MARKER for this lane.
+        //
+        const __int128_t correction =
+            wide.second - static_cast<__int128_t> (NumberColumn::WIDE_MARKER);
+
+        if (__builtin_add_overflow (total, correction, &total))
+        {
+            throw fixed::OverflowException (
+                "Reductions::sum () Sum exceeds 128 bits"
+            );
+        }
+    }
+
+    return total;
+}
+
+//
+// Keeps a separate total for each number of decimal places, so each Number
+// is added as it is, and the totals are brought to the largest number of
+// decimal places at the end.
+//
+__int128_t Reductions::scaledSum (
+    const Number* numbers,
+    const size_t count,
+    unsigned int& decimalPlaces
+)
+{
+    __int128_t totals [Number::MAX_DECIMAL_PLACES + 1] = {};
+
+    decimalPlaces = 0;
+
+    bool overflow = false;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const unsigned int dp = numbers [idx].decimalPlaces ();
+
+        overflow |= __builtin_add_overflow (
+            totals [dp], numbers [idx].scaledValue (), &totals [dp]
+        );
+
+        decimalPlaces = std::max (decimalPlaces, dp);
+    }
+
+    __int128_t total = 0;
+
+    for (unsigned int dp = 0; dp <= decimalPlaces; ++dp)
+    {
+        __int128_t scaled;
+
+        overflow |= __builtin_mul_overflow (
+            totals [dp], Ratio::powerOfTen (decimalPlaces - dp), &scaled
+        );
+        overflow |= __builtin_add_overflow (total, scaled, &total);
+    }
+
+    if (overflow)
+    {
+        throw fixed::OverflowException (
+            "Reductions::sum () Sum exceeds 128 bits"
+        );
+    }
+
+    return total;
+}
+
+//
+// Rounding::round () only compares the remainder against halfRangeVal, so
+// doubling the remainder and using count as halfRangeVal works for odd
+// counts as well.
+//
+__int128_t Reductions::divideRounded (
+    const __int128_t sum,
+    const size_t count,
+    const Rounding::Mode roundingMode
+)
+{
+    const __int128_t divisor = static_cast<__int128_t> (count);
+
+    const __int128_t quotient = sum / divisor;
+    const __int128_t remainder = sum % divisor;
+
+    return Rounding::round<__int128_t> (
+        roundingMode,
+        quotient,
+        2 * (remainder < 0 ? -remainder : remainder),
+        divisor,
+        sum < 0
+    );
+}
+
+Number Reductions::toNumber (
+    const __int128_t value,
+    const unsigned int decimalPlaces,
+    const std::string& opName
+)
+{
+    try {
+        return Number::fromScaledValue (value, decimalPlaces);
+    }
+    catch (const fixed::BadValueException&)
+    {
+        throw fixed::OverflowException (
+            "Reductions::" + opName + " () Result too large"
+        );
+    }
+}
+
+} // namespace fixed
@@ -0,0 +1,252 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#ifndef FIXED_RESCALE_KERNEL_H
+#define FIXED_RESCALE_KERNEL_H
+
+#include "fixed/Number.h"
+#include "fixed/Rounding.h"
+#include "Ratio.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fixed {
+
+//
+// Kernels for taking int64_t mantissas down a number of decimal places,
+// rounding the same way Number::setDecimalPlaces () does.
+//
+// There is one kernel per rounding mode and number of places dropped, so
+// that the divisor is a compile time constant, which the compiler turns
+// into a multiplication by its precomputed reciprocal, and the rounding
+// decision is inlined rather than going through the std::function tables
+// in Rounding.
+//
+// The kernels work on the magnitude, so the decision is whether to round
+// it up.  That has to agree with the adjustments in Rounding.cpp, given
+// the truncated quotient, the remainder, half the divisor and 1 for a
+// negative value.  They are written as arithmetic on those so that random
+// signs don't cost a branch misprediction each.
+//
+template <Rounding::Mode MODE>
+struct RoundMagnitudeUp;
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::DOWN> {
+    static uint64_t apply (uint64_t, uint64_t r, uint64_t, uint64_t negative)
+    {
+        return negative & (r != 0);
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::UP> {
+    static uint64_t apply (uint64_t, uint64_t r, uint64_t, uint64_t negative)
+    {
+        return (negative ^ 1) & (r != 0);
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::TOWARDS_ZERO> {
+    static uint64_t apply (uint64_t, uint64_t, uint64_t, uint64_t)
+    {
+        return 0;
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::AWAY_FROM_ZERO> {
+    static uint64_t apply (uint64_t, uint64_t r, uint64_t, uint64_t)
+    {
+        return r != 0;
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::TO_NEAREST_HALF_UP> {
+    static uint64_t apply (
+        uint64_t,
+        uint64_t r,
+        uint64_t half,
+        uint64_t negative
+    )
+    {
+        return r >= half + negative;
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::TO_NEAREST_HALF_DOWN> {
+    static uint64_t apply (
+        uint64_t,
+        uint64_t r,
+        uint64_t half,
+        uint64_t negative
+    )
+    {
+        return r >= half + (negative ^ 1);
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::TO_NEAREST_HALF_AWAY_FROM_ZERO> {
+    static uint64_t apply (uint64_t, uint64_t r, uint64_t half, uint64_t)
+    {
+        return r >= half;
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::TO_NEAREST_HALF_TOWARDS_ZERO> {
+    static uint64_t apply (uint64_t, uint64_t r, uint64_t half, uint64_t)
+    {
+        return r > half;
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::TO_NEAREST_HALF_TO_EVEN> {
+    static uint64_t apply (uint64_t q, uint64_t r, uint64_t half, uint64_t)
+    {
+        return r >= half + ((q & 1) ^ 1);
+    }
+};
+
+template <>
+struct RoundMagnitudeUp<Rounding::Mode::TO_NEAREST_HALF_TO_ODD> {
+    static uint64_t apply (uint64_t q, uint64_t r, uint64_t half, uint64_t)
+    {
+        return r >= half + (q & 1);
+    }
+};
+
+typedef void (*DecreaseKernel) (
+    const int64_t* values,
+    int64_t* results,
+    const size_t count
+);
+
+//
+// Gives a meaningless result for int64_t min, which callers redo.
+//
+template <Rounding::Mode MODE, unsigned int SHIFT>
+void decreaseKernel (
+    const int64_t* values,
+    int64_t* results,
+    const size_t count
+)
+{
+    constexpr uint64_t DIVISOR = Ratio::powerOfTenConstant (SHIFT);
+    constexpr uint64_t HALF = DIVISOR / 2;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        //
+        // All ones for negative values, zero otherwise, used to take the
+        // magnitude and put the sign back without branching.
+        //
+        const uint64_t signMask =
+            static_cast<uint64_t> (values [idx] >> 63);
+        const uint64_t magnitude =
+            (static_cast<uint64_t> (values [idx]) ^ signMask) - signMask;
+
+        const uint64_t quotient = magnitude / DIVISOR;
+        const uint64_t remainder = magnitude - quotient * DIVISOR;
+
+        const uint64_t rounded = quotient + RoundMagnitudeUp<MODE>::apply (
+            quotient, remainder, HALF, signMask & 1
+        );
+
+        results [idx] = static_cast<int64_t> ((rounded ^ signMask) - signMask);
+    }
+}
+
+template <Rounding::Mode MODE, unsigned int SHIFT = 1>
+struct DecreaseKernelTable {
+    static DecreaseKernel get (const unsigned int shift)
+    {
+        return shift == SHIFT ?
+            decreaseKernel<MODE, SHIFT> :
+            DecreaseKernelTable<MODE, SHIFT + 1>::get (shift);
+    }
+};
+
+template <Rounding::Mode MODE>
+struct DecreaseKernelTable<MODE, Number::MAX_DECIMAL_PLACES + 1> {
+    static DecreaseKernel get (const unsigned int)
+    {
+        return nullptr;
+    }
+};
+
+//
+// Returns the kernel dropping shift decimal places, shift must be between
+// 1 and Number::MAX_DECIMAL_PLACES.
+//
+inline DecreaseKernel decreaseKernelFor (
+    const Rounding::Mode mode,
+    const unsigned int shift
+)
+{
+    typedef Rounding::Mode M;
+
+    switch (mode)
+    {
+        case M::DOWN:
+            return DecreaseKernelTable<M::DOWN>::get (shift);
+        case M::UP:
+            return DecreaseKernelTable<M::UP>::get (shift);
+        case M::TOWARDS_ZERO:
+            return DecreaseKernelTable<M::TOWARDS_ZERO>::get (shift);
+        case M::AWAY_FROM_ZERO:
+            return DecreaseKernelTable<M::AWAY_FROM_ZERO>::get (shift);
+        case M::TO_NEAREST_HALF_UP:
+            return DecreaseKernelTable<M::TO_NEAREST_HALF_UP>::get (shift);
+        case M::TO_NEAREST_HALF_DOWN:
+            return DecreaseKernelTable<M::TO_NEAREST_HALF_DOWN>::get (shift);
+        case M::TO_NEAREST_HALF_AWAY_FROM_ZERO:
+            return DecreaseKernelTable<
+                M::TO_NEAREST_HALF_AWAY_FROM_ZERO
+            >::get (shift);
+        case M::TO_NEAREST_HALF_TOWARDS_ZERO:
+            return DecreaseKernelTable<
+                M::TO_NEAREST_HALF_TOWARDS_ZERO
+            >::get (shift);
+        case M::TO_NEAREST_HALF_TO_EVEN:
+            return DecreaseKernelTable<M::TO_NEAREST_HALF_TO_EVEN>::get (shift);
+        case M::TO_NEAREST_HALF_TO_ODD:
+            return DecreaseKernelTable<M::TO_NEAREST_HALF_TO_ODD>::get (shift);
+        case M::MODE_MAX_VAL:
+            break;
+    }
+
+    return nullptr;
+}
+
+} // namespace fixed
+
+#endif // FIXED_RESCALE_KERNEL_H
@@ -0,0 +1,313 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/Int256.h"
+#include "fixed/RollingWindow.h"
+#include "Ratio.h"
+
+#include <limits>
+
+namespace fixed {
+
+RollingWindow::RollingWindow (
+    const size_t count,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+  : span_ (0),
+    roundingMode_ (roundingMode)
+{
+    initialise (count, decimalPlaces);
+}
+
+RollingWindow::RollingWindow (
+    const size_t capacity,
+    const int64_t span,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+)
+  : span_ (span),
+    roundingMode_ (roundingMode)
+{
+    if (span <= 0)
+    {
+        throw fixed::BadValueException (
+            "RollingWindow::RollingWindow () Span must be positive"
+        );
+    }
+
+    initialise (capacity, decimalPlaces);
+}
+
+void RollingWindow::initialise (
+    const size_t capacity,
+    const unsigned int decimalPlaces
+)
+{
+    if (! capacity)
+    {
+        throw fixed::BadValueException (
+            "RollingWindow::RollingWindow () Capacity must be positive"
+        );
+    }
+
+    if (decimalPlaces > Number::MAX_DECIMAL_PLACES)
+    {
+        throw fixed::BadValueException (
+            "RollingWindow::RollingWindow () Decimal place exceeds max"
+        );
+    }
+
+    size_t ringSize = 1;
+
+    while (ringSize < capacity)
+    {
+        ringSize <<= 1;
+    }
+
+    values_.resize (ringSize);
+    timestamps_.resize (ringSize);
+    minimums_.positions.resize (ringSize);
+    maximums_.positions.resize (ringSize);
+
+    capacity_ = capacity;
+    mask_ = ringSize - 1;
+    decimalPlaces_ = decimalPlaces;
+
+    clear ();
+}
+
+void RollingWindow::add (const Number& value)
+{
+    push (scale (value), latest_);
+}
+
+void RollingWindow::add (const Number& value, const int64_t timestamp)
+{
+    const __int128_t scaled = scale (value);
+
+    advance (timestamp);
+    push (scaled, timestamp);
+}
+
+void RollingWindow::advance (const int64_t now)
+{
+    if (now < latest_)
+    {
+        throw fixed::BadValueException (
+            "RollingWindow::advance () Timestamp before the latest one"
+        );
+    }
+
+    latest_ = now;
+
+    if (! span_)
+    {
+        return;
+    }
+
+    const __int128_t oldest = static_cast<__int128_t> (now) - span_;
+
+    while (first_ != next_ && timestamps_ [first_ & mask_] <= oldest)
+    {
+        pop ();
+    }
+}
+
+void RollingWindow::clear () noexcept
+{
+    first_ = 0;
+    next_ = 0;
+    minimums_.front = 0;
+    minimums_.back = 0;
+    maximums_.front = 0;
+    maximums_.back = 0;
+    sum_ = Int256 ();
+    latest_ = std::numeric_limits<int64_t>::min ();
+}
+
+size_t RollingWindow::size () const noexcept
+{
+    return next_ - first_;
+}
+
+bool RollingWindow::isEmpty () const noexcept
+{
+    return first_ == next_;
+}
+
+size_t RollingWindow::capacity () const noexcept
+{
+    return capacity_;
+}
+
+unsigned int RollingWindow::decimalPlaces () const noexcept
+{
+    return decimalPlaces_;
+}
+
+Number RollingWindow::sum () const
+{
+    __int128_t total;
+
+    try {
+        if (sum_.toInt128 (total))
+        {
+            return Number::fromScaledValue (total, decimalPlaces_);
+        }
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    throw fixed::OverflowException ("RollingWindow::sum () Result too large");
+}
+
+Number RollingWindow::mean (const Rounding::Mode roundingMode) const
+{
+    return mean (decimalPlaces_, roundingMode);
+}
+
+Number RollingWindow::mean (
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (isEmpty ())
+    {
+        throw fixed::BadValueException (
+            "RollingWindow::mean () Window is empty"
+        );
+    }
+
+    return Ratio::toNumber (
+        sum_,
+        Int256 (size ()),
+        decimalPlaces_,
+        decimalPlaces,
+        roundingMode,
+        "RollingWindow::mean"
+    );
+}
+
+Number RollingWindow::min () const
+{
+    if (isEmpty ())
+    {
+        throw fixed::BadValueException (
+            "RollingWindow::min () Window is empty"
+        );
+    }
+
+    return Number::fromScaledValue (
+        valueAt (minimums_.positions [minimums_.front & mask_]),
+        decimalPlaces_
+    );
+}
+
+Number RollingWindow::max () const
+{
+    if (isEmpty ())
+    {
+        throw fixed::BadValueException (
+            "RollingWindow::max () Window is empty"
+        );
+    }
+
+    return Number::fromScaledValue (
+        valueAt (maximums_.positions [maximums_.front & mask_]),
+        decimalPlaces_
+    );
+}
+
+__int128_t RollingWindow::scale (const Number& value) const
+{
+    return Ratio::rescale (value, decimalPlaces_, roundingMode_);
+}
+
+__int128_t RollingWindow::valueAt (const uint64_t position) const noexcept
+{
+    return values_ [position & mask_];
+}
+
+void RollingWindow::push (
+    const __int128_t value,
+    const int64_t timestamp
+)
+{
+    if (size () == capacity_)
+    {
+        pop ();
+    }
+
+    const uint64_t position = next_++;
+
+    values_ [position & mask_] = value;
+    timestamps_ [position & mask_] = timestamp;
+
+    //
+    // A value can never be the min while a later one is no larger, or the
+    // max while a later one is no smaller, so those are dropped.
+    //
+    while (minimums_.back != minimums_.front &&
+           valueAt (minimums_.positions [(minimums_.back - 1) & mask_]) >=
+               value)
+    {
+        --minimums_.back;
+    }
+
+    minimums_.positions [minimums_.back++ & mask_] = position;
+
+    while (maximums_.back != maximums_.front &&
+           valueAt (maximums_.positions [(maximums_.back - 1) & mask_]) <=
+               value)
+    {
+        --maximums_.back;
+    }
+
+    maximums_.positions [maximums_.back++ & mask_] = position;
+
+    sum_ += Int256 (value);
+}
+
+void RollingWindow::pop ()
+{
+    const uint64_t position = first_++;
+
+    sum_ -= Int256 (valueAt (position));
+
+    if (minimums_.positions [minimums_.front & mask_] == position)
+    {
+        ++minimums_.front;
+    }
+
+    if (maximums_.positions [maximums_.front & mask_] == position)
+    {
+        ++maximums_.front;
+    }
+}
+
+} // namespace fixed
@@ -0,0 +1,240 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ShardedAccumulator.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace fixed {
+
+static std::atomic<uint64_t> nextAccumulatorId (1);
+
+//
+// The shard the thread last used, and the accumulator it belongs to.
+//
+static thread_local uint64_t cachedAccumulatorId = 0;
+static thread_local void* cachedShard = nullptr;
+
+ShardedAccumulator::ShardedAccumulator () noexcept
+  : id_ (nextAccumulatorId.fetch_add (1, std::memory_order_relaxed)),
+    shards_ (nullptr)
+{
+}
+
+ShardedAccumulator::~ShardedAccumulator ()
+{
+    Shard* shard = shards_.load (std::memory_order_acquire);
+
+    while (shard)
+    {
+        Shard* next = shard->next;
+
+        shard->~Shard ();
+        std::free (shard);
+
+        shard = next;
+    }
+}
+
+void ShardedAccumulator::add (const Number& number)
+{
+    Shard& shard = *localShard ();
+
+    Accumulator total = read (shard);
+
+    total.add (number);
+
+    write (shard, total);
+}
+
+void ShardedAccumulator::sub (const Number& number)
+{
+    Shard& shard = *localShard ();
+
+    Accumulator total = read (shard);
+
+    total.sub (number);
+
+    write (shard, total);
+}
+
+Accumulator ShardedAccumulator::total () const noexcept
+{
+    Accumulator result;
+
+    for (const Shard* shard = shards_.load (std::memory_order_acquire);
+         shard;
+         shard = shard->next)
+    {
+        Accumulator part;
+        uint64_t before;
+        uint64_t after;
+
+        do {
+            before = shard->sequence.load (std::memory_order_acquire);
+
+            part = read (*shard);
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            after = shard->sequence.load (std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        result.merge (part);
+    }
+
+    return result;
+}
+
+Number ShardedAccumulator::snapshot () const
+{
+    return total ().toNumber ();
+}
+
+size_t ShardedAccumulator::shardCount () const noexcept
+{
+    size_t count = 0;
+
+    for (const Shard* shard = shards_.load (std::memory_order_acquire);
+         shard;
+         shard = shard->next)
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+ShardedAccumulator::Shard* ShardedAccumulator::localShard ()
+{
+    if (cachedAccumulatorId == id_)
+    {
+        return static_cast<Shard*> (cachedShard);
+    }
+
+    const std::thread::id self = std::this_thread::get_id ();
+
+    Shard* shard = shards_.load (std::memory_order_acquire);
+
+    while (shard && shard->owner != self)
+    {
+        shard = shard->next;
+    }
+
+    if (! shard)
+    {
+        shard = claimShard ();
+    }
+
+    cachedAccumulatorId = id_;
+    cachedShard = shard;
+
+    return shard;
+}
+
+ShardedAccumulator::Shard* ShardedAccumulator::claimShard ()
+{
+    //
+    // Rounding the size up to whole cache lines, as well as aligning it,
+    // keeps the shard from sharing a line with anything else.
+    //
+    const size_t size =
+        (sizeof (Shard) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE *
+        CACHE_LINE_SIZE;
+
+    void* memory = nullptr;
+
+    if (posix_memalign (&memory, CACHE_LINE_SIZE, size))
+    {
+        throw std::bad_alloc ();
+    }
+
+    Shard* shard = new (memory) Shard ();
+
+    shard->sequence.store (0, std::memory_order_relaxed);
+    write (*shard, Accumulator ());
+    shard->owner = std::this_thread::get_id ();
+    shard->next = shards_.load (std::memory_order_relaxed);
+
+    while (! shards_.compare_exchange_weak (
+               shard->next,
+               shard,
+               std::memory_order_release,
+               std::memory_order_relaxed
+           ))
+    {
+    }
+
+    return shard;
+}
+
+Accumulator ShardedAccumulator::read (const Shard& shard) noexcept
+{
+    Accumulator total;
+
+    total.low_ =
+        static_cast<__uint128_t> (
+            shard.middle.load (std::memory_order_relaxed)
+        ) << 64 |
+        shard.low.load (std::memory_order_relaxed);
+    total.high_ = static_cast<int64_t> (
+        shard.high.load (std::memory_order_relaxed)
+    );
+    total.decimalPlaces_ = static_cast<uint8_t> (
+        shard.decimalPlaces.load (std::memory_order_relaxed)
+    );
+
+    return total;
+}
+
+void ShardedAccumulator::write (
+    Shard& shard,
+    const Accumulator& total
+) noexcept
+{
+    const uint64_t sequence = shard.sequence.load (std::memory_order_relaxed);
+
+    shard.sequence.store (sequence + 1, std::memory_order_relaxed);
+
+    std::atomic_thread_fence (std::memory_order_release);
+
+    shard.low.store (
+        static_cast<uint64_t> (total.low_), std::memory_order_relaxed
+    );
+    shard.middle.store (
+        static_cast<uint64_t> (total.low_ >> 64), std::memory_order_relaxed
+    );
+    shard.high.store (
+        static_cast<uint64_t> (total.high_), std::memory_order_relaxed
+    );
+    shard.decimalPlaces.store (
+        total.decimalPlaces_, std::memory_order_relaxed
+    );
+
+    shard.sequence.store (sequence + 2, std::memory_order_release);
+}
+
+} // namespace fixed
@@ -0,0 +1,316 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Sort.h"
+#include "Ratio.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace fixed {
+
+//
+// Below this many Numbers a comparison sort of the keys is quicker than the
+// radix passes.
+//
+static const size_t RADIX_MIN_COUNT = 256;
+
+static const unsigned int RADIX_BITS = 8;
+
+static const size_t RADIX_BUCKETS = size_t (1) << RADIX_BITS;
+
+template <typename Key>
+struct SortEntry {
+    Key key;
+    size_t index;
+};
+
+//
+// The value of number at scale decimal places, which can't overflow as the
+// integer part of a Number is at most MAX_INTEGER_VALUE.
+//
+static __int128_t commonScaleValue (
+    const Number& number,
+    const unsigned int scale
+)
+{
+    return number.scaledValue () *
+           Ratio::powerOfTen (scale - number.decimalPlaces ());
+}
+
+//
+// Finds the largest decimal places among the numbers, and the smallest and
+// largest values at that scale.  Only the extremes for each decimal places
+// are tracked, so the numbers are read once.
+//
+static unsigned int commonScale (
+    const Number* numbers,
+    const size_t count,
+    __int128_t& lowest,
+    __int128_t& highest
+)
+{
+    const Number* lowestAt [Number::MAX_DECIMAL_PLACES + 1] = {};
+    const Number* highestAt [Number::MAX_DECIMAL_PLACES + 1] = {};
+
+    unsigned int scale = 0;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const Number& number = numbers [idx];
+        const unsigned int decimalPlaces = number.decimalPlaces ();
+
+        if (! lowestAt [decimalPlaces])
+        {
+            lowestAt [decimalPlaces] = highestAt [decimalPlaces] = &number;
+        }
+        else if (number.scaledValue () <
+                 lowestAt [decimalPlaces]->scaledValue ())
+        {
+            lowestAt [decimalPlaces] = &number;
+        }
+        else if (number.scaledValue () >
+                 highestAt [decimalPlaces]->scaledValue ())
+        {
+            highestAt [decimalPlaces] = &number;
+        }
+
+        scale = std::max (scale, decimalPlaces);
+    }
+
+    lowest = std::numeric_limits<__int128_t>::max ();
+    highest = std::numeric_limits<__int128_t>::min ();
+
+    for (unsigned int dp = 0; dp <= scale; ++dp)
+    {
+        if (lowestAt [dp])
+        {
+            lowest = std::min (
+                lowest, commonScaleValue (*lowestAt [dp], scale)
+            );
+            highest = std::max (
+                highest, commonScaleValue (*highestAt [dp], scale)
+            );
+        }
+    }
+
+    return scale;
+}
+
+template <typename Key>
+static size_t radixDigit (const Key key, const unsigned int digit)
+{
+    return static_cast<size_t> (key >> (digit * RADIX_BITS)) &
+           (RADIX_BUCKETS - 1);
+}
+
+//
+// A least significant digit first radix sort, which is stable.  The counts
+// for every digit are gathered in one read of the entries, and digits that
+// are the same for every key, such as the high ones when the values are
+// close together, are skipped.
+//
+template <typename Key>
+static void radixSort (std::vector<SortEntry<Key>>& entries)
+{
+    const unsigned int KEY_DIGITS = sizeof (Key) * 8 / RADIX_BITS;
+
+    const size_t count = entries.size ();
+
+    std::vector<size_t> counts (KEY_DIGITS * RADIX_BUCKETS);
+
+    for (const auto& entry: entries)
+    {
+        for (unsigned int digit = 0; digit < KEY_DIGITS; ++digit)
+        {
+            ++counts [digit * RADIX_BUCKETS + radixDigit (entry.key, digit)];
+        }
+    }
+
+    std::vector<SortEntry<Key>> buffer (count);
+
+    SortEntry<Key>* from = entries.data ();
+    SortEntry<Key>* to = buffer.data ();
+
+    for (unsigned int digit = 0; digit < KEY_DIGITS; ++digit)
+    {
+        size_t* offsets = &counts [digit * RADIX_BUCKETS];
+
+        if (offsets [radixDigit (from [0].key, digit)] == count)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+
+        for (size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+        {
+            const size_t bucketCount = offsets [bucket];
+
+            offsets [bucket] = offset;
+            offset += bucketCount;
+        }
+
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            to [offsets [radixDigit (from [idx].key, digit)]++] = from [idx];
+        }
+
+        std::swap (from, to);
+    }
+
+    if (from != entries.data ())
+    {
+        entries.swap (buffer);
+    }
+}
+
+//
+// The keys are the values at the common scale less the lowest of them, so
+// they are unsigned, order preserving and need as few digits as the spread
+// of the values allows.
+//
+template <typename Key>
+static std::vector<SortEntry<Key>> sortedEntries (
+    const Number* numbers,
+    const size_t count,
+    const unsigned int scale,
+    const __int128_t lowest
+)
+{
+    __int128_t powers [Number::MAX_DECIMAL_PLACES + 1];
+
+    for (unsigned int dp = 0; dp <= scale; ++dp)
+    {
+        powers [dp] = Ratio::powerOfTen (scale - dp);
+    }
+
+    std::vector<SortEntry<Key>> entries (count);
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const Number& number = numbers [idx];
+
+        entries [idx].key = static_cast<Key> (
+            number.scaledValue () * powers [number.decimalPlaces ()] - lowest
+        );
+        entries [idx].index = idx;
+    }
+
+    if (count < RADIX_MIN_COUNT)
+    {
+        std::stable_sort (
+            entries.begin (),
+            entries.end (),
+            [] (const SortEntry<Key>& lhs, const SortEntry<Key>& rhs) {
+                return lhs.key < rhs.key;
+            }
+        );
+    }
+    else
+    {
+        radixSort (entries);
+    }
+
+    return entries;
+}
+
+//
+// Calls visit with the index of each Number in sorted order.
+//
+template <typename Visit>
+static void visitSorted (
+    const Number* numbers,
+    const size_t count,
+    const Visit& visit
+)
+{
+    if (! count)
+    {
+        return;
+    }
+
+    __int128_t lowest;
+    __int128_t highest;
+
+    const unsigned int scale = commonScale (numbers, count, lowest, highest);
+
+    if (static_cast<__uint128_t> (highest - lowest) <=
+        std::numeric_limits<uint64_t>::max ())
+    {
+        for (const auto& entry:
+             sortedEntries<uint64_t> (numbers, count, scale, lowest))
+        {
+            visit (entry.index);
+        }
+    }
+    else
+    {
+        for (const auto& entry:
+             sortedEntries<__uint128_t> (numbers, count, scale, lowest))
+        {
+            visit (entry.index);
+        }
+    }
+}
+
+void sort (Number* numbers, const size_t count)
+{
+    std::vector<Number> sorted;
+
+    sorted.reserve (count);
+
+    visitSorted (numbers, count, [&] (const size_t idx) {
+        sorted.push_back (numbers [idx]);
+    });
+
+    std::copy (sorted.begin (), sorted.end (), numbers);
+}
+
+void sort (std::vector<Number>& numbers)
+{
+    sort (numbers.data (), numbers.size ());
+}
+
+std::vector<size_t> argsort (const Number* numbers, const size_t count)
+{
+    std::vector<size_t> order;
+
+    order.reserve (count);
+
+    visitSorted (numbers, count, [&] (const size_t idx) {
+        order.push_back (idx);
+    });
+
+    return order;
+}
+
+std::vector<size_t> argsort (const std::vector<Number>& numbers)
+{
+    return argsort (numbers.data (), numbers.size ());
+}
+
+} // namespace fixed
@@ -0,0 +1,413 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/StreamingStats.h"
+#include "Ratio.h"
+
+#include <algorithm>
+
+namespace fixed {
+
+Vwap::Vwap () noexcept
+  : notional_ (),
+    quantity_ (),
+    count_ (0),
+    priceDecimalPlaces_ (0),
+    quantityDecimalPlaces_ (0)
+{
+}
+
+void Vwap::add (const Number& price, const Number& quantity)
+{
+    const unsigned int priceDecimalPlaces = price.decimalPlaces ();
+    const unsigned int quantityDecimalPlaces = quantity.decimalPlaces ();
+
+    //
+    // Work on copies, so a throw leaves the sums as they were.
+    //
+    Int256 notional (notional_);
+    Int256 quantityTotal (quantity_);
+
+    if (priceDecimalPlaces > priceDecimalPlaces_)
+    {
+        notional *= Int256 (
+            Ratio::powerOfTen (priceDecimalPlaces - priceDecimalPlaces_)
+        );
+    }
+
+    if (quantityDecimalPlaces > quantityDecimalPlaces_)
+    {
+        const Int256 factor (
+            Ratio::powerOfTen (quantityDecimalPlaces - quantityDecimalPlaces_)
+        );
+
+        notional *= factor;
+        quantityTotal *= factor;
+    }
+
+    const unsigned int newPriceDecimalPlaces =
+        std::max<unsigned int> (priceDecimalPlaces, priceDecimalPlaces_);
+    const unsigned int newQuantityDecimalPlaces =
+        std::max<unsigned int> (quantityDecimalPlaces, quantityDecimalPlaces_);
+
+    //
+    // A scaled value is below 2^110, so these can't overflow.
+    //
+    const __int128_t scaledPrice =
+        price.scaledValue () *
+        Ratio::powerOfTen (newPriceDecimalPlaces - priceDecimalPlaces);
+    const __int128_t scaledQuantity =
+        quantity.scaledValue () *
+        Ratio::powerOfTen (newQuantityDecimalPlaces - quantityDecimalPlaces);
+
+    notional += Int256::multiply (scaledPrice, scaledQuantity);
+    quantityTotal += Int256 (scaledQuantity);
+
+    notional_ = notional;
+    quantity_ = quantityTotal;
+    priceDecimalPlaces_ = newPriceDecimalPlaces;
+    quantityDecimalPlaces_ = newQuantityDecimalPlaces;
+    ++count_;
+}
+
+void Vwap::clear () noexcept
+{
+    *this = Vwap ();
+}
+
+bool Vwap::isEmpty () const noexcept
+{
+    return ! count_;
+}
+
+Number Vwap::vwap (const Rounding::Mode roundingMode) const
+{
+    return vwap (priceDecimalPlaces_, roundingMode);
+}
+
+Number Vwap::vwap (
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (! count_)
+    {
+        throw fixed::BadValueException ("Vwap::vwap () No values added");
+    }
+
+    if (quantity_.isZero ())
+    {
+        throw fixed::DivideByZeroException (
+            "Vwap::vwap () Quantities add up to zero"
+        );
+    }
+
+    return Ratio::toNumber (
+        notional_,
+        quantity_,
+        priceDecimalPlaces_,
+        decimalPlaces,
+        roundingMode,
+        "Vwap::vwap"
+    );
+}
+
+Twap::Twap () noexcept
+  : weighted_ (),
+    lastPrice_ (0),
+    firstTimestamp_ (0),
+    lastTimestamp_ (0),
+    count_ (0),
+    decimalPlaces_ (0)
+{
+}
+
+void Twap::add (const Number& price, const int64_t timestamp)
+{
+    if (count_ && timestamp < lastTimestamp_)
+    {
+        throw fixed::BadValueException (
+            "Twap::add () Timestamp before the last one added"
+        );
+    }
+
+    const unsigned int priceDecimalPlaces = price.decimalPlaces ();
+
+    Int256 weighted (weighted_);
+    __int128_t lastPrice = lastPrice_;
+
+    if (priceDecimalPlaces > decimalPlaces_)
+    {
+        const __int128_t factor =
+            Ratio::powerOfTen (priceDecimalPlaces - decimalPlaces_);
+
+        weighted *= Int256 (factor);
+        lastPrice *= factor;
+    }
+
+    const unsigned int newDecimalPlaces =
+        std::max<unsigned int> (priceDecimalPlaces, decimalPlaces_);
+
+    if (count_)
+    {
+        weighted += Int256::multiply (
+            lastPrice,
+            static_cast<__int128_t> (timestamp) - lastTimestamp_
+        );
+    }
+    else
+    {
+        firstTimestamp_ = timestamp;
+    }
+
+    weighted_ = weighted;
+    lastPrice_ =
+        price.scaledValue () *
+        Ratio::powerOfTen (newDecimalPlaces - priceDecimalPlaces);
+    lastTimestamp_ = timestamp;
+    decimalPlaces_ = newDecimalPlaces;
+    ++count_;
+}
+
+void Twap::clear () noexcept
+{
+    *this = Twap ();
+}
+
+bool Twap::isEmpty () const noexcept
+{
+    return ! count_;
+}
+
+Number Twap::twap (
+    const int64_t endTime,
+    const Rounding::Mode roundingMode
+) const
+{
+    return twap (endTime, decimalPlaces_, roundingMode);
+}
+
+Number Twap::twap (
+    const int64_t endTime,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (! count_)
+    {
+        throw fixed::BadValueException ("Twap::twap () No values added");
+    }
+
+    if (endTime < lastTimestamp_)
+    {
+        throw fixed::BadValueException (
+            "Twap::twap () End time before the last timestamp added"
+        );
+    }
+
+    if (endTime == firstTimestamp_)
+    {
+        return Ratio::toNumber (
+            Int256 (lastPrice_),
+            Int256 (1),
+            decimalPlaces_,
+            decimalPlaces,
+            roundingMode,
+            "Twap::twap"
+        );
+    }
+
+    Int256 weighted (weighted_);
+
+    weighted += Int256::multiply (
+        lastPrice_,
+        static_cast<__int128_t> (endTime) - lastTimestamp_
+    );
+
+    return Ratio::toNumber (
+        weighted,
+        Int256 (static_cast<__int128_t> (endTime) - firstTimestamp_),
+        decimalPlaces_,
+        decimalPlaces,
+        roundingMode,
+        "Twap::twap"
+    );
+}
+
+RunningVariance::RunningVariance () noexcept
+  : sum_ (),
+    sumSquares_ (),
+    count_ (0),
+    decimalPlaces_ (0)
+{
+}
+
+void RunningVariance::add (const Number& number)
+{
+    const unsigned int decimalPlaces = number.decimalPlaces ();
+
+    Int256 sum (sum_);
+    Int256 sumSquares (sumSquares_);
+
+    if (decimalPlaces > decimalPlaces_)
+    {
+        const unsigned int shift = decimalPlaces - decimalPlaces_;
+
+        sum *= Int256 (Ratio::powerOfTen (shift));
+        sumSquares *= Int256 (Ratio::powerOfTen (2 * shift));
+    }
+
+    const unsigned int newDecimalPlaces =
+        std::max<unsigned int> (decimalPlaces, decimalPlaces_);
+
+    const __int128_t value =
+        number.scaledValue () *
+        Ratio::powerOfTen (newDecimalPlaces - decimalPlaces);
+
+    sum += Int256 (value);
+    sumSquares += Int256::multiply (value, value);
+
+    sum_ = sum;
+    sumSquares_ = sumSquares;
+    decimalPlaces_ = newDecimalPlaces;
+    ++count_;
+}
+
+void RunningVariance::clear () noexcept
+{
+    *this = RunningVariance ();
+}
+
+uint64_t RunningVariance::count () const noexcept
+{
+    return count_;
+}
+
+Number RunningVariance::mean (const Rounding::Mode roundingMode) const
+{
+    return mean (decimalPlaces_, roundingMode);
+}
+
+Number RunningVariance::mean (
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (! count_)
+    {
+        throw fixed::BadValueException (
+            "RunningVariance::mean () No values added"
+        );
+    }
+
+    return Ratio::toNumber (
+        sum_,
+        Int256 (count_),
+        decimalPlaces_,
+        decimalPlaces,
+        roundingMode,
+        "RunningVariance::mean"
+    );
+}
+
+Number RunningVariance::variance (const Rounding::Mode roundingMode) const
+{
+    return variance (varianceDecimalPlaces (), roundingMode);
+}
+
+Number RunningVariance::variance (
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (! count_)
+    {
+        throw fixed::BadValueException (
+            "RunningVariance::variance () No values added"
+        );
+    }
+
+    return Ratio::toNumber (
+        spread (),
+        Int256::multiply (count_, count_),
+        2 * decimalPlaces_,
+        decimalPlaces,
+        roundingMode,
+        "RunningVariance::variance"
+    );
+}
+
+Number RunningVariance::sampleVariance (
+    const Rounding::Mode roundingMode
+) const
+{
+    return sampleVariance (varianceDecimalPlaces (), roundingMode);
+}
+
+Number RunningVariance::sampleVariance (
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode
+) const
+{
+    if (count_ < 2)
+    {
+        throw fixed::BadValueException (
+            "RunningVariance::sampleVariance () Fewer than two values added"
+        );
+    }
+
+    return Ratio::toNumber (
+        spread (),
+        Int256::multiply (count_, count_ - 1),
+        2 * decimalPlaces_,
+        decimalPlaces,
+        roundingMode,
+        "RunningVariance::sampleVariance"
+    );
+}
+
+Int256 RunningVariance::spread () const
+{
+    Int256 result (sumSquares_);
+    Int256 square (sum_);
+
+    result *= Int256 (count_);
+    square *= sum_;
+    result -= square;
+
+    return result;
+}
+
+unsigned int RunningVariance::varianceDecimalPlaces () const noexcept
+{
+    const unsigned int decimalPlaces = 2 * decimalPlaces_;
+
+    return decimalPlaces < Number::MAX_DECIMAL_PLACES ?
+           decimalPlaces :
+           Number::MAX_DECIMAL_PLACES;
+}
+
+} // namespace fixed
@@ -0,0 +1,401 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/ThreadPool.h"
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace fixed {
+
+static const uint64_t CHUNK_MASK = std::numeric_limits<uint32_t>::max ();
+
+//
+// The pool whose job the thread is running chunks of, if any, so a job
+// started from inside a task on the same pool can be spotted.
+//
+static thread_local const ThreadPool* runningPool = nullptr;
+
+//
+// Marks the calling thread as running a job of pool until destroyed.
+//
+class RunningPoolScope {
+  public:
+    explicit RunningPoolScope (const ThreadPool* pool) noexcept
+      : previous_ (runningPool)
+    {
+        runningPool = pool;
+    }
+
+    ~RunningPoolScope ()
+    {
+        runningPool = previous_;
+    }
+
+    RunningPoolScope (const RunningPoolScope&) = delete;
+    RunningPoolScope& operator= (const RunningPoolScope&) = delete;
+
+  private:
+    const ThreadPool* previous_;
+};
+
+static uint64_t packRange (const uint64_t begin, const uint64_t end) noexcept
+{
+    return begin << 32 | end;
+}
+
+static unsigned int sharedThreads () noexcept
+{
+    const char* requested = std::getenv ("FIXED_THREADS");
+
+    if (requested)
+    {
+        const long threads = std::strtol (requested, nullptr, 10);
+
+        if (threads > 0 && threads <= 1024)
+        {
+            return threads;
+        }
+    }
+
+    const unsigned int hardware = std::thread::hardware_concurrency ();
+
+    return hardware ? hardware : 1;
+}
+
+ThreadPool::ThreadPool (const unsigned int threads)
+  : threads_ (threads),
+    ranges_ (nullptr),
+    task_ (nullptr),
+    generation_ (0),
+    active_ (0),
+    stopping_ (false),
+    failed_ (false)
+{
+    if (! threads)
+    {
+        throw fixed::BadValueException (
+            "ThreadPool::ThreadPool () Threads must be positive"
+        );
+    }
+
+    void* memory = nullptr;
+
+    if (posix_memalign (&memory, CACHE_LINE_SIZE, threads * sizeof (Range)))
+    {
+        throw std::bad_alloc ();
+    }
+
+    ranges_ = static_cast<Range*> (memory);
+
+    for (unsigned int idx = 0; idx < threads; ++idx)
+    {
+        new (ranges_ + idx) Range ();
+
+        ranges_ [idx].chunks.store (0, std::memory_order_relaxed);
+    }
+
+    workers_.reserve (threads - 1);
+
+    for (unsigned int idx = 1; idx < threads; ++idx)
+    {
+        workers_.emplace_back (&ThreadPool::workerLoop, this, idx);
+    }
+}
+
+ThreadPool::~ThreadPool ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+
+        stopping_ = true;
+    }
+
+    start_.notify_all ();
+
+    for (auto& worker: workers_)
+    {
+        worker.join ();
+    }
+
+    std::free (ranges_);
+}
+
+unsigned int ThreadPool::threads () const noexcept
+{
+    return threads_;
+}
+
+void ThreadPool::run (
+    const size_t chunks,
+    const std::function<void (size_t)>& task
+)
+{
+    if (chunks > CHUNK_MASK)
+    {
+        throw fixed::BadValueException ("ThreadPool::run () Too many chunks");
+    }
+
+    //
+    // The pool's threads are busy with the job this is nested in, and the
+    // caller holds runMutex_, so waiting for them would never end.
+    //
+    if (runningPool == this)
+    {
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            task (chunk);
+        }
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock (runMutex_);
+
+    const RunningPoolScope scope (this);
+
+    if (threads_ == 1 || chunks < 2)
+    {
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            task (chunk);
+        }
+
+        return;
+    }
+
+    for (unsigned int idx = 0; idx < threads_; ++idx)
+    {
+        ranges_ [idx].chunks.store (
+            packRange (idx * chunks / threads_, (idx + 1) * chunks / threads_),
+            std::memory_order_relaxed
+        );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+
+        task_ = &task;
+        failed_.store (false, std::memory_order_relaxed);
+        error_ = nullptr;
+        active_ = threads_ - 1;
+        ++generation_;
+    }
+
+    start_.notify_all ();
+
+    work (0);
+
+    std::unique_lock<std::mutex> lock (mutex_);
+
+    finish_.wait (lock, [this] () { return ! active_; });
+
+    task_ = nullptr;
+
+    if (error_)
+    {
+        std::rethrow_exception (error_);
+    }
+}
+
+ThreadPool& ThreadPool::shared ()
+{
+    static ThreadPool pool (sharedThreads ());
+
+    return pool;
+}
+
+void ThreadPool::workerLoop (const unsigned int self)
+{
+    const RunningPoolScope scope (this);
+
+    uint64_t generation = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock (mutex_);
+
+            start_.wait (lock, [this, generation] () {
+                return stopping_ || generation_ != generation;
+            });
+
+            if (stopping_)
+            {
+                return;
+            }
+
+            generation = generation_;
+        }
+
+        work (self);
+
+        bool last;
+
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+
+            last = ! --active_;
+        }
+
+        if (last)
+        {
+            finish_.notify_one ();
+        }
+    }
+}
+
+void ThreadPool::work (const unsigned int self)
+{
+    size_t chunk;
+
+    while (next (self, chunk))
+    {
+        if (failed_.load (std::memory_order_relaxed))
+        {
+            continue;
+        }
+
+        try {
+            (*task_) (chunk);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+
+            if (! error_)
+            {
+                error_ = std::current_exception ();
+            }
+
+            failed_.store (true, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ThreadPool::next (const unsigned int self, size_t& chunk)
+{
+    //
+    // No chunks are added once a job has started, they only move between
+    // ranges, so a pass over the others finding nothing to steal means
+    // every chunk has been taken.  What was stolen can be stolen again
+    // before it is taken, hence the loop.
+    //
+    for (;;)
+    {
+        if (take (self, chunk))
+        {
+            return true;
+        }
+
+        bool stolen = false;
+
+        for (unsigned int offset = 1; offset < threads_ && ! stolen; ++offset)
+        {
+            stolen = steal (self, (self + offset) % threads_);
+        }
+
+        if (! stolen)
+        {
+            return false;
+        }
+    }
+}
+
+bool ThreadPool::take (const unsigned int self, size_t& chunk)
+{
+    std::atomic<uint64_t>& range = ranges_ [self].chunks;
+
+    uint64_t current = range.load (std::memory_order_acquire);
+
+    for (;;)
+    {
+        const uint64_t begin = current >> 32;
+        const uint64_t end = current & CHUNK_MASK;
+
+        if (begin >= end)
+        {
+            return false;
+        }
+
+        if (range.compare_exchange_weak (
+                current,
+                packRange (begin + 1, end),
+                std::memory_order_acq_rel,
+                std::memory_order_acquire
+            ))
+        {
+            chunk = begin;
+
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::steal (const unsigned int self, const unsigned int victim)
+{
+    std::atomic<uint64_t>& range = ranges_ [victim].chunks;
+
+    uint64_t current = range.load (std::memory_order_acquire);
+
+    for (;;)
+    {
+        const uint64_t begin = current >> 32;
+        const uint64_t end = current & CHUNK_MASK;
+
+        if (begin >= end)
+        {
+            return false;
+        }
+
+        //
+        // The back half, rounded up, so a single chunk can be stolen.
+        //
+        const uint64_t middle = begin + (end - begin) / 2;
+
+        if (range.compare_exchange_weak (
+                current,
+                packRange (begin, middle),
+                std::memory_order_acq_rel,
+                std::memory_order_acquire
+            ))
+        {
+            //
+            // Only the owner stores to its own range, and only once it is
+            // empty, the others CAS against what they saw so they can't
+            // have taken anything from it.
+            //
+            ranges_ [self].chunks.store (
+                packRange (middle, end), std::memory_order_release
+            );
+
+            return true;
+        }
+    }
+}
+
+} // namespace fixed
@@ -0,0 +1,259 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Accumulator.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static const std::string MAX_NUMBER = "9223372036854775807.99999999999999";
+
+static bool checkTotal (
+    const Number& result,
+    const std::string& expected,
+    const std::string& description
+)
+{
+    if (result.toString () != expected)
+    {
+        std::cerr << description << " gave " << result.toString ()
+                  << " expected " << expected << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool emptyAccumulatorTest ()
+{
+    Accumulator accumulator;
+
+    return
+        accumulator.isZero () &&
+        accumulator.decimalPlaces () == 0 &&
+        checkTotal (accumulator.toNumber (), "0", "Empty total");
+}
+
+//
+// Random values at mixed decimal places, added and subtracted, match a loop
+// over operator+= and operator-=.
+//
+static bool mixedScaleAccumulatorTest ()
+{
+    std::mt19937_64 generator (17);
+
+    Accumulator accumulator;
+    Number expected (0);
+
+    for (unsigned int i = 0; i < 10000; ++i)
+    {
+        const Number number (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >> (12 + generator () % 52),
+                generator () % (Number::MAX_DECIMAL_PLACES + 1)
+            )
+        );
+
+        if (i % 3)
+        {
+            accumulator.add (number);
+            expected += number;
+        }
+        else
+        {
+            accumulator.sub (number);
+            expected -= number;
+        }
+    }
+
+    return
+        accumulator.decimalPlaces () == expected.decimalPlaces () &&
+        checkTotal (
+            accumulator.toNumber (), expected.toString (), "Mixed scale total"
+        );
+}
+
+//
+// The total can pass MAX_INTEGER_VALUE, and 128 bits, and come back.
+//
+static bool intermediateOverflowTest ()
+{
+    const Number max (MAX_NUMBER);
+
+    Accumulator accumulator;
+
+    accumulator.add (max);
+    accumulator.add (max);
+    accumulator.add (Number ("1.5"));
+
+    try {
+        accumulator.toNumber ();
+
+        std::cerr << "Accumulator::toNumber expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+
+    accumulator.sub (max);
+    accumulator.sub (max);
+
+    if (! checkTotal (accumulator.toNumber (), "1.50000000000000", "Total"))
+    {
+        return false;
+    }
+
+    //
+    // 2^17 of the largest Numbers exceed 128 bits.
+    //
+    const unsigned int count = 300000;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        accumulator.sub (max);
+    }
+
+    try {
+        accumulator.toNumber ();
+
+        std::cerr << "Accumulator::toNumber expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        accumulator.add (max);
+    }
+
+    accumulator.sub (Number ("1.5"));
+
+    return accumulator.isZero ();
+}
+
+static bool mergeAccumulatorTest ()
+{
+    std::mt19937_64 generator (19);
+
+    Accumulator whole;
+    Accumulator parts [3];
+
+    for (unsigned int i = 0; i < 3000; ++i)
+    {
+        const Number number (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >> 12,
+                generator () % (Number::MAX_DECIMAL_PLACES + 1)
+            )
+        );
+
+        whole.add (number);
+        parts [i % 3].add (number);
+    }
+
+    parts [0].merge (parts [1]);
+    parts [0].merge (parts [2]);
+
+    return
+        parts [0].decimalPlaces () == whole.decimalPlaces () &&
+        checkTotal (
+            parts [0].toNumber (), whole.toNumber ().toString (), "Merged total"
+        );
+}
+
+static bool roundedTotalTest ()
+{
+    Accumulator accumulator;
+
+    accumulator.add (Number ("1.25"));
+    accumulator.add (Number ("1.0"));
+
+    Accumulator negative;
+
+    negative.sub (Number ("2.25"));
+
+    try {
+        accumulator.toNumber (Number::MAX_DECIMAL_PLACES + 1,
+                              Rounding::Mode::DOWN);
+
+        std::cerr << "Accumulator::toNumber expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    return
+        checkTotal (
+            accumulator.toNumber (1, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "2.2",
+            "Half to even total"
+        ) &&
+        checkTotal (
+            accumulator.toNumber (1, Rounding::Mode::TO_NEAREST_HALF_UP),
+            "2.3",
+            "Half up total"
+        ) &&
+        checkTotal (
+            accumulator.toNumber (4, Rounding::Mode::DOWN),
+            "2.2500",
+            "Widened total"
+        ) &&
+        checkTotal (
+            negative.toNumber (1, Rounding::Mode::DOWN),
+            "-2.3",
+            "Negative round down total"
+        ) &&
+        checkTotal (
+            negative.toNumber (0, Rounding::Mode::TOWARDS_ZERO),
+            "-2",
+            "Negative towards zero total"
+        );
+}
+
+std::vector<Test> AccumulatorTestVec = {
+    {emptyAccumulatorTest, TestName ("Accumulator empty")},
+    {mixedScaleAccumulatorTest, TestName ("Accumulator mixed scales")},
+    {intermediateOverflowTest, TestName ("Accumulator intermediate overflow")},
+    {mergeAccumulatorTest, TestName ("Accumulator merge")},
+    {roundedTotalTest, TestName ("Accumulator rounded total")}
+};
+
+} // namespace test
+} // namespace fixed
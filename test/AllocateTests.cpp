@@ -0,0 +1,329 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Allocate.h"
+#include "fixed/Exceptions.h"
+#include "fixed/Int256.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static bool checkAllocation (
+    const std::string& total,
+    const std::vector<std::string>& weights,
+    const std::vector<std::string>& expected,
+    const Rounding::Mode mode = Number::DEFAULT_ROUNDING_MODE
+)
+{
+    std::vector<Number> weightValues;
+
+    for (const auto& weight: weights)
+    {
+        weightValues.push_back (Number (weight));
+    }
+
+    std::vector<Number> out (weights.size ());
+
+    allocate (
+        Number (total), weightValues.data (), weights.size (), out.data (), mode
+    );
+
+    for (size_t idx = 0; idx < out.size (); ++idx)
+    {
+        if (out [idx].toString () != expected [idx])
+        {
+            std::cerr << "allocate (" << total << ") leg " << idx
+                      << " gave " << out [idx].toString ()
+                      << " expected " << expected [idx] << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// The legs add up to total and each is within a unit in the last place of
+// total * weight / sum of weights.
+//
+static bool checkConserved (
+    const Number& total,
+    const std::vector<Number>& weights,
+    const std::vector<Number>& out,
+    const std::string& description
+)
+{
+    unsigned int weightDecimalPlaces = 0;
+
+    for (const auto& weight: weights)
+    {
+        weightDecimalPlaces =
+            std::max (weightDecimalPlaces, weight.decimalPlaces ());
+    }
+
+    std::vector<__int128_t> scaledWeights;
+    __int128_t weightSum = 0;
+
+    for (const auto& weight: weights)
+    {
+        Number rescaled = weight;
+
+        rescaled.setDecimalPlaces (weightDecimalPlaces);
+        scaledWeights.push_back (rescaled.scaledValue ());
+        weightSum += rescaled.scaledValue ();
+    }
+
+    __int128_t allocated = 0;
+
+    for (size_t idx = 0; idx < out.size (); ++idx)
+    {
+        if (out [idx].decimalPlaces () != total.decimalPlaces ())
+        {
+            std::cerr << description << " leg " << idx << " decimal places "
+                      << out [idx].decimalPlaces () << std::endl;
+
+            return false;
+        }
+
+        Int256 error =
+            Int256::multiply (total.scaledValue (), scaledWeights [idx]);
+
+        error -= Int256::multiply (out [idx].scaledValue (), weightSum);
+
+        if (! (Int256 (-weightSum) < error && error < Int256 (weightSum)))
+        {
+            std::cerr << description << " leg " << idx << " gave "
+                      << out [idx].toString () << " more than a unit out"
+                      << std::endl;
+
+            return false;
+        }
+
+        allocated += out [idx].scaledValue ();
+    }
+
+    if (allocated != total.scaledValue ())
+    {
+        std::cerr << description << " legs sum to "
+                  << Number::fromScaledValue (
+                         allocated, total.decimalPlaces ()
+                     ).toString ()
+                  << " expected " << total.toString () << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool knownTest ()
+{
+    return checkAllocation (
+            "100.00", {"1", "1", "1"}, {"33.34", "33.33", "33.33"}
+        ) &&
+        checkAllocation (
+            "-100.00", {"1", "1", "1"}, {"-33.34", "-33.33", "-33.33"}
+        ) &&
+        checkAllocation (
+            "100.00",
+            {"1", "1", "1"},
+            {"33.33", "33.33", "33.34"},
+            Rounding::Mode::UP
+        ) &&
+        checkAllocation (
+            "100.00",
+            {"1", "1", "1"},
+            {"33.34", "33.33", "33.33"},
+            Rounding::Mode::DOWN
+        ) &&
+        checkAllocation ("1", {"1", "1"}, {"1", "0"}) &&
+        checkAllocation ("10", {"0.5", "1.25", "3"}, {"1", "3", "6"}) &&
+        checkAllocation (
+            "0.05", {"2", "0", "1", "1"}, {"0.03", "0.00", "0.01", "0.01"}
+        ) &&
+        checkAllocation (
+            "1000", {"0.2", "0.3", "0.5"}, {"200", "300", "500"}
+        ) &&
+        checkAllocation ("0", {"3", "1"}, {"0", "0"}) &&
+        checkAllocation ("7.5", {"0", "4"}, {"0.0", "7.5"}) &&
+        checkAllocation (
+            "92233720368547758.07",
+            {"92233720368547758.07", "1", "0.00000000000001"},
+            {"92233720368547757.07", "1.00", "0.00"}
+        );
+}
+
+static bool errorTest ()
+{
+    const Number total ("100");
+    const Number weights [] = {Number (1), Number (-1), Number (0)};
+    Number out [3];
+
+    return expectException<fixed::BadValueException> (
+            [&] () { allocate (total, weights, 0, out); },
+            "allocate () no weights"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&] () { allocate (total, weights, 2, out); },
+            "allocate () negative weight"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&] () { allocate (total, weights + 2, 1, out + 2); },
+            "allocate () zero weights"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&] () {
+                const std::vector<Number> large (
+                    200000,
+                    Number (
+                        std::numeric_limits<int64_t>::max (),
+                        0,
+                        Number::MAX_DECIMAL_PLACES
+                    )
+                );
+                std::vector<Number> legs (large.size ());
+
+                allocate (total, large.data (), large.size (), legs.data ());
+            },
+            "allocate () weights too large"
+        );
+}
+
+static Number randomNumber (std::mt19937_64& generator)
+{
+    const unsigned int decimalPlaces =
+        generator () % (Number::MAX_DECIMAL_PLACES + 1);
+    const int64_t mantissa =
+        static_cast<int64_t> (generator ()) >> (generator () % 63);
+
+    return Number::fromScaledValue (mantissa, decimalPlaces);
+}
+
+//
+// Totals and weights from a few bits up to the full range, so both the 64
+// bit and the 256 bit paths are covered, in every rounding mode.
+//
+static bool randomTest ()
+{
+    std::mt19937_64 generator (50);
+
+    for (unsigned int test = 0; test < 20000; ++test)
+    {
+        const Number total = randomNumber (generator);
+        const Rounding::Mode mode = ROUNDING_MODES [generator () % 10];
+
+        std::vector<Number> weights (1 + generator () % 20);
+
+        for (auto& weight: weights)
+        {
+            weight = randomNumber (generator);
+
+            if (weight < Number ())
+            {
+                weight = -weight;
+            }
+        }
+
+        if (weights [0].scaledValue () == 0)
+        {
+            weights [0] = Number (1);
+        }
+
+        std::vector<Number> out (weights.size ());
+
+        allocate (total, weights.data (), weights.size (), out.data (), mode);
+
+        if (! checkConserved (
+                total, weights, out, "allocate (" + total.toString () + ")"
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool manyLegsTest ()
+{
+    std::mt19937_64 generator (100000);
+
+    std::vector<Number> weights (100000);
+
+    for (auto& weight: weights)
+    {
+        weight = Number::fromScaledValue (generator () % 1000000, 4);
+    }
+
+    weights [0] = Number (1);
+
+    std::vector<Number> out (weights.size ());
+
+    for (const auto mode: ROUNDING_MODES)
+    {
+        const Number total ("-12345678.91");
+
+        allocate (total, weights.data (), weights.size (), out.data (), mode);
+
+        if (! checkConserved (total, weights, out, "allocate () many legs"))
+        {
+            return false;
+        }
+
+        std::vector<Number> inPlace = weights;
+
+        allocate (
+            total, inPlace.data (), inPlace.size (), inPlace.data (), mode
+        );
+
+        if (inPlace != out)
+        {
+            std::cerr << "allocate () in place differs" << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<Test> AllocateTestVec = {
+    {knownTest, TestName ("Allocate known splits")},
+    {errorTest, TestName ("Allocate errors")},
+    {randomTest, TestName ("Allocate random")},
+    {manyLegsTest, TestName ("Allocate many legs")}
+};
+
+} // namespace test
+} // namespace fixed
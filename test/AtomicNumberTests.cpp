@@ -0,0 +1,234 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/AtomicNumber.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+template <typename Atomic>
+static bool checkValue (
+    const Atomic& atomic,
+    const std::string& expected,
+    const std::string& description
+)
+{
+    const std::string value = atomic.load ().toString ();
+
+    if (value != expected)
+    {
+        std::cerr << description << " value " << value << " expected "
+                  << expected << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+template <typename Atomic>
+static bool basicOpsTest ()
+{
+    Atomic atomic (Number ("10.5"), 2, Rounding::Mode::TO_NEAREST_HALF_UP);
+
+    if (! checkValue (atomic, "10.50", "Initial") ||
+        atomic.fetch_add (Number ("0.125")).toString () != "10.50" ||
+        ! checkValue (atomic, "10.63", "Rounded add") ||
+        atomic.fetch_sub (Number ("20")).toString () != "10.63" ||
+        ! checkValue (atomic, "-9.37", "Subtract") ||
+        atomic.exchange (Number ("1")).toString () != "-9.37" ||
+        ! checkValue (atomic, "1.00", "Exchange"))
+    {
+        return false;
+    }
+
+    atomic.store (Number ("-0.5"));
+
+    Number expected ("2");
+
+    if (atomic.compare_exchange (expected, Number ("3")) ||
+        expected.toString () != "-0.50" ||
+        ! checkValue (atomic, "-0.50", "Failed compare exchange"))
+    {
+        std::cerr << "compare_exchange () should have failed" << std::endl;
+
+        return false;
+    }
+
+    if (! atomic.compare_exchange (expected, Number ("3")) ||
+        ! checkValue (atomic, "3.00", "Compare exchange"))
+    {
+        std::cerr << "compare_exchange () should have succeeded" << std::endl;
+
+        return false;
+    }
+
+    return
+        atomic.decimalPlaces () == 2 &&
+        atomic.roundingMode () == Rounding::Mode::TO_NEAREST_HALF_UP;
+}
+
+//
+// A result out of range throws and leaves the value as it was.
+//
+template <typename Atomic>
+static bool overflowTest (
+    const std::string& max,
+    const unsigned int decimalPlaces
+)
+{
+    Atomic atomic (Number (max), decimalPlaces);
+
+    try {
+        atomic.fetch_add (Number ("0.01"));
+
+        std::cerr << "fetch_add () expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+
+    atomic.store (-Number (max));
+
+    try {
+        atomic.fetch_sub (Number ("0.01"));
+
+        std::cerr << "fetch_sub () expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+
+    return checkValue (atomic, (-Number (max)).toString (), "Overflowed");
+}
+
+static bool narrowOverflowTest ()
+{
+    AtomicNumber atomic (2);
+
+    try {
+        atomic.store (Number ("92233720368547758.08"));
+
+        std::cerr << "store () expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+
+    return overflowTest<AtomicNumber> ("92233720368547758.07", 2);
+}
+
+static bool wideOverflowTest ()
+{
+    WideAtomicNumber atomic (Number ("92233720368547758.07"), 2);
+
+    atomic.fetch_add (Number ("92233720368547758.07"));
+
+    return
+        checkValue (atomic, "184467440737095516.14", "Past 64 bits") &&
+        overflowTest<WideAtomicNumber> (
+            "9223372036854775807.99999999999999", 14
+        ) &&
+        overflowTest<WideAtomicNumber> ("9223372036854775807.99", 2);
+}
+
+//
+// Concurrent adds and subtracts all land.
+//
+template <typename Atomic>
+static bool concurrentTest (const std::string& step)
+{
+    const unsigned int threadCount = 8;
+    const unsigned int adds = 20000;
+
+    Atomic atomic (Number ("0"), 4);
+
+    std::vector<std::thread> threads;
+
+    for (unsigned int thread = 0; thread < threadCount; ++thread)
+    {
+        threads.emplace_back ([&, thread] () {
+            for (unsigned int i = 0; i < adds; ++i)
+            {
+                if (thread % 2)
+                {
+                    atomic.fetch_sub (Number ("0.0001"));
+                }
+                else
+                {
+                    atomic.fetch_add (Number (step));
+                }
+            }
+        });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join ();
+    }
+
+    const Number expected =
+        Number (step) * Number (threadCount / 2 * adds) -
+        Number ("0.0001") * Number (threadCount / 2 * adds);
+
+    Number check (expected);
+
+    check.setDecimalPlaces (4);
+
+    return checkValue (atomic, check.toString (), "Concurrent");
+}
+
+std::vector<Test> AtomicNumberTestVec = {
+    {basicOpsTest<AtomicNumber>, TestName ("AtomicNumber operations")},
+    {basicOpsTest<WideAtomicNumber>, TestName ("WideAtomicNumber operations")},
+    {narrowOverflowTest, TestName ("AtomicNumber overflow")},
+    {wideOverflowTest, TestName ("WideAtomicNumber overflow")},
+    {
+        [] () { return concurrentTest<AtomicNumber> ("1.2345"); },
+        TestName ("AtomicNumber concurrent")
+    },
+    {
+        [] () {
+            return concurrentTest<WideAtomicNumber> ("12345678901.2345");
+        },
+        TestName ("WideAtomicNumber concurrent")
+    }
+};
+
+} // namespace test
+} // namespace fixed
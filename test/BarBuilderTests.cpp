@@ -0,0 +1,325 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/BarBuilder.h"
+#include "TestsCommon.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static bool checkBar (
+    const BarBuilder::Bar& bar,
+    const uint32_t instrument,
+    const int64_t start,
+    const uint64_t ticks,
+    const std::string& ohlcv,
+    const std::string& description
+)
+{
+    const std::string result =
+        bar.open.toString () + " " + bar.high.toString () + " " +
+        bar.low.toString () + " " + bar.close.toString () + " " +
+        bar.volume.toString ();
+
+    if (bar.instrument != instrument || bar.start != start ||
+        bar.ticks != ticks || result != ohlcv)
+    {
+        std::cerr << description << " gave " << bar.instrument << " "
+                  << bar.start << " " << bar.ticks << " " << result
+                  << " expected " << instrument << " " << start << " "
+                  << ticks << " " << ohlcv << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool singleInstrumentTest ()
+{
+    BarBuilder builder (1, 60, 2, 0);
+    BarBuilder::Bar bar;
+
+    if (builder.current (0, bar) ||
+        builder.add (0, 0, Number ("1.5"), Number (10), &bar) ||
+        builder.add (0, 10, Number ("1.75"), Number (5), &bar) ||
+        builder.add (0, 20, Number ("1.25"), Number (1), &bar) ||
+        builder.add (0, 59, Number ("1.5"), Number (4), &bar))
+    {
+        std::cerr << "Bar completed early" << std::endl;
+
+        return false;
+    }
+
+    if (! builder.current (0, bar) ||
+        ! checkBar (bar, 0, 0, 4, "1.50 1.75 1.25 1.50 20", "Current bar"))
+    {
+        return false;
+    }
+
+    //
+    // Nothing for the minute starting at 60, so the next bar starts at 120.
+    //
+    if (builder.add (0, 125, Number (2), Number (3), &bar) != 1 ||
+        ! checkBar (bar, 0, 0, 4, "1.50 1.75 1.25 1.50 20", "First bar") ||
+        builder.close (179, &bar) != 0 ||
+        builder.close (180, &bar) != 1 ||
+        ! checkBar (bar, 0, 120, 1, "2.00 2.00 2.00 2.00 3", "Closed bar"))
+    {
+        return false;
+    }
+
+    return
+        ! builder.current (0, bar) &&
+        builder.close (1000, &bar) == 0 &&
+        builder.add (0, 181, Number (3), Number (1), &bar) == 0;
+}
+
+static bool roundingTest ()
+{
+    BarBuilder builder (1, 10, 1, 1, Rounding::Mode::TO_NEAREST_HALF_UP);
+    BarBuilder::Bar bar;
+
+    builder.add (0, -5, Number ("1.25"), Number ("0.04"), &bar);
+    builder.add (0, -1, Number ("-1.25"), Number ("0.05"), &bar);
+
+    return
+        builder.current (0, bar) &&
+        checkBar (bar, 0, -10, 2, "1.3 1.3 -1.2 -1.2 0.1", "Rounded bar");
+}
+
+static bool errorsTest ()
+{
+    BarBuilder builder (2, 10, 2, 0);
+    BarBuilder::Bar bar;
+
+    builder.add (1, 25, Number (1), Number (1), &bar);
+
+    if (! expectException<fixed::BadValueException> (
+            [&] () { builder.add (2, 25, Number (1), Number (1), &bar); },
+            "Instrument out of range"
+        ) ||
+        ! expectException<fixed::BadValueException> (
+            [&] () { builder.add (1, 19, Number (1), Number (1), &bar); },
+            "Earlier interval"
+        ) ||
+        ! expectException<fixed::OverflowException> (
+            [&] () {
+                builder.add (
+                    1, 26, Number ("100000000000000000"), Number (1), &bar
+                );
+            },
+            "Price too large"
+        ) ||
+        ! expectException<fixed::OverflowException> (
+            [&] () {
+                builder.add (
+                    1, 26, Number (2), Number ("9223372036854775807"), &bar
+                );
+            },
+            "Volume too large"
+        ) ||
+        ! expectException<fixed::BadValueException> (
+            [&] () {
+                builder.add (
+                    0,
+                    std::numeric_limits<int64_t>::min () + 1,
+                    Number (1),
+                    Number (1),
+                    &bar
+                );
+            },
+            "Interval before the earliest timestamp"
+        ) ||
+        ! expectException<fixed::BadValueException> (
+            [] () { BarBuilder (0, 10, 2, 0); }, "No instruments"
+        ) ||
+        ! expectException<fixed::BadValueException> (
+            [] () { BarBuilder (1, 0, 2, 0); }, "No interval"
+        ) ||
+        ! expectException<fixed::BadValueException> (
+            [] () { BarBuilder (1, 1, Number::MAX_DECIMAL_PLACES + 1, 0); },
+            "Decimal places"
+        ))
+    {
+        return false;
+    }
+
+    //
+    // Earlier ticks within the bar in progress are fine, and nothing was
+    // changed by the ticks that threw.
+    //
+    builder.add (1, 20, Number ("0.5"), Number (2), &bar);
+
+    return
+        builder.current (1, bar) &&
+        checkBar (bar, 1, 20, 2, "1.00 1.00 0.50 0.50 3", "After errors");
+}
+
+//
+// Random ticks for many instruments, added in batches, against bars built
+// with Number arithmetic.
+//
+static bool batchTest ()
+{
+    const uint32_t instruments = 50;
+    const int64_t interval = 100;
+
+    std::mt19937_64 generator (53);
+    std::uniform_int_distribution<int64_t> prices (-1000000, 1000000);
+    std::uniform_int_distribution<int64_t> sizes (1, 1000000);
+
+    std::vector<BarBuilder::Tick> ticks;
+    std::vector<int64_t> timestamps (instruments, 0);
+
+    for (unsigned int i = 0; i < 20000; ++i)
+    {
+        const uint32_t instrument = generator () % instruments;
+
+        timestamps [instrument] += generator () % 40;
+
+        ticks.push_back ({
+            instrument,
+            timestamps [instrument],
+            Number::fromScaledValue (prices (generator), generator () % 5),
+            Number::fromScaledValue (sizes (generator), generator () % 3)
+        });
+    }
+
+    BarBuilder builder (instruments, interval, 4, 2);
+
+    std::vector<BarBuilder::Bar> bars (ticks.size () + instruments);
+
+    size_t count = 0;
+
+    for (size_t first = 0; first < ticks.size (); first += 777)
+    {
+        const size_t batch = std::min<size_t> (777, ticks.size () - first);
+
+        count += builder.add (&ticks [first], batch, &bars [count]);
+    }
+
+    count += builder.close (
+        std::numeric_limits<int64_t>::max (), &bars [count]
+    );
+
+    //
+    // Replaying each instrument's ticks must give its bars in order.
+    //
+    std::vector<size_t> next (instruments, 0);
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const BarBuilder::Bar& bar = bars [idx];
+
+        size_t& tick = next [bar.instrument];
+
+        while (ticks [tick].instrument != bar.instrument)
+        {
+            ++tick;
+        }
+
+        Number open (ticks [tick].price);
+        Number high (open);
+        Number low (open);
+        Number close (open);
+        Number volume (ticks [tick].size);
+        uint64_t tickCount = 1;
+
+        const int64_t start = ticks [tick].timestamp / interval * interval;
+
+        for (++tick; tick < ticks.size (); ++tick)
+        {
+            if (ticks [tick].instrument != bar.instrument)
+            {
+                continue;
+            }
+
+            if (ticks [tick].timestamp >= start + interval)
+            {
+                break;
+            }
+
+            high = ticks [tick].price > high ? ticks [tick].price : high;
+            low = ticks [tick].price < low ? ticks [tick].price : low;
+            close = ticks [tick].price;
+            volume += ticks [tick].size;
+            ++tickCount;
+        }
+
+        open.setDecimalPlaces (4);
+        high.setDecimalPlaces (4);
+        low.setDecimalPlaces (4);
+        close.setDecimalPlaces (4);
+        volume.setDecimalPlaces (2);
+
+        if (! checkBar (
+                bar,
+                bar.instrument,
+                start,
+                tickCount,
+                open.toString () + " " + high.toString () + " " +
+                    low.toString () + " " + close.toString () + " " +
+                    volume.toString (),
+                "Batch bar"
+            ))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t instrument = 0; instrument < instruments; ++instrument)
+    {
+        for (size_t tick = next [instrument]; tick < ticks.size (); ++tick)
+        {
+            if (ticks [tick].instrument == instrument)
+            {
+                std::cerr << "Batch ticks without a bar" << std::endl;
+
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::vector<Test> BarBuilderTestVec = {
+    {singleInstrumentTest, TestName ("Bar builder single instrument")},
+    {roundingTest, TestName ("Bar builder rounding")},
+    {errorsTest, TestName ("Bar builder errors")},
+    {batchTest, TestName ("Bar builder batches")}
+};
+
+} // namespace test
+} // namespace fixed
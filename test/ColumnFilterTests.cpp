@@ -0,0 +1,228 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ColumnOps.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+//
+// Column values at 2 decimal places, including ones that land in the wide
+// value table.
+//
+static const std::vector<std::string> columnValues = {
+    "0", "1.23", "1.24", "1.22", "-1.23", "-1.24", "-1.22", "100", "-100",
+    "92233720368547758.07", "-92233720368547758.07",
+    "92233720368547758.08", "-92233720368547758.08",
+    "9223372036854775807.99", "-9223372036854775807.99",
+    "0.01", "-0.01", "5.5", "7.25", "-7.25"
+};
+
+static const std::vector<std::string> thresholds = {
+    "0", "1.23", "1.2345", "-1.2345", "1.2300000", "1.239", "-1.239", "1.2",
+    "-100.001", "100.00000000000001", "-0.00000000000001", "1",
+    "92233720368547758.07", "92233720368547758.075", "-92233720368547758.075",
+    "92233720368547758.08", "-92233720368547758.08",
+    "9223372036854775807.99999999999999",
+    "-9223372036854775807.99999999999999", "9223372036854775807"
+};
+
+static NumberColumn makeColumn ()
+{
+    std::vector<Number> numbers;
+
+    for (const auto& str: columnValues)
+    {
+        numbers.push_back (Number (str));
+    }
+
+    return NumberColumn (numbers, 2);
+}
+
+static bool checkFilter (
+    const std::string& name,
+    const ColumnMask& mask,
+    const NumberColumn& column,
+    const std::function<bool (const Number&)>& expected
+)
+{
+    size_t setCount = 0;
+
+    for (size_t idx = 0; idx < column.size (); ++idx)
+    {
+        const bool expectedBit = expected (column [idx]);
+
+        if (! valCheck<bool> (
+                expectedBit,
+                mask [idx],
+                name + " " + column [idx].toString () + " "
+            ))
+        {
+            return false;
+        }
+
+        setCount += expectedBit;
+    }
+
+    return valCheck (setCount, mask.count (), name + " count ");
+}
+
+static bool thresholdTest ()
+{
+    const NumberColumn column = makeColumn ();
+
+    for (const auto& str: thresholds)
+    {
+        const Number t (str);
+
+        if (! checkFilter (
+                "equal " + str,
+                ColumnOps::equal (column, t),
+                column,
+                [&] (const Number& n) { return n == t; }
+            ) ||
+            ! checkFilter (
+                "notEqual " + str,
+                ColumnOps::notEqual (column, t),
+                column,
+                [&] (const Number& n) { return n != t; }
+            ) ||
+            ! checkFilter (
+                "lessThan " + str,
+                ColumnOps::lessThan (column, t),
+                column,
+                [&] (const Number& n) { return n < t; }
+            ) ||
+            ! checkFilter (
+                "lessThanOrEqual " + str,
+                ColumnOps::lessThanOrEqual (column, t),
+                column,
+                [&] (const Number& n) { return n <= t; }
+            ) ||
+            ! checkFilter (
+                "greaterThan " + str,
+                ColumnOps::greaterThan (column, t),
+                column,
+                [&] (const Number& n) { return n > t; }
+            ) ||
+            ! checkFilter (
+                "greaterThanOrEqual " + str,
+                ColumnOps::greaterThanOrEqual (column, t),
+                column,
+                [&] (const Number& n) { return n >= t; }
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool betweenTest ()
+{
+    const NumberColumn column = makeColumn ();
+
+    for (const auto& lowStr: thresholds)
+    {
+        for (const auto& highStr: thresholds)
+        {
+            const Number low (lowStr);
+            const Number high (highStr);
+
+            if (! checkFilter (
+                    "between " + lowStr + " " + highStr,
+                    ColumnOps::between (column, low, high),
+                    column,
+                    [&] (const Number& n) { return low <= n && n <= high; }
+                ))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//
+// Long enough to cover both the whole word and the partial word paths of
+// the mask, with a wide value in each.
+//
+static bool longColumnTest ()
+{
+    std::vector<Number> numbers;
+
+    for (int i = -100; i < 100; ++i)
+    {
+        numbers.push_back (Number (i, 5, 1));
+    }
+
+    numbers [10] = Number ("92233720368547758.08");
+    numbers [190] = Number ("-92233720368547758.08");
+
+    const NumberColumn column (numbers, 2);
+    const Number low ("-12.34");
+    const Number high ("56.7");
+
+    return
+        checkFilter (
+            "long between",
+            ColumnOps::between (column, low, high),
+            column,
+            [&] (const Number& n) { return low <= n && n <= high; }
+        )
+        &&
+        checkFilter (
+            "long notEqual",
+            ColumnOps::notEqual (column, Number ("3.45")),
+            column,
+            [&] (const Number& n) { return n != Number ("3.45"); }
+        )
+        &&
+        checkFilter (
+            "long lessThan",
+            ColumnOps::lessThan (column, Number ("92233720368547758.075")),
+            column,
+            [&] (const Number& n) {
+                return n < Number ("92233720368547758.075");
+            }
+        );
+}
+
+std::vector<Test> ColumnFilterTestVec = {
+    {thresholdTest, TestName ("ColumnOps threshold filters")},
+    {betweenTest, TestName ("ColumnOps between")},
+    {longColumnTest, TestName ("ColumnOps long column filters")}
+};
+
+} // namespace test
+} // namespace fixed
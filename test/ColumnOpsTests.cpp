@@ -0,0 +1,339 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ColumnOps.h"
+#include "TestsCommon.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+//
+// Values around the int64_t mantissa limits, which exercise the wide value
+// table and the overflow slow path, mixed with random ones.
+//
+static std::vector<Number> makeValues (
+    const unsigned int decimalPlaces,
+    const uint64_t seed
+)
+{
+    const __int128_t int64Max = std::numeric_limits<int64_t>::max ();
+
+    std::vector<__int128_t> scaled = {
+        0, 1, -1, int64Max, -int64Max, int64Max + 1, -int64Max - 1,
+        int64Max / 2 + 1, -int64Max / 2 - 1, int64Max * 3, -int64Max * 5
+    };
+
+    std::mt19937_64 generator (seed);
+
+    for (unsigned int i = 0; i < 200; ++i)
+    {
+        scaled.push_back (
+            static_cast<int64_t> (generator ()) >> (generator () % 64)
+        );
+    }
+
+    std::vector<Number> values;
+
+    for (const auto& value: scaled)
+    {
+        try {
+            values.push_back (Number::fromScaledValue (value, decimalPlaces));
+        }
+        catch (const fixed::BadValueException&)
+        {
+            //
+            // Out of range at this number of decimal places.
+            //
+        }
+    }
+
+    return values;
+}
+
+static bool checkColumn (
+    const std::string& errMsgHdr,
+    const NumberColumn& column,
+    const std::vector<Number>& expected
+)
+{
+    if (! valCheck (expected.size (), column.size (), errMsgHdr + " size "))
+    {
+        return false;
+    }
+
+    for (size_t idx = 0; idx < expected.size (); ++idx)
+    {
+        if (! checkNumber (
+                errMsgHdr + " [" + std::to_string (idx) + "]",
+                column [idx],
+                expected [idx]
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool checkMask (
+    const std::string& errMsgHdr,
+    const ColumnMask& mask,
+    const std::vector<bool>& expected
+)
+{
+    size_t setCount = 0;
+
+    for (size_t idx = 0; idx < expected.size (); ++idx)
+    {
+        if (! valCheck<bool> (
+                expected [idx],
+                mask [idx],
+                errMsgHdr + " [" + std::to_string (idx) + "] "
+            ))
+        {
+            return false;
+        }
+
+        setCount += expected [idx];
+    }
+
+    return valCheck (setCount, mask.count (), errMsgHdr + " count ");
+}
+
+//
+// Compares each ColumnOps operation against the scalar operators applied
+// element by element, including which elements throw on overflow.
+//
+class ColumnOpsTest {
+  public:
+    ColumnOpsTest (const unsigned int decimalPlaces)
+      : decimalPlaces_ (decimalPlaces)
+    {}
+
+    bool operator() ()
+    {
+        const auto lhsValues = makeValues (decimalPlaces_, 1);
+        auto rhsValues = makeValues (decimalPlaces_, 2);
+
+        std::reverse (rhsValues.begin (), rhsValues.end ());
+
+        const NumberColumn lhs (lhsValues, decimalPlaces_);
+        const NumberColumn rhs (rhsValues, decimalPlaces_);
+
+        std::vector<Number> mins, maxs, abss, negs;
+        std::vector<bool> eq, ne, lt, le, gt, ge;
+
+        for (size_t idx = 0; idx < lhsValues.size (); ++idx)
+        {
+            const Number& a = lhsValues [idx];
+            const Number& b = rhsValues [idx];
+
+            mins.push_back (std::min (a, b));
+            maxs.push_back (std::max (a, b));
+            abss.push_back (Number::toAbsolute (a));
+            negs.push_back (-a);
+
+            eq.push_back (a == b);
+            ne.push_back (a != b);
+            lt.push_back (a < b);
+            le.push_back (a <= b);
+            gt.push_back (a > b);
+            ge.push_back (a >= b);
+        }
+
+        return
+            checkAddSub (lhsValues, rhsValues, true) &&
+            checkAddSub (lhsValues, rhsValues, false) &&
+            checkColumn (hdr ("min"), ColumnOps::min (lhs, rhs), mins) &&
+            checkColumn (hdr ("max"), ColumnOps::max (lhs, rhs), maxs) &&
+            checkColumn (hdr ("abs"), ColumnOps::abs (lhs), abss) &&
+            checkColumn (hdr ("negate"), ColumnOps::negate (lhs), negs) &&
+            checkMask (hdr ("equal"), ColumnOps::equal (lhs, rhs), eq) &&
+            checkMask (
+                hdr ("equal self"),
+                ColumnOps::equal (lhs, lhs),
+                std::vector<bool> (lhs.size (), true)
+            ) &&
+            checkMask (hdr ("notEqual"), ColumnOps::notEqual (lhs, rhs), ne) &&
+            checkMask (hdr ("lessThan"), ColumnOps::lessThan (lhs, rhs), lt) &&
+            checkMask (
+                hdr ("lessThanOrEqual"),
+                ColumnOps::lessThanOrEqual (lhs, rhs),
+                le
+            ) &&
+            checkMask (
+                hdr ("greaterThan"),
+                ColumnOps::greaterThan (lhs, rhs),
+                gt
+            ) &&
+            checkMask (
+                hdr ("greaterThanOrEqual"),
+                ColumnOps::greaterThanOrEqual (lhs, rhs),
+                ge
+            );
+    }
+
+  private:
+    std::string hdr (const std::string& opName) const
+    {
+        return "ColumnOps::" + opName + " dp " +
+               std::to_string (decimalPlaces_);
+    }
+
+    //
+    // Overflowing elements are checked one at a time, since the column
+    // operation throws as soon as it meets one.
+    //
+    bool checkAddSub (
+        const std::vector<Number>& lhsValues,
+        const std::vector<Number>& rhsValues,
+        const bool addition
+    ) const
+    {
+        const std::string name = hdr (addition ? "add" : "subtract");
+
+        std::vector<Number> lhsOk, rhsOk, expected;
+
+        for (size_t idx = 0; idx < lhsValues.size (); ++idx)
+        {
+            const NumberColumn lhs ({lhsValues [idx]}, decimalPlaces_);
+            const NumberColumn rhs ({rhsValues [idx]}, decimalPlaces_);
+
+            try {
+                const Number result = addition ?
+                    lhsValues [idx] + rhsValues [idx] :
+                    lhsValues [idx] - rhsValues [idx];
+
+                lhsOk.push_back (lhsValues [idx]);
+                rhsOk.push_back (rhsValues [idx]);
+                expected.push_back (result);
+            }
+            catch (const fixed::OverflowException&)
+            {
+                try {
+                    addition ?
+                        ColumnOps::add (lhs, rhs) :
+                        ColumnOps::subtract (lhs, rhs);
+
+                    std::cerr << name << " [" << idx << "] expected overflow"
+                              << std::endl;
+
+                    return false;
+                }
+                catch (const fixed::OverflowException&)
+                {
+                }
+            }
+        }
+
+        const NumberColumn lhs (lhsOk, decimalPlaces_);
+        const NumberColumn rhs (rhsOk, decimalPlaces_);
+
+        return checkColumn (
+            name,
+            addition ?
+                ColumnOps::add (lhs, rhs) :
+                ColumnOps::subtract (lhs, rhs),
+            expected
+        );
+    }
+
+    unsigned int decimalPlaces_;
+};
+
+static bool overflowCountTest ()
+{
+    //
+    // Sanity check that the value sets really do reach the slow paths.
+    //
+    const NumberColumn lhs (makeValues (0, 1), 0);
+
+    try {
+        ColumnOps::add (lhs, lhs);
+
+        std::cerr << "ColumnOps::add expected overflow" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+
+    return NumberColumn (makeValues (2, 1), 2).wideCount () > 0;
+}
+
+static bool badValueTest ()
+{
+    const NumberColumn twoDp ({Number ("1.25")}, 2);
+    const NumberColumn threeDp ({Number ("1.25")}, 3);
+    const NumberColumn twoValues ({Number ("1.25"), Number ("1.5")}, 2);
+
+    for (const auto* rhs: {&threeDp, &twoValues})
+    {
+        try {
+            ColumnOps::add (twoDp, *rhs);
+
+            std::cerr << "ColumnOps::add expected exception" << std::endl;
+
+            return false;
+        }
+        catch (const fixed::BadValueException&)
+        {
+        }
+
+        try {
+            ColumnOps::lessThan (twoDp, *rhs);
+
+            std::cerr << "ColumnOps::lessThan expected exception" << std::endl;
+
+            return false;
+        }
+        catch (const fixed::BadValueException&)
+        {
+        }
+    }
+
+    return true;
+}
+
+std::vector<Test> ColumnOpsTestVec = {
+    {ColumnOpsTest (0), TestName ("ColumnOps dp 0")},
+    {ColumnOpsTest (2), TestName ("ColumnOps dp 2")},
+    {ColumnOpsTest (5), TestName ("ColumnOps dp 5")},
+    {ColumnOpsTest (14), TestName ("ColumnOps dp 14")},
+    {overflowCountTest, TestName ("ColumnOps overflow")},
+    {badValueTest, TestName ("ColumnOps bad values")}
+};
+
+} // namespace test
+} // namespace fixed
@@ -0,0 +1,230 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ColumnOps.h"
+#include "fixed/CpuDispatch.h"
+#include "fixed/Reductions.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static std::vector<Number> makeNumbers (const uint64_t seed)
+{
+    std::mt19937_64 generator (seed);
+
+    std::vector<Number> numbers;
+
+    //
+    // An odd count so the partial mask word and vector loop tails are used.
+    //
+    for (unsigned int i = 0; i < 1027; ++i)
+    {
+        numbers.push_back (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >> (generator () % 64),
+                4
+            )
+        );
+    }
+
+    numbers [7] = Number ("922337203685477.5808");
+    numbers [600] = Number ("-922337203685477.5809");
+
+    return numbers;
+}
+
+static std::string masksToString (const std::vector<ColumnMask>& masks)
+{
+    std::string str;
+
+    for (const auto& mask: masks)
+    {
+        for (size_t idx = 0; idx < mask.size (); ++idx)
+        {
+            str += mask [idx] ? '1' : '0';
+        }
+
+        str += '\n';
+    }
+
+    return str;
+}
+
+static std::string columnsToString (const std::vector<NumberColumn>& columns)
+{
+    std::string str;
+
+    for (const auto& column: columns)
+    {
+        for (const auto& number: column)
+        {
+            str += number.toString () + ' ';
+        }
+
+        str += '\n';
+    }
+
+    return str;
+}
+
+//
+// Runs every dispatched kernel and records the results as a string.
+//
+static std::string runKernels ()
+{
+    const NumberColumn lhs (makeNumbers (1), 4);
+    NumberColumn rhs (makeNumbers (2), 4);
+
+    //
+    // Make the sums overflow free by halving the magnitudes.
+    //
+    const NumberColumn lhsHalf (
+        ColumnOps::rescale (lhs, 3, Rounding::Mode::TOWARDS_ZERO)
+    );
+    const NumberColumn rhsHalf (
+        ColumnOps::rescale (rhs, 3, Rounding::Mode::TOWARDS_ZERO)
+    );
+
+    const Number threshold ("12.34567");
+
+    return
+        columnsToString ({
+            ColumnOps::add (lhsHalf, rhsHalf),
+            ColumnOps::subtract (lhsHalf, rhsHalf),
+            ColumnOps::min (lhs, rhs),
+            ColumnOps::max (lhs, rhs),
+            ColumnOps::abs (lhs),
+            ColumnOps::negate (lhs),
+            ColumnOps::rescale (lhs, 9),
+            ColumnOps::rescale (lhs, 1)
+        }) +
+        masksToString ({
+            ColumnOps::equal (lhs, lhs),
+            ColumnOps::notEqual (lhs, rhs),
+            ColumnOps::lessThan (lhs, rhs),
+            ColumnOps::lessThanOrEqual (lhs, rhs),
+            ColumnOps::greaterThan (lhs, rhs),
+            ColumnOps::greaterThanOrEqual (lhs, rhs),
+            ColumnOps::lessThan (lhs, threshold),
+            ColumnOps::between (lhs, -threshold, threshold)
+        }) +
+        Reductions::sum (lhs).toString () + ' ' +
+        Reductions::mean (rhs).toString () + ' ' +
+        Reductions::min (lhs).toString () + ' ' +
+        Reductions::max (rhs).toString () + ' ' +
+        std::to_string (Reductions::countNonZero (lhs));
+}
+
+//
+// Every tier the CPU supports gives the same results as the baseline one.
+//
+static bool tierResultsTest ()
+{
+    const CpuDispatch::Tier original = CpuDispatch::tier ();
+
+    CpuDispatch::setTier (CpuDispatch::Tier::BASELINE);
+
+    const std::string expected = runKernels ();
+
+    bool passed = true;
+
+    for (auto tier = CpuDispatch::Tier::SSE4_2;
+         passed && tier <= CpuDispatch::supportedTier ();
+         tier = static_cast<CpuDispatch::Tier> (static_cast<int> (tier) + 1))
+    {
+        CpuDispatch::setTier (tier);
+
+        if (expected != runKernels ())
+        {
+            std::cerr << "Tier " << CpuDispatch::tierToString (tier)
+                      << " results differ from baseline" << std::endl;
+
+            passed = false;
+        }
+    }
+
+    CpuDispatch::setTier (original);
+
+    return passed;
+}
+
+static bool tierStringsTest ()
+{
+    for (auto tier = CpuDispatch::Tier::BASELINE;
+         tier < CpuDispatch::Tier::TIER_MAX_VAL;
+         tier = static_cast<CpuDispatch::Tier> (static_cast<int> (tier) + 1))
+    {
+        CpuDispatch::Tier parsed;
+
+        if (! CpuDispatch::stringToTier (
+                CpuDispatch::tierToString (tier), parsed
+            ) ||
+            parsed != tier)
+        {
+            std::cerr << "Tier string round trip failed for "
+                      << CpuDispatch::tierToString (tier) << std::endl;
+
+            return false;
+        }
+    }
+
+    CpuDispatch::Tier parsed;
+
+    return
+        ! CpuDispatch::stringToTier ("avx3", parsed) &&
+        CpuDispatch::tier () <= CpuDispatch::supportedTier ();
+}
+
+static bool unsupportedTierTest ()
+{
+    try {
+        CpuDispatch::setTier (CpuDispatch::Tier::TIER_MAX_VAL);
+
+        std::cerr << "CpuDispatch::setTier expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    return true;
+}
+
+std::vector<Test> CpuDispatchTestVec = {
+    {tierResultsTest, TestName ("CpuDispatch tier results")},
+    {tierStringsTest, TestName ("CpuDispatch tier strings")},
+    {unsupportedTierTest, TestName ("CpuDispatch unsupported tier")}
+};
+
+} // namespace test
+} // namespace fixed
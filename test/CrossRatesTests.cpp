@@ -0,0 +1,332 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/CrossRates.h"
+#include "fixed/Exceptions.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static const uint32_t USD = 0;
+static const uint32_t EUR = 1;
+static const uint32_t JPY = 2;
+static const uint32_t GBP = 3;
+static const uint32_t CHF = 4;
+
+static CrossRates majors ()
+{
+    CrossRates rates (5, USD);
+
+    rates.setRate (EUR, Number ("1.0850"));
+    rates.setRate (JPY, Number ("149.50"), CrossRates::Quote::UNITS_PER_PIVOT);
+    rates.setRate (GBP, Number ("1.2712"));
+
+    return rates;
+}
+
+static bool convertTest ()
+{
+    CrossRates rates = majors ();
+
+    const Number amount ("-12345.67");
+
+    if (! checkResult (
+            rates.convert (Number ("1000000.00"), EUR, JPY, 0),
+            "162207500",
+            "convert () EUR to JPY"
+        ) ||
+        ! checkResult (
+            rates.convert (Number (1000000), JPY, EUR, 2),
+            "6164.94",
+            "convert () JPY to EUR"
+        ) ||
+        ! checkResult (
+            rates.convert (amount, GBP, EUR, 2, Rounding::Mode::DOWN),
+            "-14464.35",
+            "convert () GBP to EUR down"
+        ) ||
+        ! checkResult (
+            rates.convert (amount, GBP, EUR, 2, Rounding::Mode::TOWARDS_ZERO),
+            "-14464.34",
+            "convert () GBP to EUR towards zero"
+        ) ||
+        ! checkResult (
+            rates.convert (amount, GBP, GBP, 1, Rounding::Mode::UP),
+            "-12345.6",
+            "convert () GBP to GBP"
+        ) ||
+        ! checkResult (
+            rates.rate (EUR, GBP, 6), "0.853524", "rate () EURGBP"
+        ) ||
+        ! checkResult (
+            rates.rate (GBP, EUR, 6), "1.171613", "rate () GBPEUR"
+        ) ||
+        ! checkResult (rates.rate (USD, JPY, 2), "149.50", "rate () USDJPY") ||
+        ! checkResult (
+            rates.rate (JPY, USD, 14),
+            "0.00668896321070",
+            "rate () JPYUSD"
+        ))
+    {
+        return false;
+    }
+
+    rates.setRate (EUR, Number ("1.09"));
+
+    return checkResult (
+            rates.convert (Number (100), EUR, USD, 2),
+            "109.00",
+            "convert () after tick"
+        ) &&
+        checkResult (
+            rates.convert (Number ("1000000.00"), EUR, JPY, 0),
+            "162955000",
+            "convert () cross after tick"
+        ) &&
+        rates.hasRate (EUR) &&
+        ! rates.hasRate (CHF) &&
+        rates.currencies () == 5 &&
+        rates.pivot () == USD;
+}
+
+static bool errorTest ()
+{
+    CrossRates rates = majors ();
+
+    return expectException<fixed::BadValueException> (
+            [&rates] () { rates.convert (Number (1), CHF, USD, 2); },
+            "convert () no rate"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&rates] () { rates.convert (Number (1), USD, 5, 2); },
+            "convert () out of range"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&rates] () { rates.convert (Number (1), USD, EUR, 15); },
+            "convert () decimal places"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&rates] () { rates.setRate (USD, Number (1)); },
+            "setRate () pivot"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&rates] () { rates.setRate (CHF, Number (0)); },
+            "setRate () zero"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&rates] () { rates.setRate (CHF, Number ("-0.9")); },
+            "setRate () negative"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { CrossRates (0, 0); },
+            "CrossRates () no currencies"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { CrossRates (3, 3); },
+            "CrossRates () pivot"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&rates] () {
+                rates.convert (
+                    NumberColumn (std::vector<Number> (2), 2),
+                    std::vector<uint32_t> (1, EUR),
+                    USD,
+                    2
+                );
+            },
+            "convert () sizes"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&rates] () {
+                rates.convert (
+                    Number (std::numeric_limits<int64_t>::max ()), GBP, JPY, 0
+                );
+            },
+            "convert () too large"
+        );
+}
+
+//
+// One unit of a currency in the pivot as an exact fraction.
+//
+struct Fraction {
+    __int128_t numerator;
+    __int128_t denominator;
+};
+
+static __int128_t powerOfTen (const unsigned int exponent)
+{
+    __int128_t power = 1;
+
+    for (unsigned int idx = 0; idx < exponent; ++idx)
+    {
+        power *= 10;
+    }
+
+    return power;
+}
+
+//
+// Random rates and amounts in every rounding mode against the exact
+// triangulated value, with the batches agreeing with the scalar.  Rates
+// are kept between 10^-7 and 100 so no result overflows.
+//
+static bool randomTest ()
+{
+    std::mt19937_64 generator (480);
+
+    const size_t currencies = 8;
+
+    for (unsigned int trial = 0; trial < 200; ++trial)
+    {
+        CrossRates rates (currencies, 0);
+
+        std::vector<Fraction> fractions (currencies, Fraction {1, 1});
+
+        for (uint32_t currency = 1; currency < currencies; ++currency)
+        {
+            const unsigned int decimalPlaces = 3 + generator () % 5;
+            const Number rate = Number::fromScaledValue (
+                1 + generator () % 100000, decimalPlaces
+            );
+            const __int128_t scale = powerOfTen (decimalPlaces);
+
+            if (generator () % 2)
+            {
+                rates.setRate (currency, rate);
+                fractions [currency] = {rate.scaledValue (), scale};
+            }
+            else
+            {
+                rates.setRate (
+                    currency, rate, CrossRates::Quote::UNITS_PER_PIVOT
+                );
+                fractions [currency] = {scale, rate.scaledValue ()};
+            }
+        }
+
+        const unsigned int amountPlaces = generator () % 9;
+        const unsigned int decimalPlaces = generator () % 15;
+        const uint32_t to = generator () % currencies;
+        const Rounding::Mode mode = ROUNDING_MODES [generator () % 10];
+
+        std::vector<Number> amounts;
+        std::vector<uint32_t> from;
+
+        for (unsigned int idx = 0; idx < 500; ++idx)
+        {
+            const int64_t mantissa =
+                static_cast<int64_t> (generator ()) >> (30 + generator () % 34);
+
+            amounts.push_back (
+                Number::fromScaledValue (mantissa, amountPlaces)
+            );
+            from.push_back (generator () % currencies);
+        }
+
+        const NumberColumn column (amounts, amountPlaces);
+        const NumberColumn batch = rates.convert (
+            column, from, to, decimalPlaces, mode
+        );
+        const NumberColumn single = rates.convert (
+            column, from [0], to, decimalPlaces, mode
+        );
+
+        for (size_t idx = 0; idx < amounts.size (); ++idx)
+        {
+            const Fraction& source = fractions [from [idx]];
+            const Fraction& target = fractions [to];
+
+            Int256 numerator = Int256::multiply (
+                amounts [idx].scaledValue (), source.numerator
+            );
+            Int256 denominator =
+                Int256::multiply (source.denominator, target.numerator);
+
+            numerator *= Int256 (target.denominator);
+
+            if (decimalPlaces >= amountPlaces)
+            {
+                numerator *= Int256 (powerOfTen (decimalPlaces - amountPlaces));
+            }
+            else
+            {
+                denominator *=
+                    Int256 (powerOfTen (amountPlaces - decimalPlaces));
+            }
+
+            const Number expected = Number::fromScaledValue (
+                Int256::divideRounded (numerator, denominator, mode),
+                decimalPlaces
+            );
+
+            const std::string description =
+                "convert (" + amounts [idx].toString () + ", " +
+                std::to_string (from [idx]) + ", " + std::to_string (to) +
+                ", " + std::to_string (decimalPlaces) + ", " +
+                Rounding::modeToString (mode) + ")";
+
+            if (! checkResult (
+                    rates.convert (
+                        amounts [idx], from [idx], to, decimalPlaces, mode
+                    ),
+                    expected.toString (),
+                    description
+                ) ||
+                ! checkResult (
+                    batch [idx], expected.toString (), "batch " + description
+                ) ||
+                ! checkResult (
+                    single [idx],
+                    rates.convert (
+                        amounts [idx], from [0], to, decimalPlaces, mode
+                    ).toString (),
+                    "single currency batch " + description
+                ))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::vector<Test> CrossRatesTestVec = {
+    {convertTest, TestName ("Cross rates convert")},
+    {errorTest, TestName ("Cross rates errors")},
+    {randomTest, TestName ("Cross rates random")}
+};
+
+} // namespace test
+} // namespace fixed
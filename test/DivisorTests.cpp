@@ -0,0 +1,235 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Divisor.h"
+#include "fixed/Exceptions.h"
+#include "TestsCommon.h"
+
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static std::string toString (__uint128_t value)
+{
+    std::string digits;
+
+    do {
+        digits.insert (digits.begin (), static_cast<char> ('0' + value % 10));
+        value /= 10;
+    } while (value);
+
+    return digits;
+}
+
+//
+// divideRounded () against Int256::divideRounded (), or against the
+// quotient being too large, for a magnitude below 2^127.
+//
+static bool checkDivide (
+    const Divisor& divisor,
+    const uint64_t value,
+    const __uint128_t magnitude,
+    const bool negative,
+    const Rounding::Mode mode
+)
+{
+    const __int128_t numerator = static_cast<__int128_t> (magnitude);
+
+    __int128_t result = 0;
+
+    if (! divisor.divideRounded (magnitude, negative, mode, result))
+    {
+        if ((magnitude / value) >> 126)
+        {
+            return true;
+        }
+
+        std::cerr << "Divisor " << value << " rejected "
+                  << toString (magnitude) << std::endl;
+
+        return false;
+    }
+
+    const __int128_t expected = Int256::divideRounded (
+        Int256 (negative ? -numerator : numerator),
+        Int256 (static_cast<__int128_t> (value)),
+        mode
+    );
+
+    if (result != expected)
+    {
+        std::cerr << (negative ? "-" : "") << toString (magnitude) << " / "
+                  << value << " in mode " << Rounding::modeToString (mode)
+                  << " gave " << (result < 0 ? "-" : "")
+                  << toString (result < 0 ? -result : result) << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool divideTest ()
+{
+    std::mt19937_64 generator (48);
+
+    const uint64_t edges [] = {
+        1,
+        2,
+        3,
+        10,
+        365,
+        static_cast<uint64_t> (1) << 63,
+        (static_cast<uint64_t> (1) << 63) + 1,
+        std::numeric_limits<uint64_t>::max ()
+    };
+
+    for (unsigned int test = 0; test < 200000; ++test)
+    {
+        const uint64_t value =
+            test < 80000 ?
+                edges [test % (sizeof (edges) / sizeof (edges [0]))] :
+                generator () >> (generator () % 64) | 1;
+
+        const Divisor divisor (Int256 (static_cast<__int128_t> (value)));
+
+        const __uint128_t magnitude =
+            (static_cast<__uint128_t> (generator ()) << 64 | generator ()) >>
+            (1 + generator () % 127);
+
+        //
+        // Exact quotients and, for even divisors, half way between two.
+        //
+        const __uint128_t remainder = magnitude % value;
+        const __uint128_t exact =
+            magnitude - remainder + (remainder > value / 2 ? value / 2 : 0);
+
+        if (! divisor.isNarrow () ||
+            ! checkDivide (
+                divisor,
+                value,
+                test % 3 ? magnitude : exact,
+                generator () % 2,
+                ROUNDING_MODES [generator () % 10]
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool constructTest ()
+{
+    const Divisor one;
+    const Divisor wide (Int256 (std::numeric_limits<__int128_t>::max ()));
+
+    __int128_t result = 0;
+
+    if (! one.isNarrow () ||
+        ! one.divideRounded (12345, true, Rounding::Mode::UP, result) ||
+        result != -12345 ||
+        wide.isNarrow () ||
+        ! (wide.value () == Int256 (std::numeric_limits<__int128_t>::max ())))
+    {
+        std::cerr << "Divisor construction" << std::endl;
+
+        return false;
+    }
+
+    for (const int value: {0, -1})
+    {
+        try {
+            Divisor divisor (Int256 (static_cast<__int128_t> (value)));
+
+            std::cerr << "Divisor expected exception" << std::endl;
+
+            return false;
+        }
+        catch (const fixed::BadValueException&)
+        {
+        }
+    }
+
+    return true;
+}
+
+static bool signedTest ()
+{
+    const Divisor ten (Int256 (static_cast<__int128_t> (10)));
+    const __int128_t min128 = static_cast<__int128_t> (
+        static_cast<__uint128_t> (1) << 127
+    );
+
+    __int128_t down = 0;
+    __int128_t towardsZero = 0;
+    __int128_t positive = 0;
+
+    if (! ten.divideRounded (
+            static_cast<__int128_t> (-15), Rounding::Mode::DOWN, down
+        ) ||
+        ! ten.divideRounded (
+            static_cast<__int128_t> (-15),
+            Rounding::Mode::TOWARDS_ZERO,
+            towardsZero
+        ) ||
+        ! ten.divideRounded (
+            static_cast<__int128_t> (15), Rounding::Mode::UP, positive
+        ) ||
+        down != -2 ||
+        towardsZero != -1 ||
+        positive != 2 ||
+        Divisor ().divideRounded (min128, Rounding::Mode::UP, down) ||
+        ! Divisor::fitsInt64 (std::numeric_limits<int64_t>::min ()) ||
+        ! Divisor::fitsInt64 (std::numeric_limits<int64_t>::max ()) ||
+        Divisor::fitsInt64 (
+            static_cast<__int128_t> (std::numeric_limits<int64_t>::max ()) + 1
+        ) ||
+        Divisor::fitsInt64 (
+            static_cast<__int128_t> (std::numeric_limits<int64_t>::min ()) - 1
+        ))
+    {
+        std::cerr << "Divisor signed divide" << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<Test> DivisorTestVec = {
+    {constructTest, TestName ("Divisor construction")},
+    {divideTest, TestName ("Divisor divide")},
+    {signedTest, TestName ("Divisor signed divide")}
+};
+
+} // namespace test
+} // namespace fixed
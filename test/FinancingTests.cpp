@@ -0,0 +1,386 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/Financing.h"
+#include "fixed/Int256.h"
+#include "fixed/Parallel.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static const unsigned int BASES [] = {1, 252, 360, 365, 366};
+
+static const unsigned int POOL_SIZES [] = {1, 2, 3, 8};
+
+static __int128_t powerOfTen (const unsigned int exponent)
+{
+    __int128_t power = 1;
+
+    for (unsigned int idx = 0; idx < exponent; ++idx)
+    {
+        power *= 10;
+    }
+
+    return power;
+}
+
+//
+// The exact quotient in 256 bits, rounded once.  Sets overflows rather than
+// returning when the result is outside the range of a Number.
+//
+static Number reference (
+    const Number& units,
+    const Number& price,
+    const Number& rate,
+    const unsigned int days,
+    const Financing& financing,
+    bool& overflows
+)
+{
+    const unsigned int scale =
+        units.decimalPlaces () + price.decimalPlaces () + rate.decimalPlaces ();
+    const unsigned int decimalPlaces = financing.decimalPlaces ();
+
+    overflows = false;
+
+    try {
+        Int256 numerator =
+            Int256::multiply (units.scaledValue (), price.scaledValue ());
+        Int256 denominator (static_cast<__int128_t> (financing.basis ()));
+
+        numerator *= Int256 (rate.scaledValue ());
+        numerator *= Int256 (static_cast<__int128_t> (days));
+
+        if (scale >= decimalPlaces)
+        {
+            denominator *= Int256 (powerOfTen (scale - decimalPlaces));
+        }
+        else
+        {
+            numerator *= Int256 (powerOfTen (decimalPlaces - scale));
+        }
+
+        return Number::fromScaledValue (
+            Int256::divideRounded (
+                numerator, denominator, financing.roundingMode ()
+            ),
+            decimalPlaces
+        );
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    overflows = true;
+
+    return Number ();
+}
+
+//
+// Mantissas from 64 bits down to a few, at up to maxDecimalPlaces.
+//
+static Number randomNumber (
+    std::mt19937_64& generator,
+    const unsigned int maxDecimalPlaces
+)
+{
+    const int64_t mantissa =
+        static_cast<int64_t> (generator () >> 1) >> (generator () % 62);
+
+    return Number::fromScaledValue (
+        generator () % 2 ? mantissa : -mantissa,
+        generator () % (maxDecimalPlaces + 1)
+    );
+}
+
+static bool accrueTest ()
+{
+    const Number units (100000);
+    const Number price ("1.23456");
+    const Number rate ("0.0525");
+
+    return checkResult (
+            Financing (365, 2).accrue (units, price, rate, 3),
+            "53.27",
+            "accrue () nearest"
+        ) &&
+        checkResult (
+            Financing (365, 2, Rounding::Mode::UP).accrue (
+                units, price, rate, 3
+            ),
+            "53.28",
+            "accrue () up"
+        ) &&
+        checkResult (
+            Financing (365, 5).accrue (units, price, rate, 3),
+            "53.27211",
+            "accrue () 5 places"
+        ) &&
+        checkResult (
+            Financing (360, 2, Rounding::Mode::DOWN).accrue (
+                Number (-250000), Number ("148.325"), Number ("0.0125"), 1
+            ),
+            "-1287.55",
+            "accrue () short down"
+        ) &&
+        checkResult (
+            Financing (360, 2, Rounding::Mode::TOWARDS_ZERO).accrue (
+                Number (-250000), Number ("148.325"), Number ("0.0125"), 1
+            ),
+            "-1287.54",
+            "accrue () short towards zero"
+        ) &&
+        checkResult (
+            Financing (365, 2, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN).accrue (
+                Number (3), Number (1), Number ("1.825"), 1
+            ),
+            "0.02",
+            "accrue () half to even"
+        ) &&
+        checkResult (
+            Financing (365, 2, Rounding::Mode::TO_NEAREST_HALF_TO_ODD).accrue (
+                Number (3), Number (1), Number ("1.825"), 1
+            ),
+            "0.01",
+            "accrue () half to odd"
+        ) &&
+        checkResult (
+            Financing (365, 4).accrue (units, price, rate, 0),
+            "0.0000",
+            "accrue () no days"
+        ) &&
+        checkResult (
+            Financing (1, 0).accrue (
+                Number ("0.00000000000001"),
+                Number ("0.00000000000001"),
+                Number ("0.00000000000001"),
+                1
+            ),
+            "0",
+            "accrue () largest scale"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { Financing (0, 2); },
+            "Financing () zero basis"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { Financing (365, Number::MAX_DECIMAL_PLACES + 1); },
+            "Financing () decimal places"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [] () {
+                const Number large (std::numeric_limits<int64_t>::max ());
+
+                Financing (1, 0).accrue (large, large, Number (1), 1);
+            },
+            "accrue () too large"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [] () {
+                const Number large (std::numeric_limits<int64_t>::max ());
+
+                Financing (1, 0).accrue (large, large, large, 7);
+            },
+            "accrue () product too large"
+        );
+}
+
+//
+// Every rounding mode against the exact quotient, over products from a few
+// bits up to well past 256, with divisors both sides of 64 bits.
+//
+static bool randomTest ()
+{
+    std::mt19937_64 generator (47);
+
+    for (unsigned int test = 0; test < 200000; ++test)
+    {
+        const Financing financing (
+            BASES [generator () % (sizeof (BASES) / sizeof (BASES [0]))],
+            generator () % (Number::MAX_DECIMAL_PLACES + 1),
+            ROUNDING_MODES [generator () % 10]
+        );
+
+        const Number units = randomNumber (generator, 4);
+        const Number price = randomNumber (generator, 8);
+        const Number rate = randomNumber (generator, 10);
+        const unsigned int days = generator () % 8;
+
+        bool overflows = false;
+
+        const Number expected =
+            reference (units, price, rate, days, financing, overflows);
+
+        const std::string description =
+            "accrue (" + units.toString () + ", " + price.toString () + ", " +
+            rate.toString () + ", " + std::to_string (days) + ") / " +
+            std::to_string (financing.basis ());
+
+        if (overflows)
+        {
+            if (! expectException<fixed::OverflowException> (
+                    [&] () { financing.accrue (units, price, rate, days); },
+                    description
+                ))
+            {
+                return false;
+            }
+        }
+        else if (! checkResult (
+                financing.accrue (units, price, rate, days),
+                expected.toString (),
+                description
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// The batch against the scalar accrue () on each row whatever the pool
+// size, with wide values on the way in and out.
+//
+static bool batchTest ()
+{
+    const size_t count = 3 * parallel::CHUNK_SIZE + 17;
+
+    std::mt19937_64 generator (4747);
+
+    NumberColumn units (2);
+    NumberColumn prices (5);
+    NumberColumn rates (6);
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        units.pushBackScaledValue (
+            idx % 1000 == 0 ?
+                static_cast<__int128_t> (generator () >> 4) * 100 :
+                static_cast<int64_t> (generator ()) >> 28
+        );
+        prices.pushBackScaledValue (generator () % (1 << 24));
+        rates.pushBackScaledValue (static_cast<int32_t> (generator ()) >> 12);
+    }
+
+    if (! units.wideCount ())
+    {
+        std::cerr << "Financing batch test expected wide units" << std::endl;
+
+        return false;
+    }
+
+    for (const unsigned int decimalPlaces: {0u, 2u, 14u})
+    {
+        for (const auto mode: ROUNDING_MODES)
+        {
+            const Financing financing (365, decimalPlaces, mode);
+
+            std::vector<Number> expected;
+
+            expected.reserve (count);
+
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                expected.push_back (
+                    financing.accrue (units [idx], prices [idx], rates [idx], 3)
+                );
+            }
+
+            for (const auto threads: POOL_SIZES)
+            {
+                ThreadPool pool (threads);
+
+                const NumberColumn result =
+                    financing.accrue (units, prices, rates, 3, pool);
+
+                if (result.size () != count ||
+                    result.decimalPlaces () != decimalPlaces ||
+                    result.roundingMode () != mode)
+                {
+                    std::cerr << "Financing batch gave the wrong column"
+                              << std::endl;
+
+                    return false;
+                }
+
+                for (size_t idx = 0; idx < count; ++idx)
+                {
+                    if (! checkResult (
+                            result [idx],
+                            expected [idx].toString (),
+                            "batch accrue () row " + std::to_string (idx) +
+                                " with " + std::to_string (threads) +
+                                " threads"
+                        ))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    NumberColumn tooLarge (0);
+
+    tooLarge.push_back (Number (1));
+    tooLarge.push_back (Number (std::numeric_limits<int64_t>::max ()));
+
+    const Financing financing (1, 0);
+
+    return expectException<fixed::BadValueException> (
+            [&] () { financing.accrue (units, prices, tooLarge, 1); },
+            "batch accrue () sizes"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&] () { financing.accrue (tooLarge, tooLarge, tooLarge, 1); },
+            "batch accrue () too large"
+        ) &&
+        financing.accrue (
+            NumberColumn (2), NumberColumn (3), NumberColumn (4), 1
+        ).empty ();
+}
+
+std::vector<Test> FinancingTestVec = {
+    {accrueTest, TestName ("Financing accrue")},
+    {randomTest, TestName ("Financing random")},
+    {batchTest, TestName ("Financing batch")}
+};
+
+} // namespace test
+} // namespace fixed
@@ -0,0 +1,135 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Number.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+//
+// Equal values hash the same whatever their decimal places, including
+// pairs where one is held in 64 bits and the other in 128 bits.
+//
+static bool hashEqualValuesTest ()
+{
+    const std::vector<std::pair<std::string, std::string>> equalPairs = {
+        {"1.5", "1.50000"},
+        {"0", "-0.00000000000000"},
+        {"-42", "-42.00000000000000"},
+        {"1000000", "1000000.00000000000000"},
+        {"92233720368547758.07", "92233720368547758.07000000000000"},
+        {"-92233720368547758.08", "-92233720368547758.080"},
+        {"9223372036854775807", "9223372036854775807.00000000000000"}
+    };
+
+    const std::hash<Number> hasher;
+
+    for (const auto& pair: equalPairs)
+    {
+        const Number lhs (pair.first);
+        const Number rhs (pair.second);
+
+        if (! (lhs == rhs) || hasher (lhs) != hasher (rhs))
+        {
+            std::cerr << "Hashes for " << pair.first << " and "
+                      << pair.second << " differ" << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// Distinct random values at random decimal places should practically never
+// collide in 64 bits.
+//
+static bool hashDistinctValuesTest ()
+{
+    std::mt19937_64 generator (11);
+
+    std::unordered_map<size_t, Number> seen;
+
+    for (unsigned int i = 0; i < 100000; ++i)
+    {
+        const Number number (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >> (1 + generator () % 63),
+                generator () % (Number::MAX_DECIMAL_PLACES + 1)
+            )
+        );
+
+        const auto inserted = seen.emplace (number.hash (), number);
+
+        if (! inserted.second && ! (inserted.first->second == number))
+        {
+            std::cerr << "Hash collision between " << number.toString ()
+                      << " and " << inserted.first->second.toString ()
+                      << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// Numbers work as unordered container keys, found at any scale.
+//
+static bool hashContainerTest ()
+{
+    std::unordered_map<Number, std::string> prices = {
+        {Number ("1.10250"), "EUR/USD"},
+        {Number ("151.3"), "USD/JPY"}
+    };
+
+    std::unordered_set<Number> seen = {Number ("0.5"), Number ("0.50")};
+
+    return
+        prices.at (Number ("1.1025")) == "EUR/USD" &&
+        prices.at (Number ("151.30000")) == "USD/JPY" &&
+        prices.find (Number ("1.10251")) == prices.end () &&
+        seen.size () == 1;
+}
+
+std::vector<Test> HashTestVec = {
+    {hashEqualValuesTest, TestName ("Hash equal values")},
+    {hashDistinctValuesTest, TestName ("Hash distinct values")},
+    {hashContainerTest, TestName ("Hash containers")}
+};
+
+} // namespace test
+} // namespace fixed
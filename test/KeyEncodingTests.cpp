@@ -0,0 +1,219 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Number.h"
+#include "TestsCommon.h"
+
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+struct Key {
+    uint8_t bytes [Number::KEY_SIZE];
+};
+
+static Key encode (const Number& number)
+{
+    Key key;
+
+    number.encodeKey (key.bytes);
+
+    return key;
+}
+
+static int compareKeys (const Key& lhs, const Key& rhs)
+{
+    const int result = std::memcmp (lhs.bytes, rhs.bytes, sizeof (lhs.bytes));
+
+    return (result > 0) - (result < 0);
+}
+
+static int compareNumbers (const Number& lhs, const Number& rhs)
+{
+    return (rhs < lhs) - (lhs < rhs);
+}
+
+static const std::vector<std::string> keyStrings = {
+    "-9223372036854775807.99999999999999",
+    "-9223372036854775807",
+    "-92233720368547758.08",
+    "-1.5",
+    "-0.00000000000001",
+    "0",
+    "0.00000000000001",
+    "0.1",
+    "1",
+    "1.5",
+    "1.50000000000001",
+    "92233720368547758.07",
+    "9223372036854775807",
+    "9223372036854775807.99999999999999"
+};
+
+//
+// Equal values at different decimal places encode the same.
+//
+static bool keyCanonicalTest ()
+{
+    const std::vector<std::pair<std::string, std::string>> equalPairs = {
+        {"1.5", "1.50000"},
+        {"0", "-0.000"},
+        {"-42", "-42.00000000000000"},
+        {"123456789.1", "123456789.10"}
+    };
+
+    for (const auto& pair: equalPairs)
+    {
+        if (compareKeys (encode (Number (pair.first)),
+                         encode (Number (pair.second))))
+        {
+            std::cerr << "Keys for " << pair.first << " and " << pair.second
+                      << " differ" << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool keyRoundTripTest ()
+{
+    const std::vector<std::pair<std::string, std::string>> roundTrips = {
+        {"1.50", "1.5"},
+        {"-3.000", "-3"},
+        {"0.00", "0"},
+        {"-92233720368547758.08", "-92233720368547758.08"}
+    };
+
+    for (const auto& trip: roundTrips)
+    {
+        const std::string result =
+            Number::decodeKey (encode (Number (trip.first)).bytes).toString ();
+
+        if (result != trip.second)
+        {
+            std::cerr << "decodeKey () of " << trip.first << " gave "
+                      << result << " expected " << trip.second << std::endl;
+
+            return false;
+        }
+    }
+
+    for (const auto& str: keyStrings)
+    {
+        if (Number::decodeKey (encode (Number (str)).bytes).toString () != str)
+        {
+            std::cerr << "decodeKey () round trip failed for " << str
+                      << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// memcmp order matches Number order for every pair of the listed values
+// and for random pairs at random decimal places.
+//
+static bool keyOrderTest ()
+{
+    std::vector<Number> numbers;
+
+    for (const auto& str: keyStrings)
+    {
+        numbers.push_back (Number (str));
+    }
+
+    std::mt19937_64 generator (7);
+
+    for (unsigned int i = 0; i < 300; ++i)
+    {
+        numbers.push_back (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >> (1 + generator () % 63),
+                generator () % (Number::MAX_DECIMAL_PLACES + 1)
+            )
+        );
+    }
+
+    for (const auto& lhs: numbers)
+    {
+        for (const auto& rhs: numbers)
+        {
+            if (compareKeys (encode (lhs), encode (rhs)) !=
+                compareNumbers (lhs, rhs))
+            {
+                std::cerr << "Key order wrong for " << lhs.toString ()
+                          << " and " << rhs.toString () << std::endl;
+
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool keyOutOfRangeTest ()
+{
+    Key key;
+
+    for (const uint8_t fill: {0x00, 0xff})
+    {
+        std::memset (key.bytes, fill, sizeof (key.bytes));
+
+        try {
+            Number::decodeKey (key.bytes);
+
+            std::cerr << "Number::decodeKey expected exception" << std::endl;
+
+            return false;
+        }
+        catch (const fixed::BadValueException&)
+        {
+        }
+    }
+
+    return true;
+}
+
+std::vector<Test> KeyEncodingTestVec = {
+    {keyCanonicalTest, TestName ("Key canonical")},
+    {keyRoundTripTest, TestName ("Key round trip")},
+    {keyOrderTest, TestName ("Key order")},
+    {keyOutOfRangeTest, TestName ("Key out of range")}
+};
+
+} // namespace test
+} // namespace fixed
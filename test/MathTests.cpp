@@ -0,0 +1,659 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/Int256.h"
+#include "fixed/Math.h"
+#include "TestsCommon.h"
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+//
+// result against a long double reference rounded to nearest, skipping
+// results too large for it to settle the last place, or too close to half
+// way for it to tell which side they fall.
+//
+static bool checkNearest (
+    const Number& result,
+    const long double expected,
+    const unsigned int decimalPlaces,
+    const std::string& description
+)
+{
+    const long double scaled =
+        expected * std::pow (10.0L, static_cast<int> (decimalPlaces));
+    const long double fraction = scaled - std::floor (scaled);
+
+    if (std::fabs (scaled) > 1e14L || std::fabs (fraction - 0.5L) < 1e-2L)
+    {
+        return true;
+    }
+
+    const __int128_t rounded =
+        static_cast<__int128_t> (std::floor (scaled + 0.5L));
+
+    if (result.scaledValue () != rounded ||
+        result.decimalPlaces () != decimalPlaces)
+    {
+        std::cerr << description << " gave " << result.toString ()
+                  << " expected about " << static_cast<double> (expected)
+                  << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+static Number randomNumber (
+    std::mt19937_64& generator,
+    const int64_t low,
+    const int64_t high,
+    const unsigned int decimalPlaces
+)
+{
+    std::uniform_int_distribution<int64_t> distribution (low, high);
+
+    return Number::fromScaledValue (distribution (generator), decimalPlaces);
+}
+
+static bool sqrtTest ()
+{
+    const Number two (2);
+
+    return
+        checkResult (
+            sqrt (two, 14, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "1.41421356237310",
+            "sqrt (2)"
+        ) &&
+        checkResult (
+            sqrt (two, 14, Rounding::Mode::DOWN),
+            "1.41421356237309",
+            "sqrt (2) down"
+        ) &&
+        checkResult (
+            sqrt (Number ("123.456"), 7, Rounding::Mode::TO_NEAREST_HALF_UP),
+            "11.1110756",
+            "sqrt (123.456)"
+        ) &&
+        checkResult (
+            sqrt (Number ("0.00000000000001"), 7, Rounding::Mode::UP),
+            "0.0000001",
+            "sqrt exact"
+        ) &&
+        checkResult (
+            sqrt (Number ("2.25"), 0, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "2",
+            "sqrt half to even"
+        ) &&
+        checkResult (
+            sqrt (Number ("2.25"), 0, Rounding::Mode::TO_NEAREST_HALF_DOWN),
+            "1",
+            "sqrt half down"
+        ) &&
+        checkResult (
+            sqrt (Number (0), 3, Rounding::Mode::UP), "0.000", "sqrt (0)"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { sqrt (Number (-1), 2, Rounding::Mode::UP); },
+            "sqrt (-1)"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&two] () { sqrt (two, 15, Rounding::Mode::UP); },
+            "sqrt past max decimal places"
+        );
+}
+
+//
+// The root rounded down must be the integer square root of the value at
+// twice the decimal places, checked exactly right up to the largest Numbers.
+//
+static bool sqrtExactTest ()
+{
+    std::mt19937_64 generator (45);
+
+    for (unsigned int idx = 0; idx < 2000; ++idx)
+    {
+        const unsigned int decimalPlaces = idx % 15;
+        const unsigned int rootDecimalPlaces = (idx / 15) % 15;
+
+        const Number value = randomNumber (
+            generator,
+            0,
+            std::numeric_limits<int64_t>::max (),
+            decimalPlaces
+        );
+
+        const Number root =
+            sqrt (value, rootDecimalPlaces, Rounding::Mode::DOWN);
+
+        const int rescale =
+            2 * static_cast<int> (rootDecimalPlaces) -
+            static_cast<int> (decimalPlaces);
+
+        Int256 target (value.scaledValue ());
+        Int256 scale (1);
+
+        for (int power = 0; power < std::abs (rescale); ++power)
+        {
+            (rescale > 0 ? target : scale) *= Int256 (10);
+        }
+
+        Int256 low =
+            Int256::multiply (root.scaledValue (), root.scaledValue ());
+        Int256 high = Int256::multiply (
+            root.scaledValue () + 1,
+            root.scaledValue () + 1
+        );
+
+        low *= scale;
+        high *= scale;
+
+        if (target < low || ! (target < high) ||
+            ! checkNearest (
+                sqrt (
+                    value,
+                    rootDecimalPlaces,
+                    Rounding::Mode::TO_NEAREST_HALF_TO_EVEN
+                ),
+                std::sqrt (value.toLongDouble ()),
+                rootDecimalPlaces,
+                "sqrt (" + value.toString () + ")"
+            ))
+        {
+            std::cerr << "sqrt (" << value.toString () << ") gave "
+                      << root.toString () << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool expLogTest ()
+{
+    const Rounding::Mode even = Rounding::Mode::TO_NEAREST_HALF_TO_EVEN;
+
+    return
+        checkResult (exp (Number (1), 14, even), "2.71828182845905", "e") &&
+        checkResult (
+            exp (Number (1), 14, Rounding::Mode::DOWN),
+            "2.71828182845904",
+            "e down"
+        ) &&
+        checkResult (
+            exp (Number (-1), 14, Rounding::Mode::UP),
+            "0.36787944117145",
+            "exp (-1) up"
+        ) &&
+        checkResult (
+            exp (Number (43), 0, even), "4727839468229346561", "exp (43)"
+        ) &&
+        checkResult (
+            exp (Number (0), 3, Rounding::Mode::DOWN), "1.000", "exp (0)"
+        ) &&
+        checkResult (
+            exp (Number (-100), 14, Rounding::Mode::UP),
+            "0.00000000000001",
+            "exp (-100) up"
+        ) &&
+        checkResult (
+            exp (Number (-40), 14, Rounding::Mode::UP),
+            "0.00000000000001",
+            "exp (-40) up"
+        ) &&
+        checkResult (
+            exp (Number (-100), 14, Rounding::Mode::DOWN),
+            "0.00000000000000",
+            "exp (-100) down"
+        ) &&
+        checkResult (log (Number (2), 14, even), "0.69314718055995", "ln 2") &&
+        checkResult (
+            log (Number (10), 14, even), "2.30258509299405", "ln 10"
+        ) &&
+        checkResult (
+            log (Number ("0.5"), 14, Rounding::Mode::DOWN),
+            "-0.69314718055995",
+            "ln 0.5 down"
+        ) &&
+        checkResult (
+            log (Number ("0.5"), 14, Rounding::Mode::UP),
+            "-0.69314718055994",
+            "ln 0.5 up"
+        ) &&
+        checkResult (
+            log (Number ("0.00001"), 14, even),
+            "-11.51292546497023",
+            "ln 0.00001"
+        ) &&
+        checkResult (
+            log (Number ("9223372036854775807"), 14, even),
+            "43.66827237527655",
+            "ln max"
+        ) &&
+        checkResult (
+            log (Number (1), 5, Rounding::Mode::UP), "0.00000", "ln 1"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [] () { exp (Number (44), 0, Rounding::Mode::DOWN); },
+            "exp (44)"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { log (Number (0), 2, Rounding::Mode::DOWN); },
+            "ln 0"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { log (Number (-1), 2, Rounding::Mode::DOWN); },
+            "ln -1"
+        );
+}
+
+static bool powTest ()
+{
+    const Rounding::Mode even = Rounding::Mode::TO_NEAREST_HALF_TO_EVEN;
+
+    //
+    // Exact powers round as exact values, even rounding down.
+    //
+    return
+        checkResult (
+            pow (Number (4), Number ("0.5"), 14, Rounding::Mode::DOWN),
+            "2.00000000000000",
+            "4^0.5"
+        ) &&
+        checkResult (
+            pow (Number ("1.1"), Number (2), 4, Rounding::Mode::DOWN),
+            "1.2100",
+            "1.1^2"
+        ) &&
+        checkResult (
+            pow (Number (2), Number (10), 0, Rounding::Mode::DOWN),
+            "1024",
+            "2^10"
+        ) &&
+        checkResult (
+            pow (Number (2), Number (-2), 2, Rounding::Mode::UP),
+            "0.25",
+            "2^-2"
+        ) &&
+        checkResult (
+            pow (Number (-2), Number (3), 0, Rounding::Mode::DOWN),
+            "-8",
+            "-2^3"
+        ) &&
+        checkResult (
+            pow (Number (-2), Number (2), 0, Rounding::Mode::UP), "4", "-2^2"
+        ) &&
+        checkResult (
+            pow (Number ("2.25"), Number ("0.5"), 0, even), "2", "1.5 to even"
+        ) &&
+        checkResult (
+            pow (Number ("2.25"), Number ("0.5"), 0,
+                Rounding::Mode::TO_NEAREST_HALF_DOWN),
+            "1",
+            "1.5 half down"
+        ) &&
+        checkResult (
+            pow (Number ("1.0001"), Number (365), 10, even),
+            "1.0371724113",
+            "1.0001^365"
+        ) &&
+        checkResult (
+            pow (Number ("1.2345"), Number ("1.5"), 12, even),
+            "1.371628945315",
+            "1.2345^1.5"
+        ) &&
+        checkResult (
+            pow (Number (0), Number (0), 1, even), "1.0", "0^0"
+        ) &&
+        checkResult (
+            pow (Number (0), Number ("2.5"), 1, even), "0.0", "0^2.5"
+        ) &&
+        checkResult (
+            pow (Number (10), Number (-20), 14, Rounding::Mode::AWAY_FROM_ZERO),
+            "0.00000000000001",
+            "10^-20 away from zero"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [] () { pow (Number (10), Number (19), 0, even); },
+            "10^19"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [] () { pow (Number (2), Number ("1e15"), 0, even); },
+            "2^1e15"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { pow (Number (-2), Number ("0.5"), 2, even); },
+            "-2^0.5"
+        ) &&
+        expectException<fixed::DivideByZeroException> (
+            [] () { pow (Number (0), Number (-1), 2, even); },
+            "0^-1"
+        );
+}
+
+static bool randomTest ()
+{
+    std::mt19937_64 generator (450);
+
+    const Rounding::Mode even = Rounding::Mode::TO_NEAREST_HALF_TO_EVEN;
+
+    for (unsigned int idx = 0; idx < 2000; ++idx)
+    {
+        const unsigned int decimalPlaces = idx % 15;
+
+        const Number argument = randomNumber (
+            generator, -3000000000, 3000000000, 8
+        );
+        const Number positive = randomNumber (
+            generator, 1, 1000000000000000, 10
+        );
+        const Number base = randomNumber (generator, 1, 5000000, 5);
+        const Number exponent = randomNumber (generator, -50000, 50000, 4);
+
+        if (! checkNearest (
+                exp (argument, decimalPlaces, even),
+                std::exp (argument.toLongDouble ()),
+                decimalPlaces,
+                "exp (" + argument.toString () + ")"
+            ) ||
+            ! checkNearest (
+                log (positive, decimalPlaces, even),
+                std::log (positive.toLongDouble ()),
+                decimalPlaces,
+                "log (" + positive.toString () + ")"
+            ) ||
+            ! checkNearest (
+                pow (base, exponent, decimalPlaces, even),
+                std::pow (base.toLongDouble (), exponent.toLongDouble ()),
+                decimalPlaces,
+                "pow (" + base.toString () + ", " + exponent.toString () + ")"
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool integerPowTest ()
+{
+    const Rounding::Mode even = Rounding::Mode::TO_NEAREST_HALF_TO_EVEN;
+    const Rounding::Mode down = Rounding::Mode::DOWN;
+
+    return
+        checkResult (
+            pow (Number (10), 18u, 14, down),
+            "1000000000000000000.00000000000000",
+            "10^18"
+        ) &&
+        checkResult (
+            pow (Number (2), 62u, 14, down),
+            "4611686018427387904.00000000000000",
+            "2^62"
+        ) &&
+        checkResult (
+            pow (Number ("2.0000000000000"), 10u, 14, down),
+            "1024.00000000000000",
+            "2.0000000000000^10"
+        ) &&
+        checkResult (
+            pow (Number ("0.5"), 14u, 14, down),
+            "0.00006103515625",
+            "0.5^14"
+        ) &&
+        checkResult (
+            pow (Number ("-1.5"), 3u, 2, down), "-3.38", "-1.5^3"
+        ) &&
+        checkResult (
+            pow (Number ("0.1"), 20u, 14, Rounding::Mode::UP),
+            "0.00000000000001",
+            "0.1^20 up"
+        ) &&
+        checkResult (
+            pow (Number ("0.1"), 30u, 14, Rounding::Mode::UP),
+            "0.00000000000001",
+            "0.1^30 up"
+        ) &&
+        checkResult (
+            pow (Number ("0.1"), 30u, 14, down),
+            "0.00000000000000",
+            "0.1^30 down"
+        ) &&
+        checkResult (
+            pow (Number ("-0.8911177"), 739u, 2, down),
+            "-0.01",
+            "Tiny odd power down"
+        ) &&
+        checkResult (pow (Number (0), 0u, 2, down), "1.00", "0^0") &&
+        checkResult (pow (Number (0), 5u, 2, down), "0.00", "0^5") &&
+        checkResult (
+            pow (Number ("1.1"), 100u, 14, even),
+            "13780.61233982227018",
+            "1.1^100"
+        ) &&
+        checkResult (
+            pow (Number ("0.99"), 1000u, 14, Rounding::Mode::UP),
+            "0.00004317124742",
+            "0.99^1000"
+        ) &&
+        checkResult (
+            pow (Number ("1.00001"), 2000000u, 3, even),
+            "485116681.639",
+            "1.00001^2000000"
+        ) &&
+        checkResult (
+            pow (Number (3), Number (39), 0, down),
+            "4052555153018976267",
+            "3^39 through pow (Number, Number)"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [] () { pow (Number (2), 63u, 0, down); },
+            "2^63"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [] () { pow (Number ("1.5"), 4000000000u, 0, down); },
+            "1.5^4000000000"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { pow (Number (2), 2u, 15, down); },
+            "pow past max decimal places"
+        );
+}
+
+//
+// Daily compounding over a year and over ten, against the exact decimal
+// value.
+//
+static bool compoundingTest ()
+{
+    const Number daily ("1.000137");
+
+    return
+        checkResult (
+            pow (daily, 365u, 14, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "1.05127275209810",
+            "One year"
+        ) &&
+        checkResult (
+            pow (daily, 365u, 14, Rounding::Mode::DOWN),
+            "1.05127275209809",
+            "One year down"
+        ) &&
+        checkResult (
+            pow (daily, 3650u, 14, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "1.64874723777522",
+            "Ten years"
+        ) &&
+        checkResult (
+            pow (Number ("1.05"), 30u, 10, Rounding::Mode::DOWN),
+            "4.3219423751",
+            "Thirty years"
+        ) &&
+        checkResult (
+            pow (Number ("1.0000001"), 4000000u, 14, Rounding::Mode::DOWN),
+            "1.49182466780477",
+            "Long compounding"
+        );
+}
+
+static bool integerPowRandomTest ()
+{
+    std::mt19937_64 generator (46);
+    std::uniform_int_distribution<unsigned int> exponents (0, 200);
+
+    for (unsigned int idx = 0; idx < 2000; ++idx)
+    {
+        const unsigned int decimalPlaces = idx % 15;
+        const Number base = randomNumber (generator, -20000, 20000, 4);
+        const unsigned int exponent = exponents (generator);
+
+        long double expected = 1;
+
+        for (unsigned int power = 0; power < exponent; ++power)
+        {
+            expected *= base.toLongDouble ();
+        }
+
+        Number result;
+
+        try {
+            result = pow (
+                base,
+                exponent,
+                decimalPlaces,
+                Rounding::Mode::TO_NEAREST_HALF_TO_EVEN
+            );
+        }
+        catch (const fixed::OverflowException&)
+        {
+            if (std::fabs (expected) < 9e18L)
+            {
+                std::cerr << "pow (" << base.toString () << ", " << exponent
+                          << ") overflowed" << std::endl;
+
+                return false;
+            }
+
+            continue;
+        }
+
+        if (! checkNearest (
+                result,
+                expected,
+                decimalPlaces,
+                "pow (" + base.toString () + ", " +
+                    std::to_string (exponent) + ")"
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// Whether pow (Number, T, ...) resolves to a function that can be called.
+//
+template <typename T, typename = void>
+struct PowAccepts : std::false_type {};
+
+template <typename T>
+struct PowAccepts<
+    T,
+    decltype (void (fixed::pow (
+        std::declval<const Number&> (),
+        std::declval<T> (),
+        0u,
+        Rounding::Mode::DOWN
+    )))
+> : std::true_type {};
+
+//
+// Signed and floating point exponents are rejected rather than converted to
+// unsigned int, as pow (4, 0.5) would otherwise be 4^0.
+//
+static bool powOverloadTest ()
+{
+    const struct {
+        bool accepted;
+        bool expected;
+        const char* type;
+    } checks [] = {
+        {PowAccepts<Number>::value, true, "Number"},
+        {PowAccepts<unsigned int>::value, true, "unsigned int"},
+        {PowAccepts<uint64_t>::value, true, "uint64_t"},
+        {PowAccepts<int>::value, false, "int"},
+        {PowAccepts<int64_t>::value, false, "int64_t"},
+        {PowAccepts<signed char>::value, false, "signed char"},
+        {PowAccepts<float>::value, false, "float"},
+        {PowAccepts<double>::value, false, "double"},
+        {PowAccepts<long double>::value, false, "long double"}
+    };
+
+    for (const auto& check: checks)
+    {
+        if (check.accepted != check.expected)
+        {
+            std::cerr << "pow () with an exponent of type " << check.type
+                      << (check.accepted ? " resolved" : " didn't resolve")
+                      << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<Test> MathTestVec = {
+    {sqrtTest, TestName ("sqrt")},
+    {sqrtExactTest, TestName ("sqrt exact root")},
+    {expLogTest, TestName ("exp and log")},
+    {powTest, TestName ("pow")},
+    {randomTest, TestName ("Against long double")},
+    {integerPowTest, TestName ("Integer pow")},
+    {powOverloadTest, TestName ("pow exponent types")},
+    {compoundingTest, TestName ("Compounding factor")},
+    {integerPowRandomTest, TestName ("Integer pow against long double")}
+};
+
+} // namespace test
+} // namespace fixed
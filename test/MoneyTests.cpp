@@ -0,0 +1,273 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Exceptions.h"
+#include "fixed/Money.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static bool checkResult (
+    const Money& result,
+    const std::string& expected,
+    const std::string& description
+)
+{
+    if (result.toString () != expected)
+    {
+        std::cerr << description << " gave " << result.toString ()
+                  << " expected " << expected << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool currencyTest ()
+{
+    if (Currency::decimalPlaces (Currency::USD) != 2 ||
+        Currency::decimalPlaces (Currency::JPY) != 0 ||
+        Currency::decimalPlaces (Currency::BHD) != 3 ||
+        Currency::decimalPlaces (Currency::XXX) != 0 ||
+        Currency::code (Currency::EUR) != "EUR" ||
+        Currency::fromCode ("KWD") != Currency::KWD ||
+        ! Currency::isKnown (Currency::GBP) ||
+        Currency::isKnown (0) ||
+        Currency::isKnown (1000) ||
+        sizeof (Money) > 16)
+    {
+        std::cerr << "Currency table" << std::endl;
+
+        return false;
+    }
+
+    for (uint16_t currency = 0; currency <= Currency::XXX; ++currency)
+    {
+        if (Currency::isKnown (currency) &&
+            Currency::fromCode (Currency::code (currency)) != currency)
+        {
+            std::cerr << "Currency code " << currency << std::endl;
+
+            return false;
+        }
+    }
+
+    return expectException<fixed::BadValueException> (
+            [] () { Currency::decimalPlaces (1); },
+            "decimalPlaces () unknown"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { Currency::code (1); },
+            "code () unknown"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { Currency::fromCode ("usd"); },
+            "fromCode () unknown"
+        );
+}
+
+static bool constructTest ()
+{
+    return checkResult (Money (), "0 XXX", "Money ()") &&
+        checkResult (
+            Money (Number ("1234.565"), Currency::USD),
+            "1234.56 USD",
+            "Money () half to even"
+        ) &&
+        checkResult (
+            Money (Number ("1234.561"), Currency::USD, Rounding::Mode::UP),
+            "1234.57 USD",
+            "Money () up"
+        ) &&
+        checkResult (
+            Money (Number ("1500.5"), Currency::JPY),
+            "1500 JPY",
+            "Money () JPY"
+        ) &&
+        checkResult (
+            Money (Number ("-0.1235"), Currency::BHD),
+            "-0.124 BHD",
+            "Money () BHD"
+        ) &&
+        checkResult (
+            Money (Number (12), Currency::KWD),
+            "12.000 KWD",
+            "Money () scaled up"
+        ) &&
+        checkResult (
+            Money::fromMinorUnits (-150, Currency::EUR),
+            "-1.50 EUR",
+            "fromMinorUnits ()"
+        ) &&
+        Money (Number ("0.004"), Currency::USD).isZero () &&
+        Money (Number ("19.99"), Currency::GBP).minorUnits () == 1999 &&
+        Money (Number ("19.99"), Currency::GBP).decimalPlaces () == 2 &&
+        Money (Number ("19.99"), Currency::GBP).amount () == Number ("19.99") &&
+        expectException<fixed::BadValueException> (
+            [] () { Money (Number (1), 1); },
+            "Money () unknown currency"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () {
+                Money::fromMinorUnits (
+                    std::numeric_limits<int64_t>::min (), Currency::USD
+                );
+            },
+            "fromMinorUnits () min"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [] () {
+                Money (
+                    Number (std::numeric_limits<int64_t>::max ()),
+                    Currency::USD
+                );
+            },
+            "Money () too large"
+        );
+}
+
+static bool arithmeticTest ()
+{
+    const Money price (Number ("19.99"), Currency::USD);
+    const Money fee (Number ("0.25"), Currency::USD);
+    const Money yen (Number (2500), Currency::JPY);
+    const Money largest = Money::fromMinorUnits (
+        std::numeric_limits<int64_t>::max (), Currency::USD
+    );
+
+    Money total;
+
+    total = price + fee;
+    total -= fee;
+    total -= price;
+    total -= price;
+
+    return checkResult (price + fee, "20.24 USD", "operator+") &&
+        checkResult (fee - price, "-19.74 USD", "operator-") &&
+        checkResult (-yen, "-2500 JPY", "negate") &&
+        checkResult (total, "-19.99 USD", "operator-=") &&
+        fee < price &&
+        fee <= fee &&
+        price > fee &&
+        price >= fee &&
+        price == Money (Number ("19.990"), Currency::USD) &&
+        price != fee &&
+        Money (Number (0), Currency::USD) != Money () &&
+        expectException<fixed::BadValueException> (
+            [&] () { price + yen; },
+            "operator+ mismatch"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&] () { price < yen; },
+            "operator< mismatch"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&] () { largest + fee; },
+            "operator+ too large"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&] () { -largest - fee; },
+            "operator- too large"
+        );
+}
+
+static bool convertTest ()
+{
+    const Money dollars (Number (100), Currency::USD);
+    const Money yen (Number (1000000), Currency::JPY);
+
+    return checkResult (
+            dollars.convert (Currency::JPY, Number ("149.505")),
+            "14950 JPY",
+            "convert () half to even"
+        ) &&
+        checkResult (
+            dollars.convert (
+                Currency::JPY, Number ("149.505"), Rounding::Mode::UP
+            ),
+            "14951 JPY",
+            "convert () up"
+        ) &&
+        checkResult (
+            yen.convert (Currency::USD, Number ("0.0066889632107")),
+            "6688.96 USD",
+            "convert () JPY to USD"
+        ) &&
+        checkResult (
+            yen.convert (Currency::KWD, Number (2)),
+            "2000000.000 KWD",
+            "convert () scaled up"
+        ) &&
+        checkResult (
+            (-dollars).convert (
+                Currency::JPY, Number ("123456789.12345678901")
+            ),
+            "-12345678912 JPY",
+            "convert () wide rate"
+        ) &&
+        checkResult (
+            (-dollars).convert (Currency::BHD, Number ("0.37605")),
+            "-37.605 BHD",
+            "convert () to BHD"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&] () { dollars.convert (1, Number (1)); },
+            "convert () unknown"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&] () { dollars.convert (Currency::JPY, Number ("-150.5")); },
+            "convert () negative rate"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&] () { dollars.convert (Currency::JPY, Number ("0.00")); },
+            "convert () zero rate"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&] () {
+                Money::fromMinorUnits (
+                    std::numeric_limits<int64_t>::max (), Currency::USD
+                ).convert (Currency::JPY, Number (150));
+            },
+            "convert () too large"
+        );
+}
+
+std::vector<Test> MoneyTestVec = {
+    {currencyTest, TestName ("Currency table")},
+    {constructTest, TestName ("Money construction")},
+    {arithmeticTest, TestName ("Money arithmetic")},
+    {convertTest, TestName ("Money convert")}
+};
+
+} // namespace test
+} // namespace fixed
@@ -0,0 +1,300 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/NumberColumn.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static std::vector<Number> makeNumbers (const std::vector<std::string>& strs)
+{
+    std::vector<Number> numbers;
+
+    for (const auto& str: strs)
+    {
+        numbers.push_back (Number (str));
+    }
+
+    return numbers;
+}
+
+static bool checkColumn (
+    const std::string& errMsgHdr,
+    const NumberColumn& column,
+    const std::vector<std::string>& expected,
+    const size_t expectedWideCount
+)
+{
+    if (! valCheck (expected.size (), column.size (), errMsgHdr + " size ") ||
+        ! valCheck (
+            expectedWideCount, column.wideCount (), errMsgHdr + " wideCount "
+        ))
+    {
+        return false;
+    }
+
+    size_t wideCount = 0;
+
+    for (size_t idx = 0; idx < expected.size (); ++idx)
+    {
+        const std::string hdr = errMsgHdr + " [" + std::to_string (idx) + "]";
+
+        if (! checkNumber (hdr, column.at (idx), Number (expected [idx])))
+        {
+            return false;
+        }
+
+        if (column.isWide (idx))
+        {
+            ++wideCount;
+
+            if (column.mantissas () [idx] != NumberColumn::WIDE_MARKER)
+            {
+                std::cerr << hdr << " wide value without marker" << std::endl;
+
+                return false;
+            }
+        }
+        else if (column.mantissas () [idx] != column.scaledValue (idx))
+        {
+            std::cerr << hdr << " mantissa mismatch" << std::endl;
+
+            return false;
+        }
+    }
+
+    return valCheck (expectedWideCount, wideCount, errMsgHdr + " isWide ");
+}
+
+static bool scaledValueTest ()
+{
+    return
+        valCheck<int64_t> (
+            1234, Number ("12.34").scaledValue (), "scaledValue 12.34 "
+        )
+        &&
+        valCheck<int64_t> (
+            -5, Number ("-0.05").scaledValue (), "scaledValue -0.05 "
+        )
+        &&
+        checkNumber (
+            "fromScaledValue -5",
+            Number::fromScaledValue (-5, 2),
+            Number ("-0.05")
+        )
+        &&
+        checkNumber (
+            "fromScaledValue max",
+            Number::fromScaledValue (
+                Number ("9223372036854775807.99999999999999").scaledValue (),
+                14
+            ),
+            Number ("9223372036854775807.99999999999999")
+        )
+        &&
+        checkNumber (
+            "fromScaledValue int64 min",
+            Number::fromScaledValue (std::numeric_limits<int64_t>::min (), 2),
+            Number ("-92233720368547758.08")
+        );
+}
+
+static bool roundTripTest ()
+{
+    const NumberColumn column (
+        makeNumbers ({"1.5", "-2.25", "0", "123456789.1234", "-0.0001", "7"}),
+        4
+    );
+
+    return checkColumn (
+        "roundTrip",
+        column,
+        {
+            "1.5000", "-2.2500", "0.0000", "123456789.1234", "-0.0001",
+            "7.0000"
+        },
+        0
+    );
+}
+
+static bool roundingTest ()
+{
+    NumberColumn evenColumn (2);
+    NumberColumn awayColumn (2, Rounding::Mode::TO_NEAREST_HALF_AWAY_FROM_ZERO);
+
+    for (const auto& str: {"1.005", "1.015", "-1.005", "2.3449"})
+    {
+        evenColumn.push_back (Number (str));
+        awayColumn.push_back (Number (str));
+    }
+
+    return
+        checkColumn (
+            "rounding even", evenColumn, {"1.00", "1.02", "-1.00", "2.34"}, 0
+        )
+        &&
+        checkColumn (
+            "rounding away", awayColumn, {"1.01", "1.02", "-1.01", "2.34"}, 0
+        );
+}
+
+static bool wideValueTest ()
+{
+    const std::vector<std::string> strs = {
+        "9223372036854775807.99999999999999",
+        "1.50000000000000",
+        "92233.72036854775808",
+        "92233.72036854775807",
+        "-92233.72036854775807",
+        "-92233.72036854775808",
+        "-9223372036854775807.99999999999999"
+    };
+
+    NumberColumn column (makeNumbers (strs), 14);
+
+    if (! checkColumn ("wide", column, strs, 4))
+    {
+        return false;
+    }
+
+    column.set (0, Number ("3"));
+    column.set (1, Number ("-92233.72036854775809"));
+    column.set (5, Number ("-92233.72036854775808"));
+
+    return checkColumn (
+        "wide set",
+        column,
+        {
+            "3.00000000000000",
+            "-92233.72036854775809",
+            "92233.72036854775808",
+            "92233.72036854775807",
+            "-92233.72036854775807",
+            "-92233.72036854775808",
+            "-9223372036854775807.99999999999999"
+        },
+        4
+    );
+}
+
+static bool iterationTest ()
+{
+    const std::vector<std::string> strs = {
+        "0.50", "-0.25", "92233720368547758.07", "92233720368547758.08"
+    };
+
+    const NumberColumn column (
+        makeNumbers (
+            {"0.5", "-0.25", "92233720368547758.07", "9.223372036854775808e16"}
+        ),
+        2
+    );
+
+    size_t idx = 0;
+
+    for (const auto& number: column)
+    {
+        if (! checkNumber ("iteration", number, Number (strs [idx])))
+        {
+            return false;
+        }
+
+        ++idx;
+    }
+
+    const auto numbers = column.toNumbers ();
+
+    for (idx = 0; idx < numbers.size (); ++idx)
+    {
+        if (! checkNumber ("toNumbers", numbers [idx], column [idx]))
+        {
+            return false;
+        }
+    }
+
+    return valCheck (strs.size (), idx, "iteration count ");
+}
+
+static bool badValueTest ()
+{
+    NumberColumn column (0);
+
+    column.push_back (Number ("1"));
+
+    try {
+        column.at (1);
+
+        std::cerr << "at () expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    try {
+        column.pushBackScaledValue (
+            static_cast<__int128_t> (Number::MAX_INTEGER_VALUE) + 1
+        );
+
+        std::cerr << "pushBackScaledValue () expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    try {
+        NumberColumn tooPrecise (Number::MAX_DECIMAL_PLACES + 1);
+
+        std::cerr << "NumberColumn () expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    return checkColumn ("badValue", column, {"1"}, 0);
+}
+
+std::vector<Test> NumberColumnTestVec = {
+    {scaledValueTest, TestName ("scaledValue")},
+    {roundTripTest, TestName ("NumberColumn round trip")},
+    {roundingTest, TestName ("NumberColumn rounding")},
+    {wideValueTest, TestName ("NumberColumn wide values")},
+    {iterationTest, TestName ("NumberColumn iteration")},
+    {badValueTest, TestName ("NumberColumn bad values")}
+};
+
+} // namespace test
+} // namespace fixed
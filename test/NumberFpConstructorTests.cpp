@@ -107,6 +107,8 @@ class ConstructorTest {
 static const bool V64 = true;
 static const bool V128 = ! V64;
 
+static const unsigned int MIN_DPS = Number::MAX_DECIMAL_PLACES + 1;
+
 template <typename T>
 constexpr Test createTest (
     const T floatVal,
@@ -172,6 +174,56 @@ std::vector<Test> NumberFpConstructorTestVec = {
     //
     createTest (
         3.200000, Number::MAX_DECIMAL_PLACES + 1, 1, 3, 2, "3.2", V64
+    ),
+
+    //
+    // The shortest decimal that converts back to the same floating point
+    // value is used, rather than the truncated binary expansion.
+    //
+    createTest (0.1, MIN_DPS, 1, 0, 1, "0.1", V64),
+    createTest (0.1f, MIN_DPS, 1, 0, 1, "0.1", V64),
+    createTest (0.1L, MIN_DPS, 1, 0, 1, "0.1", V64),
+    createTest (-0.1, MIN_DPS, 1, 0, 1, "-0.1", V64),
+    createTest (0.1 + 0.2, MIN_DPS, 1, 0, 3, "0.3", V64),
+    createTest (1.005, MIN_DPS, 3, 1, 5, "1.005", V64),
+    createTest (123456.789, MIN_DPS, 3, 123456, 789, "123456.789", V64),
+    createTest (1.5e-5, MIN_DPS, 6, 0, 15, "0.000015", V64),
+    createTest (1e-14, MIN_DPS, 14, 0, 1, "0.00000000000001", V64),
+    createTest (1e15, MIN_DPS, 0, 1000000000000000, 0, "1000000000000000", V64),
+    createTest (0.0, MIN_DPS, 0, 0, 0, "0", V64),
+    createTest (0.0, 2, 2, 0, 0, "0.00", V64),
+    createTest (33.33, 4, 4, 33, 3300, "33.3300", V64),
+
+    //
+    // Rounding is applied to the shortest decimal, 2.675 is really
+    // 2.67499999999999982236431605997495353221893310546875
+    //
+    createTest (2.675, 2, 2, 2, 68, "2.68", V64),
+    createTest (-2.675, 2, 2, 2, 68, "-2.68", V64),
+    createTest (1.005, 2, 2, 1, 0, "1.00", V64),
+
+    //
+    // No short representation within MAX_DECIMAL_PLACES, the exact value is
+    // rounded.
+    //
+    createTest (
+        1.0 / 3.0, MIN_DPS, 14, 0, 33333333333333, "0.33333333333333", V64
+    ),
+    createTest (
+        2.0 / 3.0, MIN_DPS, 14, 0, 66666666666667, "0.66666666666667", V64
+    ),
+    createTest (4e-15, MIN_DPS, 0, 0, 0, "0", V64),
+    createTest (6e-15, MIN_DPS, 14, 0, 1, "0.00000000000001", V64),
+    createTest (1e-300, MIN_DPS, 0, 0, 0, "0", V64),
+
+    createTest (
+        9223372036854774784.0,
+        MIN_DPS,
+        0,
+        9223372036854774784ULL,
+        0,
+        "9223372036854774784",
+        V64
     )
 
 };
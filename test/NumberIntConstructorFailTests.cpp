@@ -158,7 +158,24 @@ std::vector<Test> NumberIntConstructorFailTestVec = {
     createTest ("-11234435.0B"),
     createTest (""),
     createTest ("."),
-    createTest ("1.")
+    createTest ("1."),
+    createTest ("1e"),
+    createTest ("1e-"),
+    createTest ("1e+"),
+    createTest ("1.5e"),
+    createTest ("e5"),
+    createTest ("1.e5"),
+    createTest ("1e5.0"),
+    createTest ("1e5x"),
+    createTest ("1e-15"),
+    createTest ("1.5e-14"),
+    createTest ("0e-15"),
+    createTest ("1e19"),
+    createTest ("9.223372036854775808e18"),
+    createTest ("-9.223372036854775808e18"),
+    createTest ("1e100"),
+    createTest ("1e-100"),
+    createTest ("1e99999999999999999999")
 };
 
 } // namespace test
@@ -0,0 +1,98 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Number.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+class StrExponentTest {
+  public:
+    StrExponentTest (
+        const std::string& input,
+        const std::string& expectedResult
+    )
+      : input_ (input),
+        expectedResult_ (expectedResult)
+    {}
+
+    bool operator() ()
+    {
+        return checkNumber (
+            "Exponent '" + input_ + "'",
+            Number (input_),
+            Number (expectedResult_)
+        );
+    }
+
+  private:
+    const std::string input_;
+    const std::string expectedResult_;
+};
+
+static Test createTest (
+    const std::string& input,
+    const std::string& expectedResult
+)
+{
+    return Test (
+        StrExponentTest (input, expectedResult),
+        [=] () {
+            return "String exponent '" + input + "'";
+        }
+    );
+}
+
+std::vector<Test> NumberStrExponentTestVec = {
+    createTest ("1.5e-5", "0.000015"),
+    createTest ("1.5E-5", "0.000015"),
+    createTest ("-1.5e-5", "-0.000015"),
+    createTest ("2E+3", "2000"),
+    createTest ("2e3", "2000"),
+    createTest ("-2e3", "-2000"),
+    createTest ("1.250e2", "125.0"),
+    createTest ("1.25e2", "125"),
+    createTest ("1.25e3", "1250"),
+    createTest ("125e-2", "1.25"),
+    createTest ("7e0", "7"),
+    createTest ("7.00e-0", "7.00"),
+    createTest ("0e100", "0"),
+    createTest ("0e-14", "0.00000000000000"),
+    createTest ("1e-14", "0.00000000000001"),
+    createTest ("1.23456789012345678e4", "12345.6789012345678"),
+    createTest ("9.223372036854775807e18", "9223372036854775807"),
+    createTest ("-9.223372036854775807e18", "-9223372036854775807"),
+    createTest ("922337203685477580.799e1", "9223372036854775807.99"),
+    createTest ("-922337203685477580.799e1", "-9223372036854775807.99"),
+    createTest ("1844674407370955161e-1", "184467440737095516.1")
+};
+
+} // namespace test
+} // namespace fixed
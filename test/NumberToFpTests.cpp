@@ -26,6 +26,7 @@
 #include "fixed/Number.h"
 #include "TestsCommon.h"
 
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <vector>
@@ -95,6 +96,61 @@ constexpr Test createTest (
     );
 }
 
+//
+// The conversion is expected to be correctly rounded, which strtod () and
+// strtold () are as well, so the results must be identical.
+//
+class ToFpExactTest {
+  public:
+    ToFpExactTest (const std::string& strVal) : strVal_ (strVal) {}
+
+    bool operator() ()
+    {
+        Number n (strVal_);
+
+        if (! valCheck (
+                strtod (strVal_.c_str (), nullptr),
+                n.toDouble (),
+                "toDouble " + strVal_ + " "
+            )
+        )
+        {
+            return false;
+        }
+
+        double batchResult = 0.0;
+
+        Number::toDouble (&n, &batchResult, 1);
+
+        return
+            valCheck (
+                n.toDouble (),
+                batchResult,
+                "batch toDouble " + strVal_ + " "
+            )
+            &&
+            valCheck (
+                strtold (strVal_.c_str (), nullptr),
+                n.toLongDouble (),
+                "toLongDouble " + strVal_ + " "
+            )
+        ;
+    }
+
+  private:
+    std::string strVal_;
+};
+
+static Test createTest (const std::string& strVal)
+{
+    return Test (
+        ToFpExactTest (strVal),
+        [=] () {
+            return std::string ("To floating point exact test: ") + strVal;
+        }
+    );
+}
+
 std::vector<Test> NumberToFpTestVec = {
   {
     createTest ("1.23456", 1.23456, 0.00000001),
@@ -112,7 +168,28 @@ std::vector<Test> NumberToFpTestVec = {
         "-234092342341.2234233456",
         -234092342341.2234233456L,
         0.0000000000001L
-    )
+    ),
+
+    createTest ("0"),
+    createTest ("0.00"),
+    createTest ("0.1"),
+    createTest ("-0.1"),
+    createTest ("0.3"),
+    createTest ("1.23456"),
+    createTest ("0.00000000000001"),
+    createTest ("-0.00000000000001"),
+    createTest ("9007199254740993"),
+    createTest ("9007199254740995"),
+    createTest ("9007199254740993.00000000000001"),
+    createTest ("90071992.54740993"),
+    createTest ("1234567890.12345678901234"),
+    createTest ("-1234567890.12345678901234"),
+    createTest ("9223372036854775807"),
+    createTest ("9223372036854775807.99999999999999"),
+    createTest ("-9223372036854775807.99999999999999"),
+    createTest ("18446744073709551.61599999999999"),
+    createTest ("4503599627370496.5"),
+    createTest ("4503599627370497.5")
 
   }
 };
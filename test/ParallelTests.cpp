@@ -0,0 +1,379 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Parallel.h"
+#include "fixed/Reductions.h"
+#include "TestsCommon.h"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static const unsigned int POOL_SIZES [] = {1, 2, 3, 8};
+
+static const size_t COUNTS [] = {
+    0, 1, 100, parallel::CHUNK_SIZE, 7 * parallel::CHUNK_SIZE + 13
+};
+
+static std::vector<Number> randomNumbers (const size_t count, const int seed)
+{
+    std::mt19937_64 generator (seed);
+
+    std::vector<Number> numbers;
+
+    numbers.reserve (count);
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        numbers.push_back (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >> (42 + generator () % 20),
+                generator () % 9
+            )
+        );
+    }
+
+    return numbers;
+}
+
+//
+// Each chunk is run exactly once whatever the pool size.
+//
+static bool threadPoolTest ()
+{
+    const size_t chunks = 10007;
+
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        std::unique_ptr<std::atomic<unsigned int> []> runs (
+            new std::atomic<unsigned int> [chunks]
+        );
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            runs [chunk] = 0;
+        }
+
+        for (unsigned int job = 0; job < 3; ++job)
+        {
+            pool.run (chunks, [&runs] (const size_t chunk) { ++runs [chunk]; });
+        }
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            if (runs [chunk] != 3)
+            {
+                std::cerr << "ThreadPool ran chunk " << chunk << " "
+                          << runs [chunk] << " times with " << threads
+                          << " threads" << std::endl;
+
+                return false;
+            }
+        }
+    }
+
+    try {
+        ThreadPool pool (0);
+
+        std::cerr << "ThreadPool expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    return ThreadPool::shared ().threads () > 0;
+}
+
+//
+// The sums are the same as the serial ones whatever the pool size.
+//
+static bool reduceTest ()
+{
+    for (const auto count: COUNTS)
+    {
+        const std::vector<Number> numbers (randomNumbers (count, 61));
+        const std::vector<Number> others (randomNumbers (count, 67));
+
+        const Number expected = Reductions::sum (numbers.data (), count);
+
+        Number squares (0);
+        Number products (0);
+
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            squares += numbers [idx] * numbers [idx];
+            products += numbers [idx] * others [idx];
+        }
+
+        for (const auto threads: POOL_SIZES)
+        {
+            ThreadPool pool (threads);
+
+            const std::string description =
+                std::to_string (count) + " Numbers on " +
+                std::to_string (threads) + " threads";
+
+            if (! checkResult (
+                    parallel::reduce (numbers.data (), count, pool),
+                    expected.toString (),
+                    "reduce () of " + description
+                ) ||
+                ! checkResult (
+                    parallel::transform_reduce (
+                        numbers.data (),
+                        count,
+                        [] (const Number& number) { return number * number; },
+                        pool
+                    ),
+                    squares.toString (),
+                    "transform_reduce () of " + description
+                ) ||
+                ! checkResult (
+                    parallel::transform_reduce (
+                        numbers.data (), others.data (), count, pool
+                    ),
+                    products.toString (),
+                    "Inner product of " + description
+                ))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//
+// Chunk totals well out of range, and the total back in range, or not.
+//
+static bool reduceOverflowTest ()
+{
+    const Number max ("9223372036854775807.99999999999999");
+
+    std::vector<Number> numbers (4 * parallel::CHUNK_SIZE, max);
+
+    for (size_t idx = 2 * parallel::CHUNK_SIZE; idx < numbers.size (); ++idx)
+    {
+        numbers [idx] = -max;
+    }
+
+    numbers.push_back (Number ("1.5"));
+
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        if (! checkResult (
+                parallel::reduce (numbers.data (), numbers.size (), pool),
+                "1.50000000000000",
+                "Intermediate overflow reduce ()"
+            ))
+        {
+            return false;
+        }
+
+        try {
+            parallel::reduce (numbers.data (), numbers.size () / 2, pool);
+
+            std::cerr << "parallel::reduce expected exception" << std::endl;
+
+            return false;
+        }
+        catch (const fixed::OverflowException&)
+        {
+        }
+    }
+
+    return true;
+}
+
+static bool transformTest ()
+{
+    const size_t count = 5 * parallel::CHUNK_SIZE + 1;
+
+    const std::vector<Number> numbers (randomNumbers (count, 71));
+
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        std::vector<Number> result (count);
+
+        parallel::transform (
+            numbers.data (),
+            count,
+            result.data (),
+            [] (const Number& number) { return -number * Number (2); },
+            pool
+        );
+
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            if (! checkResult (
+                    result [idx],
+                    (-numbers [idx] * Number (2)).toString (),
+                    "transform () on " + std::to_string (threads) + " threads"
+                ))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//
+// An exception from the operation comes back to the caller, and the pool
+// can still be used afterwards.
+//
+static bool exceptionTest ()
+{
+    const size_t count = 9 * parallel::CHUNK_SIZE;
+
+    const std::vector<Number> numbers (count, Number (1));
+
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        try {
+            parallel::transform_reduce (
+                numbers.data (),
+                count,
+                [&numbers] (const Number& number) {
+                    if (&number == &numbers [count / 2])
+                    {
+                        throw std::runtime_error ("Bad number");
+                    }
+
+                    return number;
+                },
+                pool
+            );
+
+            std::cerr << "transform_reduce expected exception" << std::endl;
+
+            return false;
+        }
+        catch (const std::runtime_error& error)
+        {
+            if (std::string (error.what ()) != "Bad number")
+            {
+                std::cerr << "Unexpected exception " << error.what ()
+                          << std::endl;
+
+                return false;
+            }
+        }
+
+        if (! checkResult (
+                parallel::reduce (numbers.data (), count, pool),
+                Number (static_cast<int64_t> (count)).toString (),
+                "reduce () after exception"
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// A parallel call from inside a task on the same pool runs on the task's
+// thread rather than waiting on the pool, the shared pool included.
+//
+static bool nestedTest ()
+{
+    const size_t count = 5 * parallel::CHUNK_SIZE + 7;
+    const size_t jobs = 16;
+
+    const std::vector<Number> numbers (count, Number (1));
+    const Number expected (static_cast<int64_t> (count));
+
+    for (const auto threads: POOL_SIZES)
+    {
+        ThreadPool pool (threads);
+
+        std::vector<Number> results (jobs);
+
+        pool.run (jobs, [&] (const size_t job) {
+            results [job] = parallel::reduce (numbers.data (), count, pool);
+        });
+
+        for (const auto& result: results)
+        {
+            if (! checkResult (
+                    result, expected.toString (), "nested reduce ()"
+                ))
+            {
+                return false;
+            }
+        }
+    }
+
+    std::vector<Number> results (jobs);
+
+    ThreadPool::shared ().run (jobs, [&] (const size_t job) {
+        results [job] = parallel::reduce (numbers.data (), count);
+    });
+
+    for (const auto& result: results)
+    {
+        if (! checkResult (
+                result, expected.toString (), "nested shared reduce ()"
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<Test> ParallelTestVec = {
+    {threadPoolTest, TestName ("Thread pool chunks")},
+    {reduceTest, TestName ("Parallel reduce")},
+    {reduceOverflowTest, TestName ("Parallel reduce intermediate overflow")},
+    {transformTest, TestName ("Parallel transform")},
+    {exceptionTest, TestName ("Parallel exceptions")},
+    {nestedTest, TestName ("Parallel nested in a pool task")}
+};
+
+} // namespace test
+} // namespace fixed
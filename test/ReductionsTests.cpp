@@ -0,0 +1,422 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Reductions.h"
+#include "TestsCommon.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static std::vector<Number> makeNumbers (const std::vector<std::string>& strs)
+{
+    std::vector<Number> numbers;
+
+    for (const auto& str: strs)
+    {
+        numbers.push_back (Number (str));
+    }
+
+    return numbers;
+}
+
+//
+// Random values at the given decimal places, small enough that a scalar
+// sum of them doesn't overflow, plus some wide ones when wide is set.
+//
+static std::vector<Number> makeRandomNumbers (
+    const unsigned int decimalPlaces,
+    const bool wide
+)
+{
+    std::mt19937_64 generator (decimalPlaces);
+
+    std::vector<Number> numbers;
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        numbers.push_back (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >>
+                    (10 + generator () % 54),
+                decimalPlaces
+            )
+        );
+    }
+
+    if (wide)
+    {
+        numbers [3] = Number ("92233720368547758.08");
+        numbers [500] = Number ("-92233720368547758.09");
+        numbers [999] = Number ("123456789012345678.9");
+    }
+
+    return numbers;
+}
+
+static Number scalarSum (const std::vector<Number>& numbers)
+{
+    Number total (0);
+
+    for (const auto& number: numbers)
+    {
+        total += number;
+    }
+
+    return total;
+}
+
+//
+// The column reductions are checked against the column's own values, which
+// have been brought to its decimal places.
+//
+static bool checkAgainstScalar (
+    const std::string& name,
+    const std::vector<Number>& numbers,
+    const unsigned int decimalPlaces
+)
+{
+    const NumberColumn column (numbers, decimalPlaces);
+    const std::vector<Number> scaled = column.toNumbers ();
+
+    const size_t expectedNonZero = std::count_if (
+        numbers.begin (),
+        numbers.end (),
+        [] (const Number& n) { return n != Number (0); }
+    );
+
+    return
+        checkNumber (
+            name + " column sum", Reductions::sum (column), scalarSum (scaled)
+        )
+        &&
+        checkNumber (
+            name + " array sum",
+            Reductions::sum (numbers.data (), numbers.size ()),
+            scalarSum (numbers)
+        )
+        &&
+        checkNumber (
+            name + " column min",
+            Reductions::min (column),
+            *std::min_element (scaled.begin (), scaled.end ())
+        )
+        &&
+        checkNumber (
+            name + " column max",
+            Reductions::max (column),
+            *std::max_element (scaled.begin (), scaled.end ())
+        )
+        &&
+        checkNumber (
+            name + " array min",
+            Reductions::min (numbers.data (), numbers.size ()),
+            *std::min_element (numbers.begin (), numbers.end ())
+        )
+        &&
+        valCheck (
+            expectedNonZero,
+            Reductions::countNonZero (column),
+            name + " column countNonZero "
+        )
+        &&
+        valCheck (
+            expectedNonZero,
+            Reductions::countNonZero (numbers.data (), numbers.size ()),
+            name + " array countNonZero "
+        );
+}
+
+static bool sumTest ()
+{
+    return
+        checkAgainstScalar ("dp 0", makeRandomNumbers (0, false), 0) &&
+        checkAgainstScalar ("dp 2", makeRandomNumbers (2, true), 2) &&
+        checkAgainstScalar ("dp 14", makeRandomNumbers (14, true), 14) &&
+        checkAgainstScalar (
+            "mixed",
+            makeNumbers ({"1.5", "-0.25", "100", "0", "0.00000000000001"}),
+            14
+        );
+}
+
+class MeanTest {
+  public:
+    MeanTest (
+        const std::vector<std::string>& strs,
+        const unsigned int decimalPlaces,
+        const Rounding::Mode roundingMode,
+        const std::string& expected
+    )
+      : strs_ (strs),
+        decimalPlaces_ (decimalPlaces),
+        roundingMode_ (roundingMode),
+        expected_ (expected)
+    {}
+
+    bool operator() ()
+    {
+        const auto numbers = makeNumbers (strs_);
+        const NumberColumn column (numbers, decimalPlaces_, roundingMode_);
+
+        const std::string name =
+            "mean " + Rounding::modeToString (roundingMode_);
+
+        return
+            checkNumber (
+                name + " column",
+                Reductions::mean (column),
+                Number (expected_)
+            )
+            &&
+            checkNumber (
+                name + " array",
+                Reductions::mean (
+                    numbers.data (), numbers.size (), roundingMode_
+                ),
+                Number (expected_)
+            );
+    }
+
+  private:
+    const std::vector<std::string> strs_;
+    const unsigned int decimalPlaces_;
+    const Rounding::Mode roundingMode_;
+    const std::string expected_;
+};
+
+static Test createMeanTest (
+    const std::vector<std::string>& strs,
+    const unsigned int decimalPlaces,
+    const Rounding::Mode roundingMode,
+    const std::string& expected
+)
+{
+    return Test (
+        MeanTest (strs, decimalPlaces, roundingMode, expected),
+        [=] () {
+            return "Mean " + Rounding::modeToString (roundingMode) +
+                   " expected " + expected;
+        }
+    );
+}
+
+//
+// The sum only has to be in range at the end, not part way through.
+//
+static bool intermediateOverflowTest ()
+{
+    const auto numbers = makeNumbers ({
+        "9223372036854775807.99999999999999",
+        "9223372036854775807.99999999999999",
+        "-9223372036854775807.99999999999999"
+    });
+
+    const NumberColumn column (numbers, 14);
+
+    return
+        checkNumber (
+            "intermediate column sum",
+            Reductions::sum (column),
+            numbers [0]
+        )
+        &&
+        checkNumber (
+            "intermediate array sum",
+            Reductions::sum (numbers.data (), numbers.size ()),
+            numbers [0]
+        );
+}
+
+static bool overflowTest ()
+{
+    const auto numbers = makeNumbers ({"9223372036854775807", "1"});
+    const NumberColumn column (numbers, 0);
+
+    try {
+        Reductions::sum (column);
+
+        std::cerr << "Reductions::sum expected overflow" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+
+    try {
+        Reductions::sum (numbers.data (), numbers.size ());
+
+        std::cerr << "Reductions::sum expected overflow" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::OverflowException&)
+    {
+    }
+
+    return true;
+}
+
+//
+// Columns with no 64 bit values at all, so the min and max come from the
+// wide values alone.
+//
+static bool allWideTest ()
+{
+    const auto positive = makeNumbers ({"100000", "200000"});
+    const auto negative = makeNumbers ({"-100000", "-200000"});
+
+    const NumberColumn positiveColumn (positive, 14);
+    const NumberColumn negativeColumn (negative, 14);
+
+    if (positiveColumn.wideCount () != positive.size () ||
+        negativeColumn.wideCount () != negative.size ())
+    {
+        std::cerr << "All wide columns not wide" << std::endl;
+
+        return false;
+    }
+
+    return
+        checkNumber (
+            "all wide positive min",
+            Reductions::min (positiveColumn),
+            Number ("100000.00000000000000")
+        )
+        &&
+        checkNumber (
+            "all wide positive max",
+            Reductions::max (positiveColumn),
+            Number ("200000.00000000000000")
+        )
+        &&
+        checkNumber (
+            "all wide negative min",
+            Reductions::min (negativeColumn),
+            Number ("-200000.00000000000000")
+        )
+        &&
+        checkNumber (
+            "all wide negative max",
+            Reductions::max (negativeColumn),
+            Number ("-100000.00000000000000")
+        );
+}
+
+static bool emptyTest ()
+{
+    const NumberColumn column (3);
+
+    if (! checkNumber ("empty sum", Reductions::sum (column), Number ("0.000")))
+    {
+        return false;
+    }
+
+    const std::vector<std::function<void ()>> throwing = {
+        [&] () { Reductions::min (column); },
+        [&] () { Reductions::max (column); },
+        [&] () { Reductions::mean (column); },
+        [&] () { Reductions::min (nullptr, 0); },
+        [&] () { Reductions::max (nullptr, 0); },
+        [&] () {
+            Reductions::mean (nullptr, 0, Rounding::Mode::TO_NEAREST_HALF_UP);
+        }
+    };
+
+    for (const auto& func: throwing)
+    {
+        try {
+            func ();
+
+            std::cerr << "Empty reduction expected exception" << std::endl;
+
+            return false;
+        }
+        catch (const fixed::BadValueException&)
+        {
+        }
+    }
+
+    return true;
+}
+
+std::vector<Test> ReductionsTestVec = {
+    {sumTest, TestName ("Reductions against scalar")},
+    {intermediateOverflowTest, TestName ("Reductions intermediate overflow")},
+    {overflowTest, TestName ("Reductions overflow")},
+    {allWideTest, TestName ("Reductions all wide")},
+    {emptyTest, TestName ("Reductions empty")},
+    createMeanTest (
+        {"1", "2"}, 0, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN, "2"
+    ),
+    createMeanTest (
+        {"2", "3"}, 0, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN, "2"
+    ),
+    createMeanTest (
+        {"1", "2", "2"}, 0, Rounding::Mode::TO_NEAREST_HALF_DOWN, "2"
+    ),
+    createMeanTest ({"1", "2", "2"}, 0, Rounding::Mode::DOWN, "1"),
+    createMeanTest ({"-1", "-2"}, 0, Rounding::Mode::TOWARDS_ZERO, "-1"),
+    createMeanTest ({"-1", "-2"}, 0, Rounding::Mode::DOWN, "-2"),
+    createMeanTest ({"-1", "-2"}, 0, Rounding::Mode::UP, "-1"),
+    createMeanTest (
+        {"-1", "-2"}, 0, Rounding::Mode::TO_NEAREST_HALF_UP, "-1"
+    ),
+    createMeanTest (
+        {"-1", "-2"}, 0, Rounding::Mode::TO_NEAREST_HALF_AWAY_FROM_ZERO, "-2"
+    ),
+    createMeanTest (
+        {"-0.01", "-0.02", "0.02"}, 2, Rounding::Mode::AWAY_FROM_ZERO, "-0.01"
+    ),
+    createMeanTest (
+        {"1.00", "2.01"}, 2, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN, "1.50"
+    ),
+    createMeanTest (
+        {"1.00", "2.01"}, 2, Rounding::Mode::TO_NEAREST_HALF_UP, "1.51"
+    ),
+    createMeanTest (
+        {"1.1", "2.22", "3.333"},
+        3,
+        Rounding::Mode::TO_NEAREST_HALF_TO_EVEN,
+        "2.218"
+    ),
+    createMeanTest (
+        {"9223372036854775807.99999999999999",
+         "9223372036854775807.99999999999999"},
+        14,
+        Rounding::Mode::TO_NEAREST_HALF_TO_EVEN,
+        "9223372036854775807.99999999999999"
+    )
+};
+
+} // namespace test
+} // namespace fixed
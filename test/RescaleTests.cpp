@@ -0,0 +1,232 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ColumnOps.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+//
+// Random values at decimalPlaces, with plenty that end in exact halves so
+// the rounding modes differ, and values around the 64 bit limits.
+//
+static std::vector<Number> makeValues (const unsigned int decimalPlaces)
+{
+    std::mt19937_64 generator (decimalPlaces + 100);
+
+    const __int128_t int64Max = std::numeric_limits<int64_t>::max ();
+
+    std::vector<__int128_t> scaled = {
+        0, 1, -1, 5, -5, 15, -15, 25, -25, 50, -50, 150, -150, 250, -250,
+        int64Max, -int64Max, int64Max + 1, -int64Max - 1, int64Max * 7,
+        -int64Max * 9, int64Max / 10, -int64Max / 10, int64Max / 10 + 1,
+        -int64Max / 10 - 1
+    };
+
+    for (unsigned int i = 0; i < 300; ++i)
+    {
+        const int64_t value =
+            static_cast<int64_t> (generator ()) >> (generator () % 64);
+
+        scaled.push_back (value);
+
+        int64_t half = 5;
+
+        for (unsigned int digits = generator () % 15; digits; --digits)
+        {
+            half *= 10;
+        }
+
+        scaled.push_back (
+            static_cast<__int128_t> (value / (2 * half)) * (2 * half) + half
+        );
+    }
+
+    std::vector<Number> values;
+
+    for (const auto& value: scaled)
+    {
+        try {
+            values.push_back (Number::fromScaledValue (value, decimalPlaces));
+        }
+        catch (const fixed::BadValueException&)
+        {
+        }
+    }
+
+    return values;
+}
+
+static const std::vector<Rounding::Mode> modes = {
+    Rounding::Mode::DOWN,
+    Rounding::Mode::UP,
+    Rounding::Mode::TOWARDS_ZERO,
+    Rounding::Mode::AWAY_FROM_ZERO,
+    Rounding::Mode::TO_NEAREST_HALF_UP,
+    Rounding::Mode::TO_NEAREST_HALF_DOWN,
+    Rounding::Mode::TO_NEAREST_HALF_AWAY_FROM_ZERO,
+    Rounding::Mode::TO_NEAREST_HALF_TOWARDS_ZERO,
+    Rounding::Mode::TO_NEAREST_HALF_TO_EVEN,
+    Rounding::Mode::TO_NEAREST_HALF_TO_ODD
+};
+
+//
+// Checks the batch rescales against setDecimalPlaces () on each Number.
+//
+class RescaleTest {
+  public:
+    RescaleTest (const unsigned int fromDp)
+      : fromDp_ (fromDp)
+    {}
+
+    bool operator() ()
+    {
+        const auto values = makeValues (fromDp_);
+        const NumberColumn column (values, fromDp_);
+
+        for (unsigned int toDp = 0; toDp <= Number::MAX_DECIMAL_PLACES; ++toDp)
+        {
+            for (const auto mode: modes)
+            {
+                const std::string hdr =
+                    "rescale " + std::to_string (fromDp_) + " to " +
+                    std::to_string (toDp) + " " +
+                    Rounding::modeToString (mode);
+
+                std::vector<Number> expected;
+
+                for (const auto& value: values)
+                {
+                    Number number (value);
+
+                    number.setRoundingMode (mode);
+                    number.setDecimalPlaces (toDp);
+
+                    expected.push_back (number);
+                }
+
+                const NumberColumn rescaled =
+                    ColumnOps::rescale (column, toDp, mode);
+
+                std::vector<Number> batch (values);
+
+                Number::setDecimalPlaces (
+                    batch.data (), batch.size (), toDp, mode
+                );
+
+                if (! valCheck (
+                        toDp, rescaled.decimalPlaces (), hdr + " column dp "
+                    ))
+                {
+                    return false;
+                }
+
+                for (size_t idx = 0; idx < values.size (); ++idx)
+                {
+                    const std::string elemHdr =
+                        hdr + " [" + std::to_string (idx) + "]";
+
+                    if (! checkNumber (
+                            elemHdr + " column", rescaled [idx], expected [idx]
+                        ) ||
+                        ! checkNumber (
+                            elemHdr + " batch", batch [idx], expected [idx]
+                        ) ||
+                        ! valCheck (
+                            values [idx].roundingMode () ==
+                                batch [idx].roundingMode (),
+                            true,
+                            elemHdr + " batch roundingMode "
+                        ))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+  private:
+    unsigned int fromDp_;
+};
+
+static bool badValueTest ()
+{
+    const NumberColumn column ({Number ("1.5")}, 1);
+    Number number ("1.5");
+
+    try {
+        ColumnOps::rescale (column, Number::MAX_DECIMAL_PLACES + 1);
+
+        std::cerr << "ColumnOps::rescale expected exception" << std::endl;
+
+        return false;
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    try {
+        Number::setDecimalPlaces (
+            &number,
+            1,
+            Number::MAX_DECIMAL_PLACES + 1,
+            Rounding::Mode::UP
+        );
+
+        std::cerr << "Number::setDecimalPlaces expected exception"
+                  << std::endl;
+
+        return false;
+    }
+    catch (const fixed::BadValueException&)
+    {
+    }
+
+    return checkNumber ("unchanged", number, Number ("1.5"));
+}
+
+std::vector<Test> RescaleTestVec = {
+    {RescaleTest (0), TestName ("Rescale from 0 dp")},
+    {RescaleTest (1), TestName ("Rescale from 1 dp")},
+    {RescaleTest (2), TestName ("Rescale from 2 dp")},
+    {RescaleTest (5), TestName ("Rescale from 5 dp")},
+    {RescaleTest (8), TestName ("Rescale from 8 dp")},
+    {RescaleTest (13), TestName ("Rescale from 13 dp")},
+    {RescaleTest (14), TestName ("Rescale from 14 dp")},
+    {badValueTest, TestName ("Rescale bad values")}
+};
+
+} // namespace test
+} // namespace fixed
@@ -0,0 +1,351 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/RollingWindow.h"
+#include "Ratio.h"
+#include "TestsCommon.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static bool checkWindow (
+    const RollingWindow& window,
+    const std::string& sum,
+    const std::string& min,
+    const std::string& max,
+    const std::string& description
+)
+{
+    return
+        checkResult (window.sum (), sum, description + " sum") &&
+        checkResult (window.min (), min, description + " min") &&
+        checkResult (window.max (), max, description + " max");
+}
+
+static bool countWindowTest ()
+{
+    RollingWindow window (3, 2);
+
+    if (window.capacity () != 3 || ! window.isEmpty () ||
+        ! checkResult (window.sum (), "0.00", "Empty sum") ||
+        ! expectException<fixed::BadValueException> (
+            [&window] () { window.min (); }, "Empty min"
+        ) ||
+        ! expectException<fixed::BadValueException> (
+            [&window] () { window.mean (Rounding::Mode::DOWN); }, "Empty mean"
+        ))
+    {
+        return false;
+    }
+
+    window.add (Number (1));
+    window.add (Number (3));
+    window.add (Number (2));
+
+    if (! checkWindow (window, "6.00", "1.00", "3.00", "Full window") ||
+        ! checkResult (
+            window.mean (Rounding::Mode::DOWN), "2.00", "Full window mean"
+        ))
+    {
+        return false;
+    }
+
+    window.add (Number ("0.5"));
+
+    if (window.size () != 3 ||
+        ! checkWindow (window, "5.50", "0.50", "3.00", "Slid once"))
+    {
+        return false;
+    }
+
+    window.add (Number (4));
+
+    if (! checkWindow (window, "6.50", "0.50", "4.00", "Slid twice") ||
+        ! checkResult (
+            window.mean (Rounding::Mode::TO_NEAREST_HALF_UP),
+            "2.17",
+            "Slid twice mean"
+        ) ||
+        ! checkResult (
+            window.mean (4, Rounding::Mode::DOWN),
+            "2.1666",
+            "Slid twice widened mean"
+        ))
+    {
+        return false;
+    }
+
+    window.clear ();
+
+    return window.isEmpty () && checkResult (window.sum (), "0.00", "Cleared");
+}
+
+//
+// Random values at mixed decimal places against a brute force over the
+// last values added, with a capacity that isn't a power of 2.
+//
+static bool randomCountWindowTest ()
+{
+    const size_t count = 37;
+
+    std::mt19937_64 generator (43);
+    std::uniform_int_distribution<int64_t> values (-1000000, 1000000);
+
+    RollingWindow window (count, 4);
+    std::vector<Number> added;
+
+    for (unsigned int i = 0; i < 2000; ++i)
+    {
+        const Number value (
+            Number::fromScaledValue (values (generator), generator () % 5)
+        );
+
+        window.add (value);
+        added.push_back (value);
+
+        const size_t first = added.size () > count ? added.size () - count : 0;
+
+        Number sum (0);
+
+        for (size_t idx = first; idx < added.size (); ++idx)
+        {
+            sum += added [idx];
+        }
+
+        Number min (*std::min_element (added.begin () + first, added.end ()));
+        Number max (*std::max_element (added.begin () + first, added.end ()));
+
+        sum.setDecimalPlaces (4);
+        min.setDecimalPlaces (4);
+        max.setDecimalPlaces (4);
+
+        if (window.size () != added.size () - first ||
+            ! checkWindow (
+                window,
+                sum.toString (),
+                min.toString (),
+                max.toString (),
+                "Random window"
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool timeWindowTest ()
+{
+    RollingWindow window (100, 10, 0);
+
+    window.add (Number (1), 0);
+    window.add (Number (2), 5);
+    window.add (Number (3), 9);
+
+    if (! checkWindow (window, "6", "1", "3", "Time window"))
+    {
+        return false;
+    }
+
+    window.add (Number (4), 10);
+
+    if (window.size () != 3 ||
+        ! checkWindow (window, "9", "2", "4", "Time window slid"))
+    {
+        return false;
+    }
+
+    window.advance (19);
+
+    if (window.size () != 1 ||
+        ! checkWindow (window, "4", "4", "4", "Time window advanced"))
+    {
+        return false;
+    }
+
+    if (! expectException<fixed::BadValueException> (
+            [&window] () { window.add (Number (5), 18); }, "Going backwards"
+        ) ||
+        ! expectException<fixed::BadValueException> (
+            [&window] () { window.advance (18); }, "Advancing backwards"
+        ))
+    {
+        return false;
+    }
+
+    window.advance (20);
+
+    if (! window.isEmpty () ||
+        ! checkResult (window.sum (), "0", "Time window emptied"))
+    {
+        return false;
+    }
+
+    //
+    // Never more than capacity values, whatever the timestamps.
+    //
+    RollingWindow small (2, 1000, 1);
+
+    small.add (Number (7), 1);
+    small.add (Number (5), 1);
+    small.add (Number (6), 1);
+
+    return
+        small.size () == 2 &&
+        checkWindow (small, "11.0", "5.0", "6.0", "Capacity bound");
+}
+
+static bool roundingTest ()
+{
+    RollingWindow halfUp (4, 1, Rounding::Mode::TO_NEAREST_HALF_UP);
+    RollingWindow down (4, 1, Rounding::Mode::DOWN);
+
+    for (const char* value: {"1.25", "-1.25", "0.04"})
+    {
+        halfUp.add (Number (value));
+        down.add (Number (value));
+    }
+
+    return
+        checkWindow (halfUp, "0.1", "-1.2", "1.3", "Half up window") &&
+        checkWindow (down, "-0.1", "-1.3", "1.2", "Down window");
+}
+
+//
+// Values are rescaled with the window's rounding mode, which must give the
+// same as setDecimalPlaces () with the Number's own mode set to it.
+//
+static bool rescaleTest ()
+{
+    const char* values [] = {
+        "1.25", "-1.25", "0.05", "-0.15", "123456789.987654321", "-7"
+    };
+
+    for (const char* value: values)
+    {
+        for (const auto mode: ROUNDING_MODES)
+        {
+            for (unsigned int dp = 0; dp <= Number::MAX_DECIMAL_PLACES; ++dp)
+            {
+                Number expected (value);
+
+                expected.setRoundingMode (mode);
+                expected.setDecimalPlaces (dp);
+
+                if (! checkResult (
+                        Number::fromScaledValue (
+                            Ratio::rescale (Number (value), dp, mode), dp
+                        ),
+                        expected.toString (),
+                        "Rescale"
+                    ))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool limitsTest ()
+{
+    const Number max ("9223372036854775807");
+
+    RollingWindow window (2, 0);
+
+    window.add (max);
+    window.add (max);
+
+    if (! expectException<fixed::OverflowException> (
+            [&window] () { window.sum (); }, "Sum overflow"
+        ) ||
+        ! checkResult (
+            window.mean (Rounding::Mode::DOWN), max.toString (), "Max mean"
+        ))
+    {
+        return false;
+    }
+
+    window.add (-max);
+
+    if (! checkWindow (window, "0", "-" + max.toString (), max.toString (),
+                       "Back in range"))
+    {
+        return false;
+    }
+
+    //
+    // 2^17 of the largest Numbers take the sum past 128 bits.
+    //
+    const Number largest ("-9223372036854775807.99999999999999");
+    const size_t count = 300000;
+
+    RollingWindow wide (count, Number::MAX_DECIMAL_PLACES);
+
+    for (size_t i = 0; i < count + 10; ++i)
+    {
+        wide.add (largest);
+    }
+
+    return
+        checkResult (
+            wide.mean (Rounding::Mode::DOWN), largest.toString (), "Wide mean"
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&wide] () { wide.sum (); }, "Wide sum"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { RollingWindow (0, 2); }, "Zero count"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { RollingWindow (10, 0, 2); }, "Zero span"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [] () { RollingWindow (10, Number::MAX_DECIMAL_PLACES + 1); },
+            "Decimal places"
+        );
+}
+
+std::vector<Test> RollingWindowTestVec = {
+    {countWindowTest, TestName ("Rolling window by count")},
+    {randomCountWindowTest, TestName ("Rolling window random values")},
+    {timeWindowTest, TestName ("Rolling window by time")},
+    {roundingTest, TestName ("Rolling window rounding")},
+    {rescaleTest, TestName ("Rolling window rescale")},
+    {limitsTest, TestName ("Rolling window limits")}
+};
+
+} // namespace test
+} // namespace fixed
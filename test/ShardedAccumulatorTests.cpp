@@ -0,0 +1,195 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/ShardedAccumulator.h"
+#include "TestsCommon.h"
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static const unsigned int THREAD_COUNT = 8;
+
+static const unsigned int ADDS_PER_THREAD = 20000;
+
+//
+// The values thread adds, positive at mixed decimal places.
+//
+static std::vector<Number> threadValues (const unsigned int thread)
+{
+    std::mt19937_64 generator (thread);
+
+    std::vector<Number> values;
+
+    for (unsigned int i = 0; i < ADDS_PER_THREAD; ++i)
+    {
+        values.push_back (
+            Number::fromScaledValue (
+                generator () >> (20 + generator () % 44),
+                generator () % (Number::MAX_DECIMAL_PLACES + 1)
+            )
+        );
+    }
+
+    return values;
+}
+
+static bool singleThreadShardedTest ()
+{
+    ShardedAccumulator sharded;
+    Accumulator expected;
+
+    if (! sharded.total ().isZero () || sharded.shardCount () != 0)
+    {
+        std::cerr << "ShardedAccumulator not empty" << std::endl;
+
+        return false;
+    }
+
+    for (const auto& value: threadValues (0))
+    {
+        sharded.add (value);
+        sharded.sub (Number ("0.5"));
+        expected.add (value);
+        expected.sub (Number ("0.5"));
+    }
+
+    return
+        sharded.shardCount () == 1 &&
+        sharded.snapshot ().toString () == expected.toNumber ().toString ();
+}
+
+//
+// Threads adding at once give the exact total, and snapshots taken while
+// they add never go backwards, as every value added is positive.
+//
+static bool concurrentShardedTest ()
+{
+    ShardedAccumulator sharded;
+
+    std::vector<std::vector<Number>> values;
+    Accumulator expected;
+
+    for (unsigned int thread = 0; thread < THREAD_COUNT; ++thread)
+    {
+        values.push_back (threadValues (thread));
+
+        for (const auto& value: values.back ())
+        {
+            expected.add (value);
+        }
+    }
+
+    std::atomic<unsigned int> running (THREAD_COUNT);
+    std::vector<std::thread> threads;
+
+    for (unsigned int thread = 0; thread < THREAD_COUNT; ++thread)
+    {
+        threads.emplace_back ([&, thread] () {
+            for (const auto& value: values [thread])
+            {
+                sharded.add (value);
+            }
+
+            --running;
+        });
+    }
+
+    bool monotonic = true;
+    Number previous (0);
+
+    while (running)
+    {
+        const Number current (sharded.snapshot ());
+
+        if (current < previous)
+        {
+            std::cerr << "Snapshot went from " << previous.toString ()
+                      << " to " << current.toString () << std::endl;
+
+            monotonic = false;
+        }
+
+        previous = current;
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join ();
+    }
+
+    const std::string total = sharded.snapshot ().toString ();
+
+    if (total != expected.toNumber ().toString ())
+    {
+        std::cerr << "Concurrent total " << total << " expected "
+                  << expected.toNumber ().toString () << std::endl;
+
+        return false;
+    }
+
+    return monotonic && sharded.shardCount () == THREAD_COUNT;
+}
+
+//
+// A thread switching between accumulators adds to the right one each time.
+//
+static bool multipleAccumulatorsTest ()
+{
+    ShardedAccumulator first;
+    ShardedAccumulator second;
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        first.add (Number ("1.25"));
+        second.sub (Number ("0.5"));
+    }
+
+    std::thread ([&] () {
+        first.add (Number ("0.01"));
+    }).join ();
+
+    return
+        first.snapshot ().toString () == "1250.01" &&
+        second.snapshot ().toString () == "-500.0" &&
+        first.shardCount () == 2 &&
+        second.shardCount () == 1;
+}
+
+std::vector<Test> ShardedAccumulatorTestVec = {
+    {singleThreadShardedTest, TestName ("ShardedAccumulator single thread")},
+    {concurrentShardedTest, TestName ("ShardedAccumulator concurrent")},
+    {multipleAccumulatorsTest, TestName ("ShardedAccumulator multiple")}
+};
+
+} // namespace test
+} // namespace fixed
@@ -0,0 +1,254 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/Sort.h"
+#include "TestsCommon.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static std::vector<Number> makeNumbers (const std::vector<std::string>& strs)
+{
+    std::vector<Number> numbers;
+
+    for (const auto& str: strs)
+    {
+        numbers.push_back (Number (str));
+    }
+
+    return numbers;
+}
+
+//
+// count random values at random decimal places, shifted right by at least
+// minShift bits to control their spread, plus the extreme values of a
+// Number when extremes is set.
+//
+static std::vector<Number> makeRandomNumbers (
+    const size_t count,
+    const unsigned int minShift,
+    const bool extremes
+)
+{
+    std::mt19937_64 generator (count + minShift);
+
+    std::vector<Number> numbers;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        numbers.push_back (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >>
+                    (minShift + generator () % (64 - minShift)),
+                generator () % (Number::MAX_DECIMAL_PLACES + 1)
+            )
+        );
+    }
+
+    if (extremes)
+    {
+        numbers [count / 3] = Number ("9223372036854775807.99999999999999");
+        numbers [count / 2] = Number ("-9223372036854775807.99999999999999");
+        numbers [count - 1] = Number ("9223372036854775807");
+    }
+
+    return numbers;
+}
+
+//
+// Checks argsort and sort give the same order as a stable sort on
+// operator<.
+//
+static bool checkSorted (
+    const std::vector<Number>& numbers,
+    const std::string& description
+)
+{
+    std::vector<size_t> expected (numbers.size ());
+
+    for (size_t idx = 0; idx < expected.size (); ++idx)
+    {
+        expected [idx] = idx;
+    }
+
+    std::stable_sort (
+        expected.begin (),
+        expected.end (),
+        [&] (const size_t lhs, const size_t rhs) {
+            return numbers [lhs] < numbers [rhs];
+        }
+    );
+
+    if (argsort (numbers) != expected)
+    {
+        std::cerr << "argsort () order wrong for " << description << std::endl;
+
+        return false;
+    }
+
+    std::vector<Number> sorted (numbers);
+
+    sort (sorted);
+
+    for (size_t idx = 0; idx < sorted.size (); ++idx)
+    {
+        if (sorted [idx].toString () != numbers [expected [idx]].toString ())
+        {
+            std::cerr << "sort () order wrong for " << description
+                      << " at " << idx << ", got " << sorted [idx].toString ()
+                      << " expected " << numbers [expected [idx]].toString ()
+                      << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool emptySortTest ()
+{
+    std::vector<Number> numbers;
+
+    sort (numbers);
+
+    return
+        numbers.empty () &&
+        argsort (numbers).empty () &&
+        checkSorted (makeNumbers ({"-3.25"}), "one number");
+}
+
+//
+// Equal values at different decimal places keep their input order.
+//
+static bool stableSortTest ()
+{
+    const std::vector<Number> numbers (
+        makeNumbers ({"1.50", "-2", "1.5", "0.001", "-2.000", "1.5"})
+    );
+
+    const std::vector<size_t> expected = {1, 4, 3, 0, 2, 5};
+
+    if (argsort (numbers) != expected)
+    {
+        std::cerr << "argsort () not stable" << std::endl;
+
+        return false;
+    }
+
+    std::vector<Number> sorted (numbers);
+
+    sort (sorted);
+
+    if (sorted [0].toString () != "-2" ||
+        sorted [1].toString () != "-2.000" ||
+        sorted [3].toString () != "1.50")
+    {
+        std::cerr << "sort () not stable" << std::endl;
+
+        return false;
+    }
+
+    return checkSorted (numbers, "equal values");
+}
+
+//
+// Values close together, so the keys are 64 bit with the high digits the
+// same for every key.
+//
+static bool narrowSortTest ()
+{
+    return
+        checkSorted (makeRandomNumbers (100, 40, false), "100 narrow") &&
+        checkSorted (makeRandomNumbers (5000, 40, false), "5000 narrow");
+}
+
+//
+// Values spread over the whole 64 bit range at mixed decimal places, which
+// need 128 bit keys.
+//
+static bool wideSortTest ()
+{
+    return
+        checkSorted (makeRandomNumbers (100, 1, false), "100 wide") &&
+        checkSorted (makeRandomNumbers (5000, 1, false), "5000 wide") &&
+        checkSorted (makeRandomNumbers (100, 1, true), "100 extremes") &&
+        checkSorted (makeRandomNumbers (5000, 1, true), "5000 extremes");
+}
+
+//
+// Whole numbers spread over exactly 64 bits need only 64 bit keys, one
+// more decimal place takes the spread over 64 bits.
+//
+static bool keyWidthSortTest ()
+{
+    std::mt19937_64 generator (5);
+
+    std::vector<Number> numbers;
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        numbers.push_back (
+            Number::fromScaledValue (
+                static_cast<int64_t> (generator ()) >> 1, 0
+            )
+        );
+    }
+
+    numbers [10] = Number::fromScaledValue (
+        std::numeric_limits<int64_t>::min () + 1, 0
+    );
+    numbers [20] = Number::fromScaledValue (
+        std::numeric_limits<int64_t>::max (), 0
+    );
+
+    if (! checkSorted (numbers, "64 bit spread"))
+    {
+        return false;
+    }
+
+    numbers [30] = Number ("4611686018427387904.5");
+
+    return checkSorted (numbers, "over 64 bit spread");
+}
+
+std::vector<Test> SortTestVec = {
+    {emptySortTest, TestName ("Sort empty")},
+    {stableSortTest, TestName ("Sort stable")},
+    {narrowSortTest, TestName ("Sort narrow values")},
+    {wideSortTest, TestName ("Sort wide values")},
+    {keyWidthSortTest, TestName ("Sort key width")}
+};
+
+} // namespace test
+} // namespace fixed
@@ -0,0 +1,501 @@
+//
+// The MIT License (MIT)
+//
+//
+// Copyright (c) 2013 OANDA Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//
+
+#include "fixed/StreamingStats.h"
+#include "TestsCommon.h"
+
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fixed {
+namespace test {
+
+static const std::string MAX_NUMBER = "9223372036854775807.99999999999999";
+
+//
+// numerator / denominator rounded to an integer, the reference for results
+// small enough to compute with __int128_t.
+//
+static __int128_t referenceRatio (
+    const __int128_t numerator,
+    const __int128_t denominator,
+    const Rounding::Mode roundingMode
+)
+{
+    const __int128_t remainder = numerator % denominator;
+    const __int128_t absDenominator = denominator < 0 ? -denominator :
+                                                        denominator;
+
+    return Rounding::round<__int128_t> (
+        roundingMode,
+        numerator / denominator,
+        2 * (remainder < 0 ? -remainder : remainder),
+        absDenominator,
+        (numerator < 0) != (denominator < 0) && numerator != 0
+    );
+}
+
+static bool int256Test ()
+{
+    const __int128_t max128 = ~(static_cast<__uint128_t> (1) << 127);
+
+    Int256 product (Int256::multiply (max128, -max128));
+    Int256 sum (max128);
+
+    sum += Int256 (1);
+
+    __int128_t value;
+
+    if (! product.isNegative () || product.toInt128 (value) ||
+        sum.toInt128 (value) || ! (product < sum) || ! (Int256 (-1) < 0))
+    {
+        std::cerr << "Int256 sign, range or order wrong" << std::endl;
+
+        return false;
+    }
+
+    //
+    // max128^2 / max128 takes the long division path.
+    //
+    if (Int256::divideRounded (
+            product, Int256 (max128), Rounding::Mode::TOWARDS_ZERO
+        ) != -max128 ||
+        Int256::divideRounded (
+            Int256 (7), Int256 (-2), Rounding::Mode::TO_NEAREST_HALF_TO_EVEN
+        ) != -4 ||
+        Int256::divideRounded (
+            Int256 (-5), Int256 (3), Rounding::Mode::UP
+        ) != -1)
+    {
+        std::cerr << "Int256::divideRounded wrong result" << std::endl;
+
+        return false;
+    }
+
+    Int256 huge (Int256::multiply (max128, max128));
+
+    return
+        expectException<fixed::OverflowException> (
+            [&huge] () { huge *= Int256 (4); }, "Int256::operator*="
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&huge] () { huge += huge; huge += huge; }, "Int256::operator+="
+        ) &&
+        expectException<fixed::OverflowException> (
+            [&product] () {
+                Int256::divideRounded (
+                    product, Int256 (1), Rounding::Mode::DOWN
+                );
+            },
+            "Int256::divideRounded"
+        ) &&
+        expectException<fixed::DivideByZeroException> (
+            [] () {
+                Int256::divideRounded (
+                    Int256 (1), Int256 (), Rounding::Mode::DOWN
+                );
+            },
+            "Int256::divideRounded"
+        );
+}
+
+static bool vwapTest ()
+{
+    Vwap vwap;
+
+    if (! expectException<fixed::BadValueException> (
+            [&vwap] () { vwap.vwap (Rounding::Mode::DOWN); }, "Empty VWAP"
+        ))
+    {
+        return false;
+    }
+
+    vwap.add (Number ("1.10"), Number (100));
+    vwap.add (Number ("1.20"), Number (300));
+
+    if (! checkResult (
+            vwap.vwap (Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "1.18",
+            "VWAP half to even"
+        ) ||
+        ! checkResult (
+            vwap.vwap (Rounding::Mode::TO_NEAREST_HALF_DOWN),
+            "1.17",
+            "VWAP half down"
+        ) ||
+        ! checkResult (
+            vwap.vwap (5, Rounding::Mode::DOWN), "1.17500", "VWAP widened"
+        ) ||
+        ! expectException<fixed::BadValueException> (
+            [&vwap] () {
+                vwap.vwap (Number::MAX_DECIMAL_PLACES + 1, Rounding::Mode::UP);
+            },
+            "VWAP decimal places"
+        ))
+    {
+        return false;
+    }
+
+    vwap.add (Number ("1.3"), Number (-400));
+
+    return expectException<fixed::DivideByZeroException> (
+        [&vwap] () { vwap.vwap (Rounding::Mode::DOWN); }, "Zero quantity"
+    );
+}
+
+static __int128_t power (unsigned int exponent)
+{
+    __int128_t result = 1;
+
+    while (exponent--)
+    {
+        result *= 10;
+    }
+
+    return result;
+}
+
+//
+// Random prices and quantities at mixed decimal places, against a reference
+// computed with __int128_t at 5 + 4 decimal places.
+//
+static bool mixedScaleVwapTest ()
+{
+    std::mt19937_64 generator (29);
+    std::uniform_int_distribution<int64_t> prices (
+        -100000000000LL, 100000000000LL
+    );
+    std::uniform_int_distribution<int64_t> quantities (1, 10000000000LL);
+
+    Vwap vwap;
+
+    __int128_t notional = 0;
+    __int128_t quantity = 0;
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        const Number price (
+            Number::fromScaledValue (prices (generator), generator () % 6)
+        );
+        const Number size (
+            Number::fromScaledValue (quantities (generator), generator () % 5)
+        );
+
+        vwap.add (price, size);
+
+        notional +=
+            price.scaledValue () * power (5 - price.decimalPlaces ()) *
+            size.scaledValue () * power (4 - size.decimalPlaces ());
+        quantity += size.scaledValue () * power (4 - size.decimalPlaces ());
+    }
+
+    for (const auto mode: ROUNDING_MODES)
+    {
+        const __int128_t expected = referenceRatio (
+            notional * power (2), quantity * power (5), mode
+        );
+
+        if (! checkResult (
+                vwap.vwap (2, mode),
+                Number::fromScaledValue (expected, 2).toString (),
+                "Mixed scale VWAP"
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// A single large price, so the notional is well past 128 bits, comes back
+// exactly whatever the quantities.
+//
+static bool wideVwapTest ()
+{
+    const Number price ("9000000000000000000.5");
+
+    std::mt19937_64 generator (31);
+
+    Vwap vwap;
+
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        vwap.add (
+            price,
+            Number::fromScaledValue (
+                1 + generator () % 100000000000000000ULL, 14
+            )
+        );
+    }
+
+    return
+        checkResult (
+            vwap.vwap (Rounding::Mode::TOWARDS_ZERO),
+            price.toString (),
+            "Wide VWAP"
+        ) &&
+        checkResult (
+            vwap.vwap (0, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "9000000000000000000",
+            "Wide VWAP half to even"
+        ) &&
+        checkResult (
+            vwap.vwap (0, Rounding::Mode::TO_NEAREST_HALF_UP),
+            "9000000000000000001",
+            "Wide VWAP half up"
+        ) &&
+        checkResult (
+            vwap.vwap (14, Rounding::Mode::UP),
+            "9000000000000000000.50000000000000",
+            "Wide VWAP widened"
+        );
+}
+
+static bool twapTest ()
+{
+    Twap twap;
+
+    if (! expectException<fixed::BadValueException> (
+            [&twap] () { twap.twap (0, Rounding::Mode::DOWN); }, "Empty TWAP"
+        ))
+    {
+        return false;
+    }
+
+    twap.add (Number ("1.0"), 100);
+
+    if (! checkResult (
+            twap.twap (100, Rounding::Mode::DOWN), "1.0", "Instant TWAP"
+        ))
+    {
+        return false;
+    }
+
+    twap.add (Number (2), 110);
+
+    return
+        checkResult (
+            twap.twap (140, Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "1.8",
+            "TWAP half to even"
+        ) &&
+        checkResult (
+            twap.twap (140, 2, Rounding::Mode::DOWN), "1.75", "TWAP widened"
+        ) &&
+        checkResult (
+            twap.twap (110, 3, Rounding::Mode::DOWN), "1.000", "TWAP at last"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&twap] () { twap.add (Number (3), 109); }, "TWAP going backwards"
+        ) &&
+        expectException<fixed::BadValueException> (
+            [&twap] () { twap.twap (109, Rounding::Mode::DOWN); },
+            "TWAP ending early"
+        ) &&
+        checkResult (
+            twap.twap (130, 2, Rounding::Mode::DOWN), "1.66", "TWAP unchanged"
+        );
+}
+
+static bool runningVarianceTest ()
+{
+    RunningVariance stats;
+
+    if (! expectException<fixed::BadValueException> (
+            [&stats] () { stats.mean (Rounding::Mode::DOWN); }, "Empty mean"
+        ))
+    {
+        return false;
+    }
+
+    for (const int value: {2, 4, 4, 4, 5, 5, 7, 9})
+    {
+        stats.add (Number (value));
+    }
+
+    if (stats.count () != 8 ||
+        ! checkResult (stats.mean (Rounding::Mode::DOWN), "5", "Mean") ||
+        ! checkResult (
+            stats.variance (Rounding::Mode::DOWN), "4", "Variance"
+        ) ||
+        ! checkResult (
+            stats.sampleVariance (4, Rounding::Mode::TO_NEAREST_HALF_UP),
+            "4.5714",
+            "Sample variance"
+        ))
+    {
+        return false;
+    }
+
+    stats.clear ();
+    stats.add (Number ("1.5"));
+
+    if (! expectException<fixed::BadValueException> (
+            [&stats] () { stats.sampleVariance (Rounding::Mode::DOWN); },
+            "Single value sample variance"
+        ))
+    {
+        return false;
+    }
+
+    stats.add (Number ("2.25"));
+
+    return
+        checkResult (
+            stats.mean (Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "1.88",
+            "Mixed scale mean"
+        ) &&
+        checkResult (
+            stats.variance (Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "0.1406",
+            "Mixed scale variance"
+        ) &&
+        checkResult (
+            stats.sampleVariance (Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "0.2812",
+            "Mixed scale sample variance half to even"
+        ) &&
+        checkResult (
+            stats.sampleVariance (Rounding::Mode::TO_NEAREST_HALF_UP),
+            "0.2813",
+            "Mixed scale sample variance half up"
+        );
+}
+
+//
+// Random values against a reference computed with __int128_t, the values
+// kept small enough for the sum of squares to fit.
+//
+static bool mixedScaleVarianceTest ()
+{
+    std::mt19937_64 generator (37);
+    std::uniform_int_distribution<int64_t> values (-1000000000LL, 1000000000LL);
+
+    RunningVariance stats;
+
+    __int128_t sum = 0;
+    __int128_t sumSquares = 0;
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        const Number number (
+            Number::fromScaledValue (values (generator), generator () % 5)
+        );
+
+        stats.add (number);
+
+        const __int128_t value =
+            number.scaledValue () * power (4 - number.decimalPlaces ());
+
+        sum += value;
+        sumSquares += value * value;
+    }
+
+    const __int128_t count = stats.count ();
+
+    for (const auto mode: ROUNDING_MODES)
+    {
+        const __int128_t mean = referenceRatio (sum, count, mode);
+        const __int128_t variance = referenceRatio (
+            count * sumSquares - sum * sum, count * count * power (2), mode
+        );
+
+        if (! checkResult (
+                stats.mean (mode),
+                Number::fromScaledValue (mean, 4).toString (),
+                "Mixed scale mean"
+            ) ||
+            ! checkResult (
+                stats.variance (6, mode),
+                Number::fromScaledValue (variance, 6).toString (),
+                "Mixed scale variance"
+            ))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool wideVarianceTest ()
+{
+    RunningVariance stats;
+
+    stats.add (Number (MAX_NUMBER));
+    stats.add (Number (0));
+
+    if (! checkResult (
+            stats.mean (Rounding::Mode::TO_NEAREST_HALF_TO_EVEN),
+            "4611686018427387904.00000000000000",
+            "Wide mean"
+        ) ||
+        ! expectException<fixed::OverflowException> (
+            [&stats] () { stats.variance (Rounding::Mode::DOWN); },
+            "Wide variance"
+        ))
+    {
+        return false;
+    }
+
+    stats.clear ();
+    stats.add (Number (MAX_NUMBER));
+    stats.add (Number ("9223372036854775806.99999999999999"));
+
+    return
+        checkResult (
+            stats.variance (2, Rounding::Mode::DOWN),
+            "0.25",
+            "Near max variance"
+        ) &&
+        checkResult (
+            stats.variance (0, Rounding::Mode::UP), "1", "Near max round up"
+        ) &&
+        checkResult (
+            stats.sampleVariance (Rounding::Mode::DOWN),
+            "0.50000000000000",
+            "Near max sample variance"
+        );
+}
+
+std::vector<Test> StreamingStatsTestVec = {
+    {int256Test, TestName ("Int256 arithmetic")},
+    {vwapTest, TestName ("VWAP")},
+    {mixedScaleVwapTest, TestName ("VWAP mixed scales")},
+    {wideVwapTest, TestName ("VWAP past 128 bits")},
+    {twapTest, TestName ("TWAP")},
+    {runningVarianceTest, TestName ("Running variance")},
+    {mixedScaleVarianceTest, TestName ("Running variance mixed scales")},
+    {wideVarianceTest, TestName ("Running variance past 128 bits")}
+};
+
+} // namespace test
+} // namespace fixed
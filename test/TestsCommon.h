@@ -27,9 +27,11 @@
 #define FIXED_TESTS_COMMON_H
 
 #include "fixed/Number.h"
+#include "fixed/Rounding.h"
 
 #include <functional>
 #include <iostream>
+#include <string>
 #include <vector>
 
 namespace fixed {
@@ -146,6 +148,58 @@ inline bool checkNumber (
     ;
 }
 
+//
+// Every rounding mode, for tests that run through them all.
+//
+static const Rounding::Mode ROUNDING_MODES [] = {
+    Rounding::Mode::UP,
+    Rounding::Mode::DOWN,
+    Rounding::Mode::TOWARDS_ZERO,
+    Rounding::Mode::AWAY_FROM_ZERO,
+    Rounding::Mode::TO_NEAREST_HALF_UP,
+    Rounding::Mode::TO_NEAREST_HALF_DOWN,
+    Rounding::Mode::TO_NEAREST_HALF_AWAY_FROM_ZERO,
+    Rounding::Mode::TO_NEAREST_HALF_TOWARDS_ZERO,
+    Rounding::Mode::TO_NEAREST_HALF_TO_EVEN,
+    Rounding::Mode::TO_NEAREST_HALF_TO_ODD
+};
+
+inline bool checkResult (
+    const Number& result,
+    const std::string& expected,
+    const std::string& description
+)
+{
+    if (result.toString () != expected)
+    {
+        std::cerr << description << " gave " << result.toString ()
+                  << " expected " << expected << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+template <typename EXCEPTION>
+inline bool expectException (
+    const std::function<void ()>& func,
+    const std::string& description
+)
+{
+    try {
+        func ();
+    }
+    catch (const EXCEPTION&)
+    {
+        return true;
+    }
+
+    std::cerr << description << " expected exception" << std::endl;
+
+    return false;
+}
+
 } // namespace test
 } // namespace fixed
 
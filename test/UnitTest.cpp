@@ -37,8 +37,23 @@ struct TestVec {
     const std::vector<Test>& tests;
 };
 
+extern std::vector<Test> AccumulatorTestVec;
+extern std::vector<Test> AllocateTestVec;
+extern std::vector<Test> AtomicNumberTestVec;
+extern std::vector<Test> BarBuilderTestVec;
+extern std::vector<Test> ColumnFilterTestVec;
+extern std::vector<Test> ColumnOpsTestVec;
+extern std::vector<Test> CpuDispatchTestVec;
+extern std::vector<Test> CrossRatesTestVec;
+extern std::vector<Test> DivisorTestVec;
+extern std::vector<Test> FinancingTestVec;
+extern std::vector<Test> HashTestVec;
+extern std::vector<Test> KeyEncodingTestVec;
+extern std::vector<Test> MathTestVec;
+extern std::vector<Test> MoneyTestVec;
 extern std::vector<Test> NumberAbsoluteTestVec;
 extern std::vector<Test> NumberArithmeticTestVec;
+extern std::vector<Test> NumberColumnTestVec;
 extern std::vector<Test> NumberIntConstructorFailTestVec;
 extern std::vector<Test> NumberIntConstructorTestVec;
 extern std::vector<Test> NumberFirstBitSetTestVec;
@@ -48,7 +63,15 @@ extern std::vector<Test> NumberNegateTestVec;
 extern std::vector<Test> NumberRelationalTestVec;
 extern std::vector<Test> NumberRoundingTestVec;
 extern std::vector<Test> NumberSqueezeZerosTestVec;
+extern std::vector<Test> NumberStrExponentTestVec;
 extern std::vector<Test> NumberToFpTestVec;
+extern std::vector<Test> ParallelTestVec;
+extern std::vector<Test> ReductionsTestVec;
+extern std::vector<Test> RescaleTestVec;
+extern std::vector<Test> RollingWindowTestVec;
+extern std::vector<Test> ShardedAccumulatorTestVec;
+extern std::vector<Test> SortTestVec;
+extern std::vector<Test> StreamingStatsTestVec;
 
 static std::vector<TestVec> testVecs = {
   {
@@ -58,12 +81,35 @@ static std::vector<TestVec> testVecs = {
     { "FloatingPoint Constructor", NumberFpConstructorTestVec },
     { "Number To FloatingPoint", NumberToFpTestVec },
     { "Rounding", NumberRoundingTestVec },
+    { "String Exponent", NumberStrExponentTestVec },
     { "Integer Constructor Fail", NumberIntConstructorFailTestVec },
     { "Floating Point Constructor Fail", NumberFpConstructorFailTestVec },
     { "Arithmetic", NumberArithmeticTestVec },
     { "Relational", NumberRelationalTestVec },
     { "Absolute", NumberAbsoluteTestVec },
-    { "Negate", NumberNegateTestVec }
+    { "Negate", NumberNegateTestVec },
+    { "Number Column", NumberColumnTestVec },
+    { "Column Ops", ColumnOpsTestVec },
+    { "Column Filters", ColumnFilterTestVec },
+    { "Reductions", ReductionsTestVec },
+    { "Rescale", RescaleTestVec },
+    { "CPU Dispatch", CpuDispatchTestVec },
+    { "Sort", SortTestVec },
+    { "Key Encoding", KeyEncodingTestVec },
+    { "Hash", HashTestVec },
+    { "Accumulator", AccumulatorTestVec },
+    { "Sharded Accumulator", ShardedAccumulatorTestVec },
+    { "Atomic Number", AtomicNumberTestVec },
+    { "Streaming Stats", StreamingStatsTestVec },
+    { "Rolling Window", RollingWindowTestVec },
+    { "Bar Builder", BarBuilderTestVec },
+    { "Parallel", ParallelTestVec },
+    { "Math", MathTestVec },
+    { "Financing", FinancingTestVec },
+    { "Divisor", DivisorTestVec },
+    { "Cross Rates", CrossRatesTestVec },
+    { "Money", MoneyTestVec },
+    { "Allocate", AllocateTestVec }
   }
 };
 